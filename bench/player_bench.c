@@ -0,0 +1,436 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* Measures the cost of the public API against whichever mm-player the library
+* is linked with, and prints the percentiles as JSON on the standard output.
+*
+*   capi-media-player-bench [-n iterations] [-g getter_calls] <uri>
+*
+* All the times are in microseconds. The content should be a local file of a
+* few minutes, with audio and video, so that the seeks and the tags are measured.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <glib.h>
+#include <player.h>
+
+#define BENCH_DEFAULT_ITERATIONS	50
+#define BENCH_DEFAULT_GETTER_CALLS	10000
+#define BENCH_EVENT_TIMEOUT		5000	/* ms */
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int count;
+} bench_event_s;
+
+typedef struct {
+	const char *name;
+	double *samples;
+	int count;
+} bench_result_s;
+
+static int g_first_result = 1;
+
+static double __now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static void __event_init(bench_event_s *ev)
+{
+	pthread_mutex_init(&ev->lock, NULL);
+	pthread_cond_init(&ev->cond, NULL);
+	ev->count = 0;
+}
+
+static void __event_signal(void *user_data)
+{
+	bench_event_s *ev = (bench_event_s*)user_data;
+	pthread_mutex_lock(&ev->lock);
+	ev->count++;
+	pthread_cond_broadcast(&ev->cond);
+	pthread_mutex_unlock(&ev->lock);
+}
+
+/* Waits for the event to have been signaled @a count times in total */
+static int __event_wait(bench_event_s *ev, int count)
+{
+	struct timespec deadline;
+	int ret = 0;
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += BENCH_EVENT_TIMEOUT / 1000;
+	pthread_mutex_lock(&ev->lock);
+	while(ev->count < count && ret != ETIMEDOUT)
+		ret = pthread_cond_timedwait(&ev->cond, &ev->lock, &deadline);
+	ret = ev->count >= count ? 0 : -1;
+	pthread_mutex_unlock(&ev->lock);
+	return ret;
+}
+
+static int __compare(const void *a, const void *b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+	return x < y ? -1 : x > y;
+}
+
+static double __percentile(const double *sorted, int count, double p)
+{
+	int index = (int)(p * (count - 1) + 0.5);
+	return sorted[index];
+}
+
+/* Prints @a str as the body of a JSON string */
+static void __print_json_string(const char *str)
+{
+	const unsigned char *c;
+	for(c = (const unsigned char*)str; *c; c++)
+	{
+		if(*c == '"' || *c == '\\')
+			printf("\\%c", *c);
+		else if(*c < 0x20)
+			printf("\\u%04x", *c);
+		else
+			putchar(*c);
+	}
+}
+
+static void __print_result(const bench_result_s *r)
+{
+	printf("%s\n    \"%s\": {", g_first_result ? "" : ",", r->name);
+	g_first_result = 0;
+	if(r->count == 0)
+	{
+		printf("\"count\": 0}");
+		return;
+	}
+	qsort(r->samples, r->count, sizeof(double), __compare);
+	printf("\"count\": %d, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}",
+		r->count, __percentile(r->samples, r->count, 0.5), __percentile(r->samples, r->count, 0.9),
+		__percentile(r->samples, r->count, 0.99), r->samples[r->count - 1]);
+}
+
+static void __result_init(bench_result_s *r, const char *name, int capacity)
+{
+	r->name = name;
+	r->samples = (double*)calloc(capacity, sizeof(double));
+	r->count = 0;
+}
+
+static void __result_done(bench_result_s *r)
+{
+	__print_result(r);
+	free(r->samples);
+}
+
+#define BENCH_CHECK(expr) \
+	do { int __ret = (expr); if(__ret != PLAYER_ERROR_NONE) { fprintf(stderr, "%s:%d %s failed : 0x%x\n", __FILE__, __LINE__, #expr, __ret); exit(1); } } while(0)
+
+/* mm-player posts its messages from the default main context */
+static gpointer __main_loop_thread(gpointer data)
+{
+	g_main_loop_run((GMainLoop*)data);
+	return NULL;
+}
+
+static void __bench_create_destroy(int iterations)
+{
+	bench_result_s create;
+	bench_result_s destroy;
+	player_h player;
+	int i;
+
+	__result_init(&create, "create", iterations);
+	__result_init(&destroy, "destroy", iterations);
+	for(i = 0; i < iterations; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_create(&player));
+		double t1 = __now_us();
+		BENCH_CHECK(player_destroy(player));
+		create.samples[create.count++] = t1 - t0;
+		destroy.samples[destroy.count++] = __now_us() - t1;
+	}
+	__result_done(&create);
+	__result_done(&destroy);
+}
+
+static void __bench_prepare_unprepare(const char *uri, int iterations)
+{
+	bench_result_s prepare;
+	bench_result_s unprepare;
+	player_h player;
+	int i;
+
+	__result_init(&prepare, "prepare", iterations);
+	__result_init(&unprepare, "unprepare", iterations);
+	BENCH_CHECK(player_create(&player));
+	BENCH_CHECK(player_set_uri(player, uri));
+	for(i = 0; i < iterations; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_prepare(player));
+		double t1 = __now_us();
+		BENCH_CHECK(player_unprepare(player));
+		prepare.samples[prepare.count++] = t1 - t0;
+		unprepare.samples[unprepare.count++] = __now_us() - t1;
+	}
+	BENCH_CHECK(player_destroy(player));
+	__result_done(&prepare);
+	__result_done(&unprepare);
+}
+
+static void __bench_start_to_begin(player_h player, int iterations)
+{
+	bench_result_s begin;
+	bench_event_s started;
+	int i;
+
+	__result_init(&begin, "start_to_begin", iterations);
+	__event_init(&started);
+	BENCH_CHECK(player_set_started_cb(player, __event_signal, &started));
+	for(i = 0; i < iterations; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_start(player));
+		if(__event_wait(&started, i + 1) == 0)
+			begin.samples[begin.count++] = __now_us() - t0;
+		else
+			fprintf(stderr, "start %d : no beginning of stream\n", i);
+		BENCH_CHECK(player_stop(player));
+	}
+	player_unset_started_cb(player);
+	__result_done(&begin);
+}
+
+static void __bench_seek(player_h player, int iterations)
+{
+	bench_result_s seek;
+	bench_event_s completed;
+	int duration = 0;
+	int i;
+
+	__result_init(&seek, "seek", iterations);
+	__event_init(&completed);
+	BENCH_CHECK(player_get_duration(player, &duration));
+	BENCH_CHECK(player_start(player));
+	srand(1);
+	for(i = 0; i < iterations && duration > 0; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_set_position(player, rand() % duration, __event_signal, &completed));
+		if(__event_wait(&completed, i + 1) == 0)
+			seek.samples[seek.count++] = __now_us() - t0;
+		else
+			fprintf(stderr, "seek %d : not completed\n", i);
+	}
+	BENCH_CHECK(player_stop(player));
+	__result_done(&seek);
+}
+
+static void __bench_getters(player_h player, int calls)
+{
+	bench_result_s position;
+	bench_result_s interpolated;
+	bench_result_s duration;
+	bench_result_s content_info;
+	int value;
+	char *title;
+	int i;
+
+	__result_init(&position, "get_position", calls);
+	__result_init(&interpolated, "get_position_interpolated", calls);
+	__result_init(&duration, "get_duration", calls);
+	__result_init(&content_info, "get_content_info", calls);
+	BENCH_CHECK(player_start(player));
+	for(i = 0; i < calls; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_get_position(player, &value));
+		position.samples[position.count++] = __now_us() - t0;
+	}
+	BENCH_CHECK(player_set_position_interpolation(player, 100));
+	for(i = 0; i < calls; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_get_position(player, &value));
+		interpolated.samples[interpolated.count++] = __now_us() - t0;
+	}
+	BENCH_CHECK(player_set_position_interpolation(player, 0));
+	for(i = 0; i < calls; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_get_duration(player, &value));
+		duration.samples[duration.count++] = __now_us() - t0;
+	}
+	for(i = 0; i < calls; i++)
+	{
+		double t0 = __now_us();
+		BENCH_CHECK(player_get_content_info(player, PLAYER_CONTENT_INFO_TITLE, &title));
+		content_info.samples[content_info.count++] = __now_us() - t0;
+		free(title);
+	}
+	BENCH_CHECK(player_stop(player));
+	__result_done(&position);
+	__result_done(&interpolated);
+	__result_done(&duration);
+	__result_done(&content_info);
+}
+
+/*
+* Round trip of a message, from the seek to its completed callback, with the trace logs
+* of the message path enabled and disabled. Against a fake mm-player which completes the
+* seeks at once, the difference is the cost of the logs of each message.
+*/
+static void __bench_message_log(player_h player, int iterations)
+{
+	static const struct {
+		const char *name;
+		player_log_level_e level;
+	} levels[] = {
+		{ "message_log_error", PLAYER_LOG_LEVEL_ERROR },
+		{ "message_log_trace", PLAYER_LOG_LEVEL_TRACE },
+	};
+	bench_event_s completed;
+	int duration = 0;
+	int count = 0;
+	unsigned int l;
+	int i;
+
+	__event_init(&completed);
+	BENCH_CHECK(player_get_duration(player, &duration));
+	BENCH_CHECK(player_start(player));
+	for(l = 0; l < sizeof(levels) / sizeof(levels[0]); l++)
+	{
+		bench_result_s message;
+		__result_init(&message, levels[l].name, iterations);
+		BENCH_CHECK(player_set_log_level(levels[l].level));
+		for(i = 0; i < iterations && duration > 0; i++)
+		{
+			double t0 = __now_us();
+			BENCH_CHECK(player_set_position(player, rand() % duration, __event_signal, &completed));
+			if(__event_wait(&completed, ++count) == 0)
+				message.samples[message.count++] = __now_us() - t0;
+			else
+				fprintf(stderr, "seek %d : not completed\n", i);
+		}
+		__result_done(&message);
+	}
+	BENCH_CHECK(player_set_log_level(PLAYER_LOG_LEVEL_ERROR));
+	BENCH_CHECK(player_stop(player));
+}
+
+/* The message path is internal, it is seen through the dispatcher thread which queues each callback */
+static void __bench_dispatch(const char *uri, int iterations)
+{
+	player_dispatch_stats_s stats;
+	bench_event_s completed;
+	player_h player;
+	int duration = 0;
+	int i;
+
+	__event_init(&completed);
+	BENCH_CHECK(player_create(&player));
+	BENCH_CHECK(player_set_dispatch_mode(player, PLAYER_DISPATCH_MODE_THREAD, NULL));
+	BENCH_CHECK(player_set_uri(player, uri));
+	BENCH_CHECK(player_prepare(player));
+	BENCH_CHECK(player_get_duration(player, &duration));
+	BENCH_CHECK(player_start(player));
+	for(i = 0; i < iterations && duration > 0; i++)
+	{
+		BENCH_CHECK(player_set_position(player, rand() % duration, __event_signal, &completed));
+		__event_wait(&completed, i + 1);
+	}
+	BENCH_CHECK(player_get_dispatch_stats(player, &stats));
+	BENCH_CHECK(player_stop(player));
+	BENCH_CHECK(player_unprepare(player));
+	BENCH_CHECK(player_destroy(player));
+
+	printf("%s\n    \"dispatch\": {\"dispatched\": %u, \"max_queue_depth\": %d, \"max_latency\": %d}",
+		g_first_result ? "" : ",", stats.dispatched, stats.max_queue_depth, stats.max_latency);
+	g_first_result = 0;
+}
+
+int main(int argc, char *argv[])
+{
+	int iterations = BENCH_DEFAULT_ITERATIONS;
+	int calls = BENCH_DEFAULT_GETTER_CALLS;
+	player_h player;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:g:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'n':
+				iterations = atoi(optarg);
+				break;
+			case 'g':
+				calls = atoi(optarg);
+				break;
+			default:
+				break;
+		}
+	}
+	if(optind >= argc || iterations <= 0 || calls <= 0)
+	{
+		fprintf(stderr, "usage : %s [-n iterations] [-g getter_calls] <uri>\n", argv[0]);
+		return 1;
+	}
+	const char *uri = argv[optind];
+
+#if !GLIB_CHECK_VERSION(2, 36, 0)
+	g_type_init();
+#endif
+	GMainLoop *loop = g_main_loop_new(NULL, FALSE);
+	GThread *thread = g_thread_new("bench-main-loop", __main_loop_thread, loop);
+	player_set_log_level(PLAYER_LOG_LEVEL_ERROR);
+
+	printf("{\n  \"uri\": \"");
+	__print_json_string(uri);
+	printf("\",\n  \"unit\": \"us\",\n  \"results\": {");
+	__bench_create_destroy(iterations);
+	__bench_prepare_unprepare(uri, iterations);
+
+	BENCH_CHECK(player_create(&player));
+	BENCH_CHECK(player_set_uri(player, uri));
+	BENCH_CHECK(player_prepare(player));
+	__bench_start_to_begin(player, iterations);
+	__bench_seek(player, iterations);
+	__bench_message_log(player, iterations);
+	__bench_getters(player, calls);
+	BENCH_CHECK(player_unprepare(player));
+	BENCH_CHECK(player_destroy(player));
+
+	__bench_dispatch(uri, iterations);
+	printf("\n  }\n}\n");
+
+	g_main_loop_quit(loop);
+	g_thread_join(thread);
+	g_main_loop_unref(loop);
+	return 0;
+}
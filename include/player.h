@@ -18,6 +18,7 @@
 #define __TIZEN_MEDIA_PLAYER_H__
 
 #include <tizen.h>
+#include <stdint.h>
 #include <sound_manager.h>
 
 #ifdef __cplusplus
@@ -41,6 +42,16 @@ extern "C" {
  */
 typedef struct player_s *player_h;
 
+/**
+ * @brief Media player pool handle type.
+ */
+typedef struct player_pool_s *player_pool_h;
+
+/**
+ * @brief Decoded video frame handle type.
+ */
+typedef struct player_video_frame_s *player_video_frame_h;
+
 /**
  * @brief Enumerations of media player state
  */
@@ -74,6 +85,139 @@ typedef enum
 		PLAYER_ERROR_VIDEO_CAPTURE_FAILED = PLAYER_ERROR_CLASS | 0x07    /**< Video capture failure */
 } player_error_e;
 
+/**
+ * @brief The statistics of a media player pool
+ * @see player_pool_get_stats()
+ */
+typedef struct
+{
+	unsigned int hits;			/**< The number of player_pool_acquire() served by a pre-created handle */
+	unsigned int misses;		/**< The number of player_pool_acquire() which had to create a new handle */
+	unsigned int evictions;	/**< The number of released handles destroyed because the pool was full */
+	int idle_count;				/**< The number of handles currently waiting in the pool */
+} player_pool_stats_s;
+
+/**
+ * @brief Enumerations of the pixel format of a decoded video frame
+ */
+typedef enum
+{
+	PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN = 0,	/**< Unknown format, a single plane */
+	PLAYER_VIDEO_FRAME_FORMAT_I420,			/**< Planar YUV 4:2:0, three planes */
+	PLAYER_VIDEO_FRAME_FORMAT_RGB565,		/**< Packed 16 bits RGB, a single plane */
+	PLAYER_VIDEO_FRAME_FORMAT_ARGB8888,		/**< Packed 32 bits ARGB, a single plane */
+} player_video_frame_format_e;
+
+/**
+ * @brief Enumerations of what happens when decoded audio doesn't fit in the buffer of player_audio_pcm_open()
+ */
+typedef enum
+{
+	PLAYER_AUDIO_PCM_OVERFLOW_BLOCK = 0,	/**< The decoding waits until the application reads */
+	PLAYER_AUDIO_PCM_OVERFLOW_DROP_OLDEST,	/**< The oldest unread audio is overwritten */
+	PLAYER_AUDIO_PCM_OVERFLOW_DROP_NEWEST,	/**< The new audio which doesn't fit is dropped */
+} player_audio_pcm_overflow_e;
+
+/**
+ * @brief Enumerations of the log level of the player
+ * @see player_set_log_level()
+ */
+typedef enum
+{
+	PLAYER_LOG_LEVEL_ERROR = 0,	/**< Only the errors are logged */
+	PLAYER_LOG_LEVEL_INFO,		/**< The errors and the changes of configuration are logged */
+	PLAYER_LOG_LEVEL_TRACE,		/**< Every call, message and skipped frame is also logged (default) */
+} player_log_level_e;
+
+/**
+ * @brief Enumerations of the thread on which the callbacks are invoked
+ * @see player_set_dispatch_mode()
+ */
+typedef enum
+{
+	PLAYER_DISPATCH_MODE_SYNC = 0,		/**< Callbacks are invoked on the internal thread of the framework (default) */
+	PLAYER_DISPATCH_MODE_THREAD,		/**< Callbacks are invoked on a dispatcher thread owned by the player */
+	PLAYER_DISPATCH_MODE_MAIN_CONTEXT,	/**< Callbacks are invoked from a GMainContext given by the application */
+} player_dispatch_mode_e;
+
+/**
+ * @brief The statistics of the callback dispatcher
+ * @see player_get_dispatch_stats()
+ */
+typedef struct
+{
+	int queue_depth;			/**< The number of callbacks waiting to be invoked */
+	int max_queue_depth;		/**< The highest number of callbacks that have been waiting at once */
+	int max_latency;			/**< The longest delay between an event and its callback, in microseconds */
+	unsigned int dispatched;	/**< The number of callbacks invoked by the dispatcher */
+} player_dispatch_stats_s;
+
+/**
+ * @brief Enumerations of the events an event listener can subscribe to, they are combined into a mask
+ * @see player_add_event_listener()
+ */
+typedef enum
+{
+	PLAYER_EVENT_STARTED = 0x0001,			/**< The beginning of the stream has been reached */
+	PLAYER_EVENT_COMPLETED = 0x0002,		/**< The end of the stream has been reached */
+	PLAYER_EVENT_PAUSED = 0x0004,			/**< The playback has been paused by the framework */
+	PLAYER_EVENT_INTERRUPTED = 0x0008,		/**< The playback has been interrupted, the value is a #player_interrupted_code_e */
+	PLAYER_EVENT_ERROR = 0x0010,			/**< An error occurred, the value is a #player_error_e */
+	PLAYER_EVENT_BUFFERING = 0x0020,		/**< The buffering progressed, the value is the percentage */
+	PLAYER_EVENT_SEEK_COMPLETED = 0x0040,	/**< A seek completed, the value is the position reached for the seeks of player_set_position_ex() and 0 otherwise */
+	PLAYER_EVENT_PD = 0x0080,				/**< The progressive download started or completed, the value is a #player_pd_message_type_e */
+	PLAYER_EVENT_TRACK_CHANGED = 0x0100,	/**< The playback moved to the next source */
+	PLAYER_EVENT_ALL = 0x01FF,				/**< Every event */
+} player_event_e;
+
+/**
+ * @brief The maximum number of event listeners of a player
+ * @see player_add_event_listener()
+ */
+#define PLAYER_EVENT_LISTENER_MAX	8
+
+/**
+ * @brief The number of buckets of #player_latency_histogram_s
+ */
+#define PLAYER_LATENCY_HISTOGRAM_BUCKETS	16
+
+/**
+ * @brief The number of error codes counted by #player_stats_s
+ */
+#define PLAYER_STATS_ERROR_NUM	11
+
+/**
+ * @brief A histogram of latencies on a logarithmic scale
+ * @details buckets[0] counts the latencies under 1 ms, buckets[i] the ones from 2^(i-1) ms up to 2^i ms,
+ * and the last bucket also counts all the longer ones.
+ */
+typedef struct
+{
+	unsigned int count;				/**< The number of samples */
+	unsigned int max;				/**< The longest latency, in milliseconds */
+	unsigned long long total;		/**< The sum of the latencies, in milliseconds */
+	unsigned int buckets[PLAYER_LATENCY_HISTOGRAM_BUCKETS];	/**< The number of samples in each bucket */
+} player_latency_histogram_s;
+
+/**
+ * @brief The statistics of a player since its creation
+ * @see player_get_statistics()
+ */
+typedef struct
+{
+	player_latency_histogram_s create;			/**< player_create() */
+	player_latency_histogram_s prepare;			/**< player_prepare(), or player_prepare_async() up to player_prepared_cb() */
+	player_latency_histogram_s start_to_begin;	/**< player_start() up to the beginning of the stream */
+	player_latency_histogram_s seek;			/**< The issue of a seek up to its completion */
+	unsigned int buffering_events;				/**< The number of buffering events, including the coalesced ones */
+	unsigned int stalls;						/**< The number of times the playback waited for buffering, including the initial buffering */
+	unsigned long long stall_time;				/**< The total time spent waiting for buffering, in milliseconds */
+	unsigned int dropped_frames;				/**< The number of video frames dropped because every frame handle was in use */
+	unsigned int errors;						/**< The number of errors reported by player_error_cb() */
+	unsigned int error_counts[PLAYER_STATS_ERROR_NUM];	/**< The errors by code, read them with player_stats_get_error_count() */
+	unsigned long long downloaded_bytes;		/**< The number of bytes downloaded by the progressive download */
+} player_stats_s;
+
 /**
  * @brief Enumerations of player interrupted type
  */
@@ -173,6 +317,41 @@ typedef enum
   PLAYER_CONTENT_INFO_YEAR,			/**< Year */
 } player_content_info_e;
 
+/**
+ * @brief Enumerations of the seek modes
+ * @see player_set_position_ex()
+ */
+typedef enum
+{
+	PLAYER_SEEK_MODE_KEYFRAME,	/**< Seeks to the nearest key frame, cheap but not exact */
+	PLAYER_SEEK_MODE_ACCURATE,	/**< Seeks to the exact position, decoding from the previous key frame */
+} player_seek_mode_e;
+
+/**
+ * @brief The media information of the content, gathered at once by player_get_media_info()
+ * @remarks The strings are empty if the content doesn't have the information. They are released by player_release_media_info().
+ */
+typedef struct
+{
+	char *album;			/**< Album */
+	char *artist;			/**< Artist */
+	char *author;			/**< Author */
+	char *genre;			/**< Genre */
+	char *title;			/**< Title */
+	char *year;				/**< Year */
+	char *audio_codec;		/**< Audio codec name */
+	char *video_codec;		/**< Video codec name */
+	int sample_rate;		/**< Audio sample rate, in Hz */
+	int channel;			/**< The number of audio channels */
+	int audio_bit_rate;		/**< Audio bit rate, in bps */
+	int fps;				/**< Video frame rate */
+	int video_bit_rate;		/**< Video bit rate, in bps */
+	int width;				/**< Video width */
+	int height;				/**< Video height */
+	int duration;			/**< Duration, in milliseconds */
+	void *arena;			/**< Internal storage of the strings, don't use */
+} player_media_info_s;
+
 /**
  * @brief  Enumerations of media stream content information
  */
@@ -259,7 +438,7 @@ typedef void (*player_started_cb)(void *user_data);
 
 /**
  * @brief  Called when the media player is prepared.
- * @details It will be invoked when player has reached the begin of stream
+ * @details It will be invoked when player has been prerolled, that is, when the first frame has been decoded
  * @param[in]   user_data  The user data passed from the callback registration function
  * @pre player_prepare_async() will cause this callback
  * @post The player state will be #PLAYER_STATE_READY
@@ -287,6 +466,34 @@ typedef void (*player_paused_cb)(void *user_data);
  */
 typedef void (*player_seek_completed_cb)(void *user_data);
 
+/**
+ * @brief  Called when a pending seek, set with a callback, has been replaced by a newer one or could not be issued.
+ * @details The seeks in progress are also cancelled by player_stop(), an error or an interruption which stops the playback.
+ * player_seek_completed_cb() of the cancelled seek is not invoked.
+ * @param[in]   seek_user_data  The user data passed to player_set_position() or player_set_position_ratio() for the cancelled seek
+ * @param[in]   user_data  The user data passed from the callback registration function
+ * @see player_set_seek_cancelled_cb()
+ */
+typedef void (*player_seek_cancelled_cb)(void *seek_user_data, void *user_data);
+
+/**
+ * @brief  Called when the seek operation started by player_set_position_ex() is completed.
+ * @param[in]   millisecond  The position actually reached, in milliseconds
+ * @param[in]   user_data  The user data passed from the callback registration function
+ * @see player_set_position_ex()
+ */
+typedef void (*player_seek_completed_ex_cb)(int millisecond, void *user_data);
+
+/**
+ * @brief  Called when an event the listener subscribed to occurs.
+ * @details It is invoked in addition to the callback set for the event, if any, and on the same thread.
+ * @param[in]   event  The event which occurred
+ * @param[in]   value  The value of the event, see #player_event_e
+ * @param[in]   user_data  The user data passed from the callback registration function
+ * @see player_add_event_listener()
+ */
+typedef void (*player_event_cb)(player_event_e event, int value, void *user_data);
+
 /**
  * @brief  Called when the media player is interrupted.
  * @param[in]	error_code	The interrupted error code
@@ -335,6 +542,32 @@ typedef void (*player_subtitle_updated_cb)(unsigned long duration, char *text, v
  */
 typedef void (*player_pd_message_cb)(player_pd_message_type_e type, void *user_data);
 
+/**
+ * @brief  Called when the push source needs more data.
+ * @param[in]   size	The number of bytes the source would like to get, 0 if unknown
+ * @param[in]   user_data	The user data passed from the callback registration function
+ * @see player_set_push_source()
+ * @see player_push_buffer()
+ */
+typedef void (*player_push_need_data_cb)(unsigned int size, void *user_data);
+
+/**
+ * @brief  Called when the push source has queued enough data, pushing should be suspended until player_push_need_data_cb() is invoked.
+ * @param[in]   user_data	The user data passed from the callback registration function
+ * @see player_set_push_source()
+ */
+typedef void (*player_push_enough_data_cb)(void *user_data);
+
+/**
+ * @brief  Called when the playback has moved on to the next source without stopping.
+ * @details It will be invoked instead of player_completed_cb() when a next source has been prerolled before the end of the current one.
+ * @param[in]   user_data	The user data passed from the callback registration function
+ * @see player_set_next_uri()
+ * @see player_set_next_memory_buffer()
+ * @see player_set_track_changed_cb()
+ */
+typedef void (*player_track_changed_cb)(void *user_data);
+
 /**
  * @brief  Called when the video is captured.
  * @remarks The color space format of the captured image is #IMAGE_UTIL_COLORSPACE_RGB888.
@@ -360,6 +593,32 @@ typedef void (*player_video_captured_cb)(unsigned char *data, int width, int hei
  */
 typedef void (*player_video_frame_decoded_cb)(unsigned char *data, int width, int height, unsigned int size, void *user_data);
 
+/**
+ * @brief  Called when a thumbnail has been extracted, or could not be.
+ * @details The thumbnails are delivered in the order of their positions, not in the order of the request.
+ * @remarks @a data is a RGB888 image, only valid during the callback.
+ * @param[in]   error	#PLAYER_ERROR_NONE on success, otherwise #PLAYER_ERROR_SEEK_FAILED or #PLAYER_ERROR_VIDEO_CAPTURE_FAILED
+ * @param[in]   index	The index of the thumbnail in the @a positions given to player_extract_thumbnails()
+ * @param[in]   data	The thumbnail, or NULL on failure
+ * @param[in]   width	The width of the thumbnail
+ * @param[in]   height	The height of the thumbnail
+ * @param[in]   size	The size of @a data
+ * @param[in]   user_data	The user data passed from the callback registration function
+ * @see player_extract_thumbnails()
+ */
+typedef void (*player_thumbnail_extracted_cb)(int error, int index, unsigned char *data, int width, int height, unsigned int size, void *user_data);
+
+/**
+ * @brief  Called when a video frame is decoded, with a handle the application can keep.
+ * @remarks @a frame is only valid during the callback. Call player_video_frame_ref() to keep it, and player_video_frame_unref() when done.
+ * @remarks The player lends a limited number of frames at once, the new frames are dropped while the application holds all of them.
+ * @param[in]   frame	The decoded video frame
+ * @param[in]   user_data	The user data passed from the callback registration function
+ * @see player_set_video_frame_cb()
+ * @see player_get_video_frame_drop_count()
+ */
+typedef void (*player_video_frame_cb)(player_video_frame_h frame, void *user_data);
+
 /**
  * @brief  Called when the audio frame is decoded.
  * @param[in]   data	The decoded audio frame data 
@@ -407,6 +666,7 @@ int player_destroy(player_h player);
 
 /**
  * @brief Prepares the media player for playback.
+ * @details The pipeline is prerolled : it stops in a paused state once the first frame has been decoded, without starting the playback.
  * @param[in]	player The handle to media player
  * @return 0 on success, otherwise a negative error value.
  * @retval #PLAYER_ERROR_NONE Successful
@@ -510,6 +770,116 @@ int player_set_uri(player_h player, const char * uri);
  */
 int player_set_memory_buffer(player_h player, const void * data, int size);
 
+/**
+ * @brief Sets a local file as the source, read through a read-only memory mapping.
+ * @details Unlike player_set_memory_buffer(), the content doesn't need to be read into memory first.
+ * The pages of the mapping belong to the page cache, they are shared by all the players of the same file and
+ * may be reclaimed by the system. The part of the file around the playback position is read ahead.
+ * @remarks The file must not be truncated while it is mapped. The mapping is released when another source is set,
+ * or by player_destroy().
+ * @param[in] player The handle to media player
+ * @param[in] path The path of the file
+ * @param[in] offset The offset of the content in the file, in bytes
+ * @param[in] length The length of the content in bytes, or 0 for the rest of the file
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_NO_SUCH_FILE File not found
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Not enough memory is available
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be #PLAYER_STATE_IDLE by player_create() or player_unprepare().
+ * @see player_set_memory_buffer()
+ */
+int player_set_mmap_file(player_h player, const char *path, int64_t offset, int length);
+
+/**
+ * @brief Sets a push source : the content is given chunk by chunk by player_push_buffer() instead of being read from a URI.
+ * @details The data is the byte stream of a container, as it would be read from a file.
+ * @a need_data_cb and @a enough_data_cb tell when to resume and when to suspend pushing.
+ * @param[in] player The handle to media player
+ * @param[in] need_data_cb The callback function invoked when the source needs more data, may be NULL
+ * @param[in] enough_data_cb The callback function invoked when the source has enough data, may be NULL
+ * @param[in] user_data The user data to be passed to the callback functions
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be #PLAYER_STATE_IDLE by player_create() or player_unprepare().
+ * @see player_push_buffer()
+ */
+int player_set_push_source(player_h player, player_push_need_data_cb need_data_cb, player_push_enough_data_cb enough_data_cb, void *user_data);
+
+/**
+ * @brief Gives the next chunk of the content to the push source.
+ * @details The data may be pushed as soon as the source is set, the player needs some of it to be prepared.
+ * @remarks The data is copied, @a data can be released or reused as soon as this function returns.
+ * @param[in] player The handle to media player
+ * @param[in] data The data
+ * @param[in] size The size of the data in bytes
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION The source isn't a push source
+ * @pre player_set_push_source() has been called.
+ * @see player_set_push_source()
+ */
+int player_push_buffer(player_h player, const void *data, int size);
+
+/**
+ * @brief Sets the data source to play right after the current one, without gap.
+ *
+ * @details
+ * The next source is realized and prerolled in the background while the current one plays.
+ * When the current source reaches its end, the playback switches to the next source without leaving #PLAYER_STATE_PLAYING,
+ * and player_track_changed_cb() is invoked instead of player_completed_cb().
+ *
+ * @remarks Setting a next source again replaces the previous one.
+ * @remarks If the next source can't be prerolled in time, the playback completes as usual.
+ *
+ * @param[in]   player The handle to media player
+ * @param[in]   uri Specifies the content location, such as the file path, the URI of the http or rtsp stream you want to play
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
+ * @see player_set_next_memory_buffer()
+ * @see player_unset_next_source()
+ * @see player_set_track_changed_cb()
+ */
+int player_set_next_uri(player_h player, const char *uri);
+
+/**
+ * @brief Sets memory as the data source to play right after the current one, without gap.
+ * @remarks The memory must stay valid until the next source has been played or unset.
+ * @param[in]   player The handle to media player
+ * @param[in]   data The memory pointer of media data
+ * @param[in]   size The size of media data
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
+ * @see player_set_next_uri()
+ * @see player_unset_next_source()
+ */
+int player_set_next_memory_buffer(player_h player, const void *data, int size);
+
+/**
+ * @brief Releases the next source set by player_set_next_uri() or player_set_next_memory_buffer().
+ * @remarks The next source is also released by player_unprepare().
+ * @param[in]   player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_set_next_uri()
+ */
+int player_unset_next_source(player_h player);
+
 /**
  * @brief Gets the player's current state.
  * @param[in]   player	The handle to media player
@@ -652,8 +1022,11 @@ int player_pause(player_h player);
  * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
  * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
  * @retval #PLAYER_ERROR_SEEK_FAILED Seek operation failure
+ * @remarks If a seek is already in progress, this one is kept and issued when the other completes,
+ * replacing the one which was kept before, if any. The replaced seek is reported by player_seek_cancelled_cb().
  * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
  * @post It invokes player_seek_completed_cb() when seek operation completes, if you set a callback.
+ * @see player_set_seek_cancelled_cb()
  * @see player_get_position()
  * @see player_get_position_ratio()
  * @see player_set_position_ratio()
@@ -672,14 +1045,87 @@ int player_set_position(player_h player, int millisecond, player_seek_completed_
  * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
  * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
  * @retval #PLAYER_ERROR_SEEK_FAILED Seek operation failure
+ * @remarks If a seek is already in progress, this one is kept and issued when the other completes,
+ * replacing the one which was kept before, if any. The replaced seek is reported by player_seek_cancelled_cb().
  * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
  * @post It invokes player_seek_completed_cb() when seek operation completes, if you set a callback.
+ * @see player_set_seek_cancelled_cb()
  * @see player_get_position()
  * @see player_get_position_ratio()
  * @see player_set_position()
  */
 int player_set_position_ratio(player_h player, int percent, player_seek_completed_cb callback, void *user_data);
 
+/**
+ * @brief Sets the seek position for playback with the given accuracy, asynchronously.
+ * @details #PLAYER_SEEK_MODE_KEYFRAME suits scrubbing, where many seeks are issued in a row,
+ * and #PLAYER_SEEK_MODE_ACCURATE the final position. player_set_position() uses #PLAYER_SEEK_MODE_KEYFRAME.
+ * @remarks Seeks are coalesced as with player_set_position().
+ * @param[in] player The handle to media player
+ * @param[in] millisecond The position in milliseconds from the start to seek to
+ * @param[in] mode The seek mode
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_SEEK_FAILED Seek operation failure
+ * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
+ * @post It invokes player_seek_completed_ex_cb() with the position reached when seek operation completes, if you set a callback.
+ * @see player_set_position()
+ * @see player_set_seek_cancelled_cb()
+ */
+int player_set_position_ex(player_h player, int millisecond, player_seek_mode_e mode, player_seek_completed_ex_cb callback, void *user_data);
+
+/**
+ * @brief Starts scrubbing : the following positions given by player_scrub_update() are previewed with cheap seeks.
+ * @details While scrubbing, the audio is muted and each update is a #PLAYER_SEEK_MODE_KEYFRAME seek. Updates arriving
+ * while a seek is in progress replace each other, only the latest one is issued once the seek completes.
+ * @remarks player_set_mute() called while scrubbing takes effect at player_scrub_end().
+ * @param[in] player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Already scrubbing, or extracting thumbnails
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
+ * @see player_scrub_update()
+ * @see player_scrub_end()
+ */
+int player_scrub_begin(player_h player);
+
+/**
+ * @brief Moves the scrubbing position.
+ * @param[in] player The handle to media player
+ * @param[in] millisecond The position in milliseconds from the start to preview
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Not scrubbing
+ * @retval #PLAYER_ERROR_SEEK_FAILED Seek operation failure
+ * @pre player_scrub_begin() has been called.
+ * @see player_scrub_begin()
+ */
+int player_scrub_update(player_h player, int millisecond);
+
+/**
+ * @brief Ends scrubbing with a #PLAYER_SEEK_MODE_ACCURATE seek to the last position given to player_scrub_update().
+ * @details The audio is restored. If player_scrub_update() hasn't been called, no seek is done and @a callback is not invoked.
+ * @param[in] player The handle to media player
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Not scrubbing
+ * @retval #PLAYER_ERROR_SEEK_FAILED Seek operation failure
+ * @pre player_scrub_begin() has been called.
+ * @post It invokes player_seek_completed_ex_cb() with the position reached when the final seek completes, if you set a callback.
+ * @see player_scrub_begin()
+ */
+int player_scrub_end(player_h player, player_seek_completed_ex_cb callback, void *user_data);
+
 /**
  * @brief Gets current position in milliseconds. 
  * @param[in]   player The handle to media player
@@ -1065,6 +1511,55 @@ int player_get_video_stream_info(player_h player, int *fps, int *bit_rate);
  */
 int player_get_video_size(player_h player, int *width, int *height);
 
+/**
+ * @brief Gets the tags, the codecs, the stream information, the video size and the duration of the content at once.
+ * @details This is cheaper than calling player_get_content_info(), player_get_codec_info(), player_get_audio_stream_info(),
+ * player_get_video_stream_info(), player_get_video_size() and player_get_duration() one by one.
+ * @remarks @a info must be released with player_release_media_info() by you.
+ * @param[in] player The handle to media player
+ * @param[out] info The media information
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Not enough memory is available
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
+ * @see player_release_media_info()
+ */
+int player_get_media_info(player_h player, player_media_info_s *info);
+
+/**
+ * @brief Reads the media information of a local file without creating a player.
+ * @details Only the container headers and the tags are parsed, nothing is decoded, so this is much cheaper
+ * than preparing a player to call player_get_media_info(). It doesn't depend on any player handle and
+ * may be called from several threads at the same time.
+ * @remarks @a info must be released with player_release_media_info() by you.\n
+ * The codec names are left empty, the file parser only knows the codec identifiers.
+ * @param[in] uri The path of the file, with or without the "file://" prefix
+ * @param[out] info The media information
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_URI Invalid URI, only local files are supported
+ * @retval #PLAYER_ERROR_NO_SUCH_FILE File not found
+ * @retval #PLAYER_ERROR_NOT_SUPPORTED_FILE File not supported
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Not enough memory is available
+ * @see player_release_media_info()
+ */
+int player_probe_uri(const char *uri, player_media_info_s *info);
+
+/**
+ * @brief Releases the strings of the media information.
+ * @param[in] info The media information filled by player_get_media_info() or player_probe_uri()
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_get_media_info()
+ * @see player_probe_uri()
+ */
+int player_release_media_info(player_media_info_s *info);
+
 /**
  * @brief Gets the album art in media resource
  * @remarks Do not release @a album_art. It will be released by framework when player destroys.
@@ -1584,56 +2079,205 @@ int player_set_buffering_cb(player_h player, player_buffering_cb callback, void
 int player_unset_buffering_cb(player_h player);
 
 /**
- * @brief Registers a callback function to be invoked when progressive download is starts or completes.
- * @param[in] player	The handle to media player
- * @param[in] callback	The callback function to register
- * @param[in] user_data	The user data to be passed to the callback function
+ * @brief Sets the log level of all the media players of the process.
+ * @remarks The trace logs are only available if the library is built with the PLAYER_TRACE_LOG option.
+ * @param[in] level	The log level
  * @return 0 on success, otherwise a negative error value.
  * @retval #PLAYER_ERROR_NONE Successful
  * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
- * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
- * @pre The path to download must be set by player_set_progressive_download_path().
- * @post  player_pd_message_cb() will be invoked
- * @see player_unset_progressive_download_message_cb()
- * @see player_set_progressive_download_path()
  */
-int player_set_progressive_download_message_cb(player_h player, player_pd_message_cb callback, void *user_data);
+int player_set_log_level(player_log_level_e level);
 
 /**
- * @brief Unregisters the callback function.
- * @param[in] player The handle to media player
+ * @brief Limits how often player_buffering_cb() is invoked.
+ * @details
+ * A buffering event is dropped if less than @a min_interval milliseconds have passed since the last delivered one,
+ * or if the percentage moved by less than @a min_percent_delta since the last delivered one.
+ * The events of 0 and 100 percent are always delivered.
+ * @remarks Coalescing is disabled by default, which is the same as setting both values to 0.
+ * @param[in] player	The handle to media player
+ * @param[in] min_interval	The minimum interval between two delivered events, in milliseconds
+ * @param[in] min_percent_delta	The minimum change of the percentage between two delivered events (0 ~ 100)
  * @return 0 on success, otherwise a negative error value.
  * @retval #PLAYER_ERROR_NONE Successful
  * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
- * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
- * @see player_set_progressive_download_message_cb()
+ * @see player_set_buffering_cb()
+ * @see player_get_buffering_event_count()
  */
-int player_unset_progressive_download_message_cb(player_h player);
+int player_set_buffering_coalescing(player_h player, int min_interval, int min_percent_delta);
 
 /**
- * @brief Registers a callback function to be invoked when subtitle updates.
+ * @brief Gets the number of buffering events delivered to and dropped before player_buffering_cb().
  * @param[in] player	The handle to media player
- * @param[in] callback	The callback function to register
- * @param[in] user_data	The user data to be passed to the callback function
+ * @param[out] delivered	The number of delivered events
+ * @param[out] coalesced	The number of dropped events
  * @return 0 on success, otherwise a negative error value.
  * @retval #PLAYER_ERROR_NONE Successful
  * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
- * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
- * @pre The subtitle must be set by player_set_subtitle_path().
- * @post  player_subtitle_updated_cb() will be invoked
- * @see player_unset_subtitle_updated_cb()
- * @see player_subtitle_updated_cb()
- * @see player_set_subtitle_path()
+ * @see player_set_buffering_coalescing()
  */
-int player_set_subtitle_updated_cb(player_h player, player_subtitle_updated_cb callback, void *user_data);
+int player_get_buffering_event_count(player_h player, unsigned int *delivered, unsigned int *coalesced);
 
 /**
- * @brief Unregisters the callback function.
- * @param[in] player The handle to media player
+ * @brief Gets the number of lookups served by and missed in the metadata cache of the player.
+ * @details player_get_duration(), player_get_video_size() and player_get_content_info() keep their result
+ * until the source changes, so only the first call for a source reaches the pipeline.
+ * The cache is dropped by player_set_uri(), player_set_memory_buffer(), player_unprepare() and
+ * when the player moves to the next source.
+ * @param[in] player	The handle to media player
+ * @param[out] hits	The number of lookups served from the cache
+ * @param[out] misses	The number of lookups which queried the pipeline
  * @return 0 on success, otherwise a negative error value.
  * @retval #PLAYER_ERROR_NONE Successful
  * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
- * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ */
+int player_get_metadata_cache_stats(player_h player, unsigned int *hits, unsigned int *misses);
+
+/**
+ * @brief Lets player_get_position() extrapolate the position instead of querying the pipeline on every call.
+ * @details The position queried from the pipeline is kept with the time of the query and advanced with the
+ * playback rate on later calls. It is queried again once @a resync_interval has elapsed, and after a seek,
+ * player_start(), player_pause(), player_stop(), player_set_playback_rate() or a state change of the pipeline.
+ * @remarks The interpolation is disabled by default, which is the same as setting @a resync_interval to 0.\n
+ * The extrapolated position may drift from the pipeline by up to the length of a stall shorter than @a resync_interval.
+ * @param[in] player	The handle to media player
+ * @param[in] resync_interval	The longest time between two pipeline queries, in milliseconds, or 0 to query on every call
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_get_position()
+ */
+int player_set_position_interpolation(player_h player, int resync_interval);
+
+/**
+ * @brief Registers a callback function to be invoked when the playback moves on to the next source.
+ * @param[in] player	The handle to media player
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @post  player_track_changed_cb() will be invoked
+ * @see player_unset_track_changed_cb()
+ * @see player_set_next_uri()
+ */
+int player_set_track_changed_cb(player_h player, player_track_changed_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters the callback function.
+ * @param[in] player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_set_track_changed_cb()
+ */
+int player_unset_track_changed_cb(player_h player);
+
+/**
+ * @brief Registers a callback function to be invoked when a pending seek is cancelled.
+ * @param[in] player	The handle to media player
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @post  player_seek_cancelled_cb() will be invoked
+ * @see player_unset_seek_cancelled_cb()
+ * @see player_set_position()
+ */
+int player_set_seek_cancelled_cb(player_h player, player_seek_cancelled_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters the callback function.
+ * @param[in] player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_set_seek_cancelled_cb()
+ */
+int player_unset_seek_cancelled_cb(player_h player);
+
+/**
+ * @brief Adds a listener to be invoked when one of the events of @a event_mask occurs.
+ * @details Several listeners may subscribe to the same event, next to the callback set for it.
+ * The events no one subscribed to are dropped before any dispatch work.
+ * @param[in] player	The handle to media player
+ * @param[in] event_mask	The events to subscribe to, a combination of #player_event_e
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @param[out] id	The identifier of the listener, to pass to player_remove_event_listener()
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION The player has already #PLAYER_EVENT_LISTENER_MAX listeners
+ * @post  player_event_cb() will be invoked
+ * @see player_remove_event_listener()
+ */
+int player_add_event_listener(player_h player, unsigned int event_mask, player_event_cb callback, void *user_data, int *id);
+
+/**
+ * @brief Removes a listener added by player_add_event_listener().
+ * @details The listener may still be running on another thread when this function returns.
+ * @param[in] player	The handle to media player
+ * @param[in] id	The identifier of the listener
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_add_event_listener()
+ */
+int player_remove_event_listener(player_h player, int id);
+
+/**
+ * @brief Registers a callback function to be invoked when progressive download is starts or completes.
+ * @param[in] player	The handle to media player
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @pre The path to download must be set by player_set_progressive_download_path().
+ * @post  player_pd_message_cb() will be invoked
+ * @see player_unset_progressive_download_message_cb()
+ * @see player_set_progressive_download_path()
+ */
+int player_set_progressive_download_message_cb(player_h player, player_pd_message_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters the callback function.
+ * @param[in] player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @see player_set_progressive_download_message_cb()
+ */
+int player_unset_progressive_download_message_cb(player_h player);
+
+/**
+ * @brief Registers a callback function to be invoked when subtitle updates.
+ * @param[in] player	The handle to media player
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @pre The subtitle must be set by player_set_subtitle_path().
+ * @post  player_subtitle_updated_cb() will be invoked
+ * @see player_unset_subtitle_updated_cb()
+ * @see player_subtitle_updated_cb()
+ * @see player_set_subtitle_path()
+ */
+int player_set_subtitle_updated_cb(player_h player, player_subtitle_updated_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters the callback function.
+ * @param[in] player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
  * @see player_set_subtitle_updated_cb()
  */
 int player_unset_subtitle_updated_cb(player_h player);
@@ -1665,6 +2309,178 @@ int player_set_video_frame_decoded_cb(player_h player, player_video_frame_decode
  */
 int player_unset_video_frame_decoded_cb(player_h player);
 
+/**
+ * @brief Extracts thumbnails at several positions of the video in one call.
+ * @details
+ * The player seeks to the keyframe nearest to each position, in increasing order, and downscales the frame to @a width x @a height.
+ * Each thumbnail is delivered by player_thumbnail_extracted_cb() as soon as it is ready, on a thread of the player.
+ * If no display is set, the frames are decoded without being rendered and the sound is muted meanwhile.
+ * @remarks The playback position is left at the last extracted thumbnail.
+ * @remarks player_set_position() and player_capture_video() fail while thumbnails are being extracted.
+ * @param[in] player	The handle to media player
+ * @param[in] positions	The positions of the thumbnails, in milliseconds
+ * @param[in] count	The number of @a positions
+ * @param[in] width	The width of the thumbnails
+ * @param[in] height	The height of the thumbnails
+ * @param[in] callback	The callback function to invoke for each thumbnail
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #PLAYER_ERROR_INVALID_OPERATION A seek, a capture or an extraction is in progress
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be either #PLAYER_STATE_READY by player_prepare() or #PLAYER_STATE_PAUSED by player_pause().
+ * @post player_thumbnail_extracted_cb() will be invoked @a count times, unless the extraction is cancelled.
+ * @see player_cancel_thumbnails()
+ */
+int player_extract_thumbnails(player_h player, const int *positions, int count, int width, int height, player_thumbnail_extracted_cb callback, void *user_data);
+
+/**
+ * @brief Cancels the extraction started by player_extract_thumbnails().
+ * @details No player_thumbnail_extracted_cb() is invoked after this function returns.
+ * @remarks The extraction is also cancelled by player_unprepare() and player_destroy().
+ * @param[in] player	The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_extract_thumbnails()
+ */
+int player_cancel_thumbnails(player_h player);
+
+/**
+ * @brief Registers a callback function to be invoked with a handle to each decoded video frame.
+ * @details Unlike player_video_frame_decoded_cb(), the frame stays valid after the callback as long as the application holds a reference to it.
+ * @param[in] player	The handle to media player
+ * @param[in] callback	The callback function to register
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @pre The player state must be either #PLAYER_STATE_IDLE by player_create() or #PLAYER_STATE_READY by player_prepare().
+ * @post  player_video_frame_cb() will be invoked
+ * @see player_unset_video_frame_cb()
+ */
+int player_set_video_frame_cb(player_h player, player_video_frame_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters the callback function.
+ * @remarks The frames held by the application stay valid.
+ * @param[in] player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @see player_set_video_frame_cb()
+ */
+int player_unset_video_frame_cb(player_h player);
+
+/**
+ * @brief Gets the number of video frames dropped because the application held all the frames of the player.
+ * @param[in] player The handle to media player
+ * @param[out] count The number of dropped frames
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_set_video_frame_cb()
+ */
+int player_get_video_frame_drop_count(player_h player, unsigned int *count);
+
+/**
+ * @brief Acquires a reference to the video frame.
+ * @remarks This function may be called from any thread.
+ * @param[in] frame The video frame
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_video_frame_unref()
+ */
+int player_video_frame_ref(player_video_frame_h frame);
+
+/**
+ * @brief Releases a reference to the video frame.
+ * @details The buffer goes back to the player when the last reference is released.
+ * @remarks This function may be called from any thread, also after the player has been destroyed.
+ * @param[in] frame The video frame
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_video_frame_ref()
+ */
+int player_video_frame_unref(player_video_frame_h frame);
+
+/**
+ * @brief Gets the pixel data of the video frame.
+ * @remarks @a data must not be freed, it is valid while the frame is referenced.
+ * @param[in] frame The video frame
+ * @param[out] data The pixel data
+ * @param[out] size The size of @a data
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int player_video_frame_get_data(player_video_frame_h frame, unsigned char **data, unsigned int *size);
+
+/**
+ * @brief Gets the width and the height of the video frame.
+ * @param[in] frame The video frame
+ * @param[out] width The width of the frame
+ * @param[out] height The height of the frame
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int player_video_frame_get_resolution(player_video_frame_h frame, int *width, int *height);
+
+/**
+ * @brief Gets the pixel format of the video frame.
+ * @remarks The format is the one the pipeline negotiated for the decoded frames. It is #PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN
+ * when the pipeline does not report it, or reports a format which player_video_frame_format_e does not have.
+ * @param[in] frame The video frame
+ * @param[out] format The pixel format
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int player_video_frame_get_format(player_video_frame_h frame, player_video_frame_format_e *format);
+
+/**
+ * @brief Gets the number of planes of the video frame.
+ * @param[in] frame The video frame
+ * @param[out] count The number of planes
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_video_frame_get_plane()
+ */
+int player_video_frame_get_plane_count(player_video_frame_h frame, int *count);
+
+/**
+ * @brief Gets the layout of a plane of the video frame.
+ * @param[in] frame The video frame
+ * @param[in] plane The index of the plane, from 0 to the plane count - 1
+ * @param[out] offset The offset of the plane from the start of the data, in bytes
+ * @param[out] stride The length of a line of the plane, in bytes
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_video_frame_get_plane_count()
+ */
+int player_video_frame_get_plane(player_video_frame_h frame, int plane, int *offset, int *stride);
+
+/**
+ * @brief Gets the presentation time of the video frame.
+ * @remarks The time is the playback position when the frame was decoded, extrapolated between the queries to the pipeline.
+ * @param[in] frame The video frame
+ * @param[out] millisecond The presentation time, in milliseconds
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int player_video_frame_get_timestamp(player_video_frame_h frame, int *millisecond);
+
 /**
  * @brief Registers a callback function to be invoked when audio frame is decoded.
  * @param[in] player	The handle to media player
@@ -1694,6 +2510,251 @@ int player_set_audio_frame_decoded_cb(player_h player, int start, int end ,playe
  */
 int player_unset_audio_frame_decoded_cb(player_h player);
 
+/**
+ * @brief Starts to keep the decoded audio in a buffer, to be read with player_audio_pcm_read().
+ * @details This is the pull alternative to player_set_audio_frame_decoded_cb(): the application reads large batches at its own pace,
+ * and @a policy decides what happens when it falls behind by more than @a buffer_size bytes.
+ * @remarks The audio is signed 16 bits interleaved PCM, at the sample rate and with the channels of the content.
+ * @param[in] player	The handle to media player
+ * @param[in] start	The start position to decode, in milliseconds
+ * @param[in] end	The end position to decode, in milliseconds
+ * @param[in] buffer_size	The size of the buffer, in bytes
+ * @param[in] policy	The overflow policy
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be either #PLAYER_STATE_IDLE by player_create() or #PLAYER_STATE_READY by player_prepare().
+ * @see player_audio_pcm_close()
+ * @see player_audio_pcm_read()
+ */
+int player_audio_pcm_open(player_h player, int start, int end, unsigned int buffer_size, player_audio_pcm_overflow_e policy);
+
+/**
+ * @brief Stops keeping the decoded audio and releases the buffer.
+ * @remarks The buffer is also released by player_unprepare() and player_destroy().
+ * @remarks A thread waiting in player_audio_pcm_read() returns with #PLAYER_ERROR_INVALID_OPERATION.
+ * @param[in] player	The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @see player_audio_pcm_open()
+ */
+int player_audio_pcm_close(player_h player);
+
+/**
+ * @brief Reads decoded audio from the buffer.
+ * @details Waits up to @a timeout milliseconds if the buffer is empty. @a read_bytes is 0 if nothing was decoded in time, which is counted as an underrun.
+ * @remarks Only one thread may read at a time.
+ * @remarks With #PLAYER_AUDIO_PCM_OVERFLOW_DROP_NEWEST, @a pts does not account for the dropped audio.
+ * @param[in] player	The handle to media player
+ * @param[out] buffer	The buffer to fill
+ * @param[in] max_bytes	The size of @a buffer
+ * @param[out] read_bytes	The number of bytes read
+ * @param[out] pts	The position of the first byte read, in milliseconds
+ * @param[in] timeout	The time to wait in milliseconds, 0 to return immediately, or -1 to wait until audio is available
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION The buffer is not opened, was closed, or everything was read at the end of stream
+ * @see player_audio_pcm_open()
+ */
+int player_audio_pcm_read(player_h player, void *buffer, unsigned int max_bytes, unsigned int *read_bytes, int *pts, int timeout);
+
+/**
+ * @brief Lets the pcm extraction decode as fast as possible instead of following the playback clock.
+ * @details Use this for batch processing with player_set_audio_frame_decoded_cb() or player_audio_pcm_open(),
+ * when the audio is neither displayed nor heard.
+ * @remarks Disabled by default.
+ * @param[in] player	The handle to media player
+ * @param[in] enable	@c true to decode as fast as possible, @c false to decode in realtime
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be #PLAYER_STATE_IDLE by player_create() or player_unprepare().
+ * @see player_get_decoding_speed()
+ */
+int player_set_fast_decoding(player_h player, bool enable);
+
+/**
+ * @brief Gets how fast the pcm extraction decodes, as a multiple of realtime.
+ * @details The speed is the duration of the audio decoded so far divided by the time it took, 1.0 means realtime.
+ * @remarks @a ratio is 0 until the first audio is decoded.
+ * @param[in] player	The handle to media player
+ * @param[out] ratio	The decoding speed
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be one of these: #PLAYER_STATE_READY, #PLAYER_STATE_PLAYING, or #PLAYER_STATE_PAUSED.
+ * @see player_set_fast_decoding()
+ */
+int player_get_decoding_speed(player_h player, float *ratio);
+
+/**
+ * @brief Gets the number of underruns and overruns of the decoded audio buffer.
+ * @param[in] player	The handle to media player
+ * @param[out] underruns	The number of reads which found no audio
+ * @param[out] overruns	The number of times decoded audio was dropped because the buffer was full
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION The buffer is not opened
+ * @see player_audio_pcm_open()
+ */
+int player_audio_pcm_get_stats(player_h player, unsigned int *underruns, unsigned int *overruns);
+
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup CAPI_MEDIA_PLAYER_MODULE
+ * @{
+ */
+
+/**
+ * @brief Sets the thread on which the callbacks of the player are invoked.
+ * @details
+ * By default the callbacks are invoked on the internal thread of the framework, so a slow callback delays the playback.
+ * With #PLAYER_DISPATCH_MODE_THREAD or #PLAYER_DISPATCH_MODE_MAIN_CONTEXT the framework only queues the event and returns,
+ * and the callback is invoked later with the callback and user data registered at the time of the event.
+ * @remarks player_video_frame_decoded_cb() and player_audio_frame_decoded_cb() are always invoked on the internal thread.
+ * @remarks The callbacks still waiting when the mode is changed or the player is destroyed are dropped.
+ * @param[in]   player The handle to media player
+ * @param[in]   mode The dispatch mode
+ * @param[in]   context The GMainContext to use with #PLAYER_DISPATCH_MODE_MAIN_CONTEXT, or NULL for the default context. Ignored with the other modes.
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @retval #PLAYER_ERROR_INVALID_STATE Invalid player state
+ * @pre The player state must be #PLAYER_STATE_IDLE by player_create() or player_unprepare().
+ * @see player_get_dispatch_stats()
+ */
+int player_set_dispatch_mode(player_h player, player_dispatch_mode_e mode, void *context);
+
+/**
+ * @brief Gets the statistics of the callback dispatcher.
+ * @remarks All the values are 0 with #PLAYER_DISPATCH_MODE_SYNC.
+ * @param[in]   player The handle to media player
+ * @param[out]  stats The statistics of the dispatcher
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_set_dispatch_mode()
+ */
+int player_get_dispatch_stats(player_h player, player_dispatch_stats_s *stats);
+
+/**
+ * @brief Gets the statistics of the player since its creation.
+ * @details The statistics are always collected, reading them never blocks the playback.
+ * @param[in]   player The handle to media player
+ * @param[out]  stats The statistics
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_stats_get_error_count()
+ */
+int player_get_statistics(player_h player, player_stats_s *stats);
+
+/**
+ * @brief Gets the number of times an error has been reported, from the statistics of a player.
+ * @param[in]   stats The statistics filled by player_get_statistics()
+ * @param[in]   error The error code
+ * @param[out]  count The number of times @a error has been reported
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter, or @a error is #PLAYER_ERROR_NONE
+ * @see player_get_statistics()
+ */
+int player_stats_get_error_count(const player_stats_s *stats, player_error_e error, unsigned int *count);
+
+/**
+ * @brief Creates a pool of pre-created media player handles.
+ * @details Handles kept by the pool are in #PLAYER_STATE_IDLE, so player_pool_acquire() does not pay the cost of player_create().
+ * @remarks @a pool must be released with player_pool_destroy() by you.
+ * @param[in]   low_watermark The number of handles created up front, and restored by player_pool_refill()
+ * @param[in]   high_watermark The maximum number of idle handles kept by the pool
+ * @param[out]  pool  A new handle to media player pool
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @see player_pool_destroy()
+ */
+int player_pool_create(int low_watermark, int high_watermark, player_pool_h *pool);
+
+/**
+ * @brief Destroys the media player pool and all the idle handles it keeps.
+ * @remarks The handles acquired from the pool and not released yet must be destroyed with player_destroy() by you.
+ * @param[in]   pool The handle to media player pool
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see player_pool_create()
+ */
+int player_pool_destroy(player_pool_h pool);
+
+/**
+ * @brief Takes a media player handle from the pool.
+ * @details A new handle is created with player_create() if the pool is empty.
+ * @param[in]   pool The handle to media player pool
+ * @param[out]  player A handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @post The player state will be #PLAYER_STATE_IDLE.
+ * @see player_pool_release()
+ */
+int player_pool_acquire(player_pool_h pool, player_h *player);
+
+/**
+ * @brief Gives a media player handle back to the pool.
+ * @details The handle is unprepared, its callbacks are cleared, its display is detached and its attributes are restored to the defaults.
+ * If the pool already keeps @a high_watermark idle handles, the handle is destroyed.
+ * @remarks @a player must not be used after this function returns.
+ * @param[in]   pool The handle to media player pool
+ * @param[in]   player The handle to media player
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ * @see player_pool_acquire()
+ */
+int player_pool_release(player_pool_h pool, player_h player);
+
+/**
+ * @brief Creates handles until the pool keeps @a low_watermark idle handles.
+ * @remarks Call this function when the application is idle, player_pool_acquire() never refills the pool by itself.
+ * @param[in]   pool The handle to media player pool
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #PLAYER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #PLAYER_ERROR_INVALID_OPERATION Invalid operation
+ */
+int player_pool_refill(player_pool_h pool);
+
+/**
+ * @brief Gets the statistics of the media player pool.
+ * @param[in]   pool The handle to media player pool
+ * @param[out]  stats The statistics of the pool
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #PLAYER_ERROR_NONE Successful
+ * @retval #PLAYER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int player_pool_get_stats(player_pool_h pool, player_pool_stats_s *stats);
+
 /**
  * @}
  */
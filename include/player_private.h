@@ -17,12 +17,70 @@
 #ifndef __TIZEN_MEDIA_PLAYER_PRIVATE_H__
 #define	__TIZEN_MEDIA_PLAYER_PRIVATE_H__
 #include <player.h>
+#include <stdint.h>
+#include <pthread.h>
 #include <mm_player.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+extern int _player_log_level;
+
+/*
+* Logs of the successful paths. PLAYER_TRACE() is used on the message and frame
+* paths and is compiled out unless the PLAYER_TRACE_LOG build option is set.
+*/
+#define PLAYER_INFO(fmt, arg...) \
+	do { if(_player_log_level >= PLAYER_LOG_LEVEL_INFO) LOGI(fmt, ##arg); } while(0)
+
+#ifdef PLAYER_TRACE_LOG
+#define PLAYER_TRACE(fmt, arg...) \
+	do { if(_player_log_level >= PLAYER_LOG_LEVEL_TRACE) LOGI(fmt, ##arg); } while(0)
+#else
+#define PLAYER_TRACE(fmt, arg...) do { } while(0)
+#endif
+
+/*
+* Static tracepoints (USDT) of the "capi_player" provider, compiled in with the
+* PLAYER_ENABLE_TRACEPOINTS build option. Each one is a nop until a tracer attaches.
+* PLAYER_PROBE_API() must be the first statement of a function : it fires api_entry,
+* and api_return whenever the function returns.
+*/
+#ifdef PLAYER_ENABLE_TRACEPOINTS
+#include <sys/sdt.h>
+static inline void __player_probe_return(const char **func)
+{
+	DTRACE_PROBE1(capi_player, api_return, *func);
+}
+#define PLAYER_PROBE_API() \
+	const char *__player_probe_func __attribute__((cleanup(__player_probe_return))) = __FUNCTION__; \
+	DTRACE_PROBE1(capi_player, api_entry, __player_probe_func)
+#define PLAYER_PROBE(name) DTRACE_PROBE(capi_player, name)
+#define PLAYER_PROBE1(name, a) DTRACE_PROBE1(capi_player, name, a)
+#define PLAYER_PROBE3(name, a, b, c) DTRACE_PROBE3(capi_player, name, a, b, c)
+#else
+#define PLAYER_PROBE_API() do { } while(0)
+#define PLAYER_PROBE(name) do { } while(0)
+#define PLAYER_PROBE1(name, a) do { } while(0)
+#define PLAYER_PROBE3(name, a, b, c) do { } while(0)
+#endif
+
+/* Argument and state checks of the public functions, shared by all the sources */
+#define PLAYER_CHECK_CONDITION(condition,error,msg)	\
+		if(condition) {} else \
+		{ LOGE("[%s] %s(0x%08x)",__FUNCTION__, msg,error); return error;}; \
+
+
+#define PLAYER_INSTANCE_CHECK(player)	\
+	PLAYER_CHECK_CONDITION(player != NULL, PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER")
+
+#define PLAYER_STATE_CHECK(player,expected_state)	\
+	PLAYER_CHECK_CONDITION(_player_get_state(player) == expected_state,PLAYER_ERROR_INVALID_STATE,"PLAYER_ERROR_INVALID_STATE")
+
+#define PLAYER_NULL_ARG_CHECK(arg)	\
+	PLAYER_CHECK_CONDITION(arg != NULL,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER")
+
 typedef enum {
 	_PLAYER_EVENT_TYPE_BEGIN,
 	_PLAYER_EVENT_TYPE_PREPARE,
@@ -35,26 +93,295 @@ typedef enum {
 	_PLAYER_EVENT_TYPE_CAPTURE,
 	_PLAYER_EVENT_TYPE_SEEK,
 	_PLAYER_EVENT_TYPE_VIDEO_FRAME,
+	_PLAYER_EVENT_TYPE_VIDEO_FRAME_REF,
 	_PLAYER_EVENT_TYPE_AUDIO_FRAME,
 	_PLAYER_EVENT_TYPE_PD,
+	_PLAYER_EVENT_TYPE_TRACK_CHANGED,
+	_PLAYER_EVENT_TYPE_SEEK_CANCELLED,
+	_PLAYER_EVENT_TYPE_PUSH_NEED_DATA,
+	_PLAYER_EVENT_TYPE_PUSH_ENOUGH_DATA,
+	_PLAYER_EVENT_TYPE_LISTENER,
 	_PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE,
 	_PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET,
 	_PLAYER_EVENT_TYPE_NUM
 }_player_event_e;
 
+typedef struct _player_dispatcher_s _player_dispatcher_s;
+typedef struct _player_frame_pool_s _player_frame_pool_s;
+typedef struct _player_pcm_ring_s _player_pcm_ring_s;
+typedef struct _player_thumbnail_s _player_thumbnail_s;
+typedef struct _player_mmap_s _player_mmap_s;
+
+/* The number of tags of player_content_info_e kept by the metadata cache */
+#define _PLAYER_METADATA_TAG_NUM	6
+
+/* The number of frames a player lends to the application at once */
+#define PLAYER_VIDEO_FRAME_POOL_SIZE	8
+
+/* How long the timestamp of the decoded frames is extrapolated before querying the pipeline again, in milliseconds */
+#define _PLAYER_VIDEO_FRAME_RESYNC_INTERVAL	500
+
+/* A callback invocation captured on the mm-player thread, see player_dispatch.c */
+typedef struct _player_event_s{
+	struct _player_event_s *next;
+	_player_event_e type;
+	const void *callback;
+	void *user_data;
+	long arg0;
+	long arg1;
+	void *data;
+	unsigned int size;
+	int64_t enqueued;
+} _player_event_s;
+
+/* A slot of player_add_event_listener(), read under the same seqlock as the callback slots */
+typedef struct _player_listener_s{
+	unsigned int seq;
+	unsigned int mask;
+	const void *callback;
+	void *user_data;
+} _player_listener_s;
+
 typedef struct _player_s{
 	MMHandleType mm_handle;
 	const void* user_cb[_PLAYER_EVENT_TYPE_NUM];
 	void* user_data[_PLAYER_EVENT_TYPE_NUM];
+	unsigned int user_seq[_PLAYER_EVENT_TYPE_NUM];
 	void* display_handle;
 	void* second_display_handle;
 	player_display_type_e display_type;
 	player_display_type_e second_display_type;
 	int state;
-	int is_prepare_sync;
 	bool is_stopped;
+	pthread_mutex_t next_lock;
+	MMHandleType next_mm_handle;
+	MMHandleType retired_mm_handle;
+	unsigned int mm_epoch;
+	int mm_users[2];
+	pthread_t release_thread;
+	bool release_joinable;
+	bool is_next_prepared;
+	pthread_mutex_t dispatch_lock;
+	_player_dispatcher_s *dispatcher;
+	int buffering_min_interval;
+	int buffering_min_delta;
+	int buffering_last_percent;
+	int64_t buffering_last_time;
+	unsigned int buffering_delivered;
+	unsigned int buffering_coalesced;
+	_player_frame_pool_s *frame_pool;
+	// the format reported by the pipeline for the current frame layout, and the timestamp anchor of the frames
+	int video_stream_width;
+	int video_stream_height;
+	unsigned int video_stream_size;
+	player_video_frame_format_e video_stream_format;
+	int video_frame_anchor;
+	int64_t video_frame_anchor_time;
+	unsigned int video_frame_anchor_generation;
+	pthread_mutex_t pcm_lock;
+	_player_pcm_ring_s *pcm_ring;
+	int pcm_start;
+	int pcm_bytes_per_sec;
+	uint64_t pcm_decoded_bytes;
+	int64_t pcm_first_time;
+	int64_t pcm_last_time;
+	pthread_mutex_t thumbnail_lock;
+	_player_thumbnail_s *thumbnail;
+	pthread_mutex_t metadata_lock;
+	unsigned int metadata_valid;
+	unsigned int metadata_source;
+	unsigned int metadata_cached_source;
+	int metadata_duration;
+	int metadata_width;
+	int metadata_height;
+	char *metadata_tags[_PLAYER_METADATA_TAG_NUM];
+	unsigned int metadata_hits;
+	unsigned int metadata_misses;
+	float playback_rate;
+	int position_resync_interval;
+	unsigned int position_generation;
+	unsigned int position_anchor_generation;
+	int position_at_end;
+	unsigned int position_seq;
+	int position_anchor;
+	int64_t position_anchor_time;
+	pthread_mutex_t seek_lock;
+	bool seek_in_flight;
+	unsigned int seek_generation;
+	bool seek_with_position;
+	bool seek_accurate;
+	bool seek_pending;
+	int seek_pending_format;
+	int seek_pending_pos;
+	bool seek_pending_accurate;
+	bool seek_pending_with_position;
+	const void *seek_pending_cb;
+	void *seek_pending_user_data;
+	bool scrubbing;
+	int scrub_muted;
+	int scrub_target;
+	_player_mmap_s *mmap;
+	int mmap_duration;
+	bool is_push_source;
+	player_stats_s stats;
+	int64_t stats_prepare_start;
+	int64_t stats_start_start;
+	int64_t stats_seek_start;
+	int64_t stats_stall_start;
+	pthread_mutex_t listener_lock;
+	unsigned int listener_mask;
+	_player_listener_s listeners[PLAYER_EVENT_LISTENER_MAX];
 } player_s;
 
+/*
+* The callback slots are written by the application threads and read by the mm-player
+* threads. Each (user_cb, user_data) pair is guarded by a seqlock : the writer makes
+* user_seq odd for the time of the update and the reader retries until it saw the same
+* even sequence before and after, so a callback is never paired with a stale user_data
+* and the frame paths never block. The state is only accessed atomically.
+*/
+static inline void _player_set_user_cb(player_s *handle, _player_event_e type, const void *callback, void *user_data)
+{
+	unsigned int seq = __atomic_load_n(&handle->user_seq[type], __ATOMIC_RELAXED);
+	while((seq & 1) || !__atomic_compare_exchange_n(&handle->user_seq[type], &seq, seq + 1, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		seq = __atomic_load_n(&handle->user_seq[type], __ATOMIC_RELAXED);
+	// the odd sequence must be visible before the slot changes, as in __listener_set()
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&handle->user_cb[type], callback, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->user_data[type], user_data, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->user_seq[type], seq + 2, __ATOMIC_RELEASE);
+}
+
+static inline const void* _player_get_user_cb(player_s *handle, _player_event_e type, void **user_data)
+{
+	unsigned int seq;
+	const void *callback;
+	do
+	{
+		seq = __atomic_load_n(&handle->user_seq[type], __ATOMIC_ACQUIRE);
+		callback = __atomic_load_n(&handle->user_cb[type], __ATOMIC_RELAXED);
+		*user_data = __atomic_load_n(&handle->user_data[type], __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while((seq & 1) || seq != __atomic_load_n(&handle->user_seq[type], __ATOMIC_RELAXED));
+	return callback;
+}
+
+static inline bool _player_has_user_cb(player_s *handle, _player_event_e type)
+{
+	return __atomic_load_n(&handle->user_cb[type], __ATOMIC_RELAXED) != NULL;
+}
+
+static inline int _player_get_state(player_s *handle)
+{
+	return __atomic_load_n(&handle->state, __ATOMIC_ACQUIRE);
+}
+
+static inline void _player_set_state(player_s *handle, int state)
+{
+	__atomic_store_n(&handle->state, state, __ATOMIC_RELEASE);
+}
+
+/* The pipeline in use, the gapless switch replaces it from the message thread */
+static inline MMHandleType _player_get_mm_handle(player_s *handle)
+{
+	return __atomic_load_n(&handle->mm_handle, __ATOMIC_SEQ_CST);
+}
+
+/*
+* A function which loads mm_handle starts with PLAYER_MM_GUARD(), which counts it in the
+* slot of the current epoch until it returns. The gapless switch publishes the next
+* pipeline and then moves to the next epoch. The release threads run one after the other,
+* each destroys the previous pipeline once the slot of the epoch it replaced has drained.
+* player_destroy() and _player_reset() wait for them, so they never take the guard.
+*/
+static inline int* _player_mm_enter(player_s *handle)
+{
+	while(TRUE)
+	{
+		unsigned int epoch = __atomic_load_n(&handle->mm_epoch, __ATOMIC_SEQ_CST);
+		int *users = &handle->mm_users[epoch & 1];
+		__atomic_add_fetch(users, 1, __ATOMIC_SEQ_CST);
+		// counted too late for that epoch, its slot may be waited for already
+		if(__atomic_load_n(&handle->mm_epoch, __ATOMIC_SEQ_CST) == epoch)
+			return users;
+		__atomic_sub_fetch(users, 1, __ATOMIC_RELEASE);
+	}
+}
+
+static inline void _player_mm_leave(int **users)
+{
+	__atomic_sub_fetch(*users, 1, __ATOMIC_RELEASE);
+}
+
+#define PLAYER_MM_GUARD(handle) \
+	int *__player_mm_users __attribute__((cleanup(_player_mm_leave))) = _player_mm_enter(handle)
+
+/* Brings the handle back to #PLAYER_STATE_IDLE as if it had just been created */
+int _player_reset(player_h player);
+
+/* Invokes the user callback of @a type now, or queues it to the dispatcher if one is set */
+void _player_post_event(player_s *handle, _player_event_e type, long arg0, long arg1, const void *data, unsigned int size);
+/* Same as _player_post_event(), with a callback the caller read along with the state it belongs to */
+void _player_post_callback(player_s *handle, _player_event_e type, const void *callback, void *user_data, long arg0, long arg1, const void *data, unsigned int size);
+void _player_invoke_event(const _player_event_s *ev);
+void _player_dispatcher_release(player_s *handle);
+/* TRUE if a callback is set for @a type or a listener subscribed to it */
+bool _player_wants_event(player_s *handle, _player_event_e type);
+void _player_listener_clear(player_s *handle);
+
+_player_frame_pool_s* _player_frame_pool_create(int max_frames);
+void _player_frame_pool_release(_player_frame_pool_s *pool);
+unsigned int _player_frame_pool_get_dropped(_player_frame_pool_s *pool);
+/* Copies the frame into a buffer of the pool, returns NULL and counts a drop if none is free */
+player_video_frame_h _player_frame_pool_get(_player_frame_pool_s *pool, const void *data, unsigned int size, int width, int height, player_video_frame_format_e format, int timestamp);
+/* The format of a decoded frame, shared by the frames lent to the application and the thumbnails */
+unsigned int _player_video_frame_get_min_size(player_video_frame_format_e format, int width, int height);
+
+/* The ring is reference counted, the producer and the readers hold a reference while they use it */
+_player_pcm_ring_s* _player_pcm_ring_create(unsigned int capacity, player_audio_pcm_overflow_e policy);
+_player_pcm_ring_s* _player_pcm_ring_ref(_player_pcm_ring_s *ring);
+void _player_pcm_ring_unref(_player_pcm_ring_s *ring);
+/* Wakes up the producer and the readers, the ring is never written again */
+void _player_pcm_ring_close(_player_pcm_ring_s *ring);
+/* Closes the ring and drops the reference of the creator */
+void _player_pcm_ring_destroy(_player_pcm_ring_s *ring);
+/* Nothing more is decoded until the next write, wakes up the readers */
+void _player_pcm_ring_set_eos(_player_pcm_ring_s *ring);
+void _player_pcm_ring_write(_player_pcm_ring_s *ring, const void *data, unsigned int size);
+/*
+* @a position is the number of bytes written to the ring before the first byte read.
+* Fails with PLAYER_ERROR_INVALID_OPERATION once the ring is closed, or empty at the end of the stream.
+*/
+int _player_pcm_ring_read(_player_pcm_ring_s *ring, void *buffer, unsigned int max_bytes, unsigned int *read_bytes, uint64_t *position, int timeout);
+void _player_pcm_ring_get_stats(_player_pcm_ring_s *ring, unsigned int *underruns, unsigned int *overruns);
+
+int _player_thumbnail_start(player_s *handle, const int *positions, int count, int width, int height, bool headless, bool own_stream_callback, player_thumbnail_extracted_cb callback, void *user_data);
+void _player_thumbnail_stop(player_s *handle);
+bool _player_thumbnail_is_running(player_s *handle);
+/* Hand the events the extraction waits for, return TRUE if it took them */
+bool _player_thumbnail_seek_completed(player_s *handle);
+bool _player_thumbnail_captured(player_s *handle, const void *data, int width, int height, unsigned int size);
+bool _player_thumbnail_frame(player_s *handle, const void *data, int width, int height, unsigned int size, player_video_frame_format_e format);
+
+/* album, artist, author, genre, title, year, audio_codec and video_codec, in this order */
+#define _PLAYER_MEDIA_INFO_STRING_NUM	8
+/* Copies the strings into the arena of @a info, @a val may hold NULL */
+int _player_media_info_set_strings(player_media_info_s *info, char **val, int *len);
+
+/* Lock-free statistics, see player_stats.c */
+void _player_stats_mark(int64_t *mark);
+void _player_stats_record(player_latency_histogram_s *histogram, int64_t *mark);
+void _player_stats_record_value(player_latency_histogram_s *histogram, unsigned int millisecond);
+void _player_stats_buffering(player_s *handle, int percent);
+void _player_stats_error(player_s *handle, int error);
+void _player_stats_reset(player_s *handle);
+
+/* Read-only file mapping fed to the memory source, see player_mmap.c */
+int _player_mmap_open(const char *path, int64_t offset, int length, _player_mmap_s **map);
+void _player_mmap_close(_player_mmap_s *map);
+const void* _player_mmap_get_data(_player_mmap_s *map, int *length);
+void _player_mmap_advise(_player_mmap_s *map, int permille);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,7 @@ BuildRequires:  pkgconfig(mm-player)
 BuildRequires:  pkgconfig(capi-base-common)
 BuildRequires:  pkgconfig(capi-media-sound-manager)
 BuildRequires:  pkgconfig(mm-ta)
+BuildRequires:  pkgconfig(mm-fileinfo)
 Requires(post): /sbin/ldconfig
 Requires(postun): /sbin/ldconfig
 
@@ -17,6 +17,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <mm.h>
 #include <mm_player.h>
 #include <mm_player_sndeffect.h>
@@ -36,19 +40,7 @@
 * Internal Macros
 */
 
-#define PLAYER_CHECK_CONDITION(condition,error,msg)	\
-		if(condition) {} else \
-		{ LOGE("[%s] %s(0x%08x)",__FUNCTION__, msg,error); return error;}; \
-
-
-#define PLAYER_INSTANCE_CHECK(player)	\
-	PLAYER_CHECK_CONDITION(player != NULL, PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER")
-	
-#define PLAYER_STATE_CHECK(player,expected_state)	\
-	PLAYER_CHECK_CONDITION(player->state == expected_state,PLAYER_ERROR_INVALID_STATE,"PLAYER_ERROR_INVALID_STATE")
-
-#define PLAYER_NULL_ARG_CHECK(arg)	\
-	PLAYER_CHECK_CONDITION(arg != NULL,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER")
+int _player_log_level = PLAYER_LOG_LEVEL_TRACE;
 
 /*
 * Internal Implementation
@@ -198,7 +190,7 @@ static player_state_e __convert_player_state(MMPlayerStateType state)
 
 static bool __player_state_validate(player_s * handle, player_state_e threshold)
 {
-	if (handle->state < threshold)
+	if (_player_get_state(handle) < threshold)
 		return FALSE;
 	return TRUE;
 }
@@ -208,9 +200,8 @@ static int __set_callback(_player_event_e type, player_h player, void* callback,
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(callback);
 	player_s * handle = (player_s *) player;
-	handle->user_cb[type] = callback;
-	handle->user_data[type] = user_data;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, type);
+	_player_set_user_cb(handle, type, callback, user_data);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, type);
 	return PLAYER_ERROR_NONE;
 }
 
@@ -218,84 +209,463 @@ static int __unset_callback(_player_event_e type, player_h player)
 {
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	handle->user_cb[type] = NULL;
-	handle->user_data[type] = NULL;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, type);
+	_player_set_user_cb(handle, type, NULL, NULL);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, type);
 	return PLAYER_ERROR_NONE;
 }
 
+static int64_t __get_monotonic_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/*
+* Position interpolation : the position queried from the pipeline is kept with the
+* time of the query and extrapolated with the playback rate until the resync interval
+* elapses. Anything which moves the position bumps position_generation, which may
+* happen on the message thread, so an anchor taken before the bump is never used.
+* The anchor is written under the position_seq seqlock : a writer which finds it
+* taken skips its anchor, the one being stored is as fresh.
+*/
+static void __position_invalidate(player_s *handle)
+{
+	__atomic_add_fetch(&handle->position_generation, 1, __ATOMIC_ACQ_REL);
+}
+
+static bool __position_extrapolate(player_s *handle, int *millisecond)
+{
+	int resync_interval = __atomic_load_n(&handle->position_resync_interval, __ATOMIC_RELAXED);
+	unsigned int seq;
+	unsigned int generation;
+	int anchor;
+	int64_t anchor_time;
+	float rate;
+
+	if(resync_interval <= 0)
+		return FALSE;
+	do
+	{
+		seq = __atomic_load_n(&handle->position_seq, __ATOMIC_ACQUIRE);
+		anchor = __atomic_load_n(&handle->position_anchor, __ATOMIC_RELAXED);
+		anchor_time = __atomic_load_n(&handle->position_anchor_time, __ATOMIC_RELAXED);
+		generation = __atomic_load_n(&handle->position_anchor_generation, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while((seq & 1) || seq != __atomic_load_n(&handle->position_seq, __ATOMIC_RELAXED));
+
+	if(anchor_time == 0 || generation != __atomic_load_n(&handle->position_generation, __ATOMIC_ACQUIRE))
+		return FALSE;
+
+	int64_t elapsed = __get_monotonic_ms() - anchor_time;
+	if(elapsed >= resync_interval)
+		return FALSE;
+	if(_player_get_state(handle) != PLAYER_STATE_PLAYING)
+	{
+		*millisecond = anchor;
+		return TRUE;
+	}
+	__atomic_load(&handle->playback_rate, &rate, __ATOMIC_RELAXED);
+	int64_t pos = anchor + (int64_t)(elapsed * rate);
+	*millisecond = pos > 0 ? (int)pos : 0;
+	return TRUE;
+}
+
+static void __position_anchor(player_s *handle, unsigned int generation, int millisecond)
+{
+	// the pipeline doesn't move after the end of stream, extrapolating would run past the duration
+	if(__atomic_load_n(&handle->position_resync_interval, __ATOMIC_RELAXED) <= 0 || __atomic_load_n(&handle->position_at_end, __ATOMIC_ACQUIRE))
+		return;
+
+	unsigned int seq = __atomic_load_n(&handle->position_seq, __ATOMIC_RELAXED);
+	if((seq & 1) || !__atomic_compare_exchange_n(&handle->position_seq, &seq, seq + 1, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		return;
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&handle->position_anchor, millisecond, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->position_anchor_time, __get_monotonic_ms(), __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->position_anchor_generation, generation, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->position_seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+/*
+* Seek coalescing : one seek is in flight at a time and the latest request waits in a
+* single pending slot, replacing the one already there. The pending seek is issued
+* when the in-flight one completes. seek_lock is never held while calling mm-player
+* or a user callback, both may call back into the seek functions.
+*/
+static void __seek_cancelled(player_s *handle, void *seek_user_data)
+{
+	PLAYER_INFO("[%s] superseded seek : %p",__FUNCTION__, seek_user_data);
+	_player_post_event(handle, _PLAYER_EVENT_TYPE_SEEK_CANCELLED, (long)(intptr_t)seek_user_data, 0, NULL, 0);
+}
+
+static void __mmap_release(player_s *handle)
+{
+	_player_mmap_close(handle->mmap);
+	handle->mmap = NULL;
+	handle->mmap_duration = 0;
+}
+
+/* Moves the read-ahead of the mapped source to the position, assuming a constant bit rate */
+static void __mmap_follow(player_s *handle, int format, int pos)
+{
+	if(handle->mmap == NULL)
+		return;
+	if(format == MM_PLAYER_POS_FORMAT_PERCENT)
+	{
+		_player_mmap_advise(handle->mmap, pos * 10);
+		return;
+	}
+	if(handle->mmap_duration <= 0 && mm_player_get_attribute(_player_get_mm_handle(handle), NULL, MM_PLAYER_CONTENT_DURATION, &handle->mmap_duration, (char*)NULL) != MM_ERROR_NONE)
+		return;
+	if(handle->mmap_duration > 0)
+		_player_mmap_advise(handle->mmap, (int)((int64_t)pos * 1000 / handle->mmap_duration));
+}
+
+/* Only one seek is issued at a time, so seek_accurate is never written concurrently */
+static int __seek_issue(player_s *handle, int format, int pos, bool accurate)
+{
+	if(accurate != handle->seek_accurate)
+	{
+		int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "accurate_seek", accurate, (char*)NULL);
+		if(ret != MM_ERROR_NONE)
+			return ret;
+		handle->seek_accurate = accurate;
+	}
+	__atomic_store_n(&handle->position_at_end, 0, __ATOMIC_RELEASE);
+	__position_invalidate(handle);
+	__mmap_follow(handle, format, pos);
+	_player_stats_mark(&handle->stats_seek_start);
+	return mm_player_set_position(_player_get_mm_handle(handle), format, pos);
+}
+
+static int __seek_start(player_s *handle, int format, int pos, bool accurate, const void *callback, void *user_data, bool with_position)
+{
+	pthread_mutex_lock(&handle->seek_lock);
+	if(handle->seek_in_flight)
+	{
+		bool superseded = handle->seek_pending;
+		const void *superseded_cb = handle->seek_pending_cb;
+		void *superseded_user_data = handle->seek_pending_user_data;
+
+		handle->seek_pending = TRUE;
+		handle->seek_pending_format = format;
+		handle->seek_pending_pos = pos;
+		handle->seek_pending_accurate = accurate;
+		handle->seek_pending_with_position = with_position;
+		handle->seek_pending_cb = callback;
+		handle->seek_pending_user_data = user_data;
+		pthread_mutex_unlock(&handle->seek_lock);
+		// seeks without a callback, such as the scrubbing ones, are dropped silently
+		if(superseded && superseded_cb)
+			__seek_cancelled(handle, superseded_user_data);
+		return PLAYER_ERROR_NONE;
+	}
+	handle->seek_in_flight = TRUE;
+	handle->seek_with_position = with_position;
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_SEEK, callback, user_data);
+	pthread_mutex_unlock(&handle->seek_lock);
+
+	int ret = __seek_issue(handle, format, pos, accurate);
+	if(ret != MM_ERROR_NONE)
+	{
+		pthread_mutex_lock(&handle->seek_lock);
+		_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_SEEK, NULL, NULL);
+		handle->seek_in_flight = FALSE;
+		pthread_mutex_unlock(&handle->seek_lock);
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	}
+	return PLAYER_ERROR_NONE;
+}
+
+/*
+* The seek which has just completed. Its callback and whether it reports the position are
+* read together, player_set_position() and player_set_position_ex() take different callbacks.
+*/
+static bool __seek_get_completed(player_s *handle, unsigned int *generation, const void **callback, void **user_data)
+{
+	pthread_mutex_lock(&handle->seek_lock);
+	*generation = handle->seek_generation;
+	*callback = _player_get_user_cb(handle, _PLAYER_EVENT_TYPE_SEEK, user_data);
+	bool with_position = handle->seek_with_position;
+	pthread_mutex_unlock(&handle->seek_lock);
+	return with_position;
+}
+
+/*
+* Called on the message thread once the in-flight seek has completed. Nothing is done
+* if the seeks have been reset meanwhile, the in-flight seek may then be a newer one.
+*/
+static void __seek_issue_pending(player_s *handle, unsigned int generation)
+{
+	while(TRUE)
+	{
+		pthread_mutex_lock(&handle->seek_lock);
+		if(handle->seek_generation != generation)
+		{
+			pthread_mutex_unlock(&handle->seek_lock);
+			return;
+		}
+		_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_SEEK, NULL, NULL);
+		if(!handle->seek_pending)
+		{
+			handle->seek_in_flight = FALSE;
+			pthread_mutex_unlock(&handle->seek_lock);
+			return;
+		}
+		int format = handle->seek_pending_format;
+		int pos = handle->seek_pending_pos;
+		bool accurate = handle->seek_pending_accurate;
+		const void *callback = handle->seek_pending_cb;
+		void *user_data = handle->seek_pending_user_data;
+		handle->seek_pending = FALSE;
+		handle->seek_with_position = handle->seek_pending_with_position;
+		_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_SEEK, callback, user_data);
+		pthread_mutex_unlock(&handle->seek_lock);
+
+		int ret = __seek_issue(handle, format, pos, accurate);
+		if(ret == MM_ERROR_NONE)
+			return;
+		LOGE("[%s] Failed to issue the pending seek to %d (0x%x)", __FUNCTION__, pos, ret);
+		if(callback)
+			__seek_cancelled(handle, user_data);
+	}
+}
+
+static bool __seek_is_in_flight(player_s *handle)
+{
+	pthread_mutex_lock(&handle->seek_lock);
+	bool in_flight = handle->seek_in_flight;
+	pthread_mutex_unlock(&handle->seek_lock);
+	return in_flight;
+}
+
+static void __seek_reset(player_s *handle)
+{
+	pthread_mutex_lock(&handle->seek_lock);
+	handle->seek_generation++;
+	handle->seek_in_flight = FALSE;
+	handle->seek_with_position = FALSE;
+	handle->seek_pending = FALSE;
+	handle->seek_pending_cb = NULL;
+	handle->seek_pending_user_data = NULL;
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_SEEK, NULL, NULL);
+	pthread_mutex_unlock(&handle->seek_lock);
+}
+
+/*
+* Called when the pipeline drops the seeks it was given : stop, error or a state drop.
+* Neither the in-flight nor the pending seek will complete, both are reported cancelled
+* so that the next seek is issued at once.
+*/
+static void __seek_abort(player_s *handle)
+{
+	void *in_flight_user_data = NULL;
+	const void *in_flight_cb;
+
+	pthread_mutex_lock(&handle->seek_lock);
+	if(!handle->seek_in_flight)
+	{
+		pthread_mutex_unlock(&handle->seek_lock);
+		return;
+	}
+	in_flight_cb = _player_get_user_cb(handle, _PLAYER_EVENT_TYPE_SEEK, &in_flight_user_data);
+	bool pending = handle->seek_pending && handle->seek_pending_cb;
+	void *pending_user_data = handle->seek_pending_user_data;
+	pthread_mutex_unlock(&handle->seek_lock);
+	__seek_reset(handle);
+
+	if(in_flight_cb)
+		__seek_cancelled(handle, in_flight_user_data);
+	if(pending)
+		__seek_cancelled(handle, pending_user_data);
+}
+
+/*
+* The scrubbing state is guarded by seek_lock, which is also held while the mute is
+* saved and restored so that player_set_mute() is never applied in between.
+*/
+static bool __scrub_stop(player_s *handle, int *target)
+{
+	pthread_mutex_lock(&handle->seek_lock);
+	bool scrubbing = handle->scrubbing;
+	if(scrubbing)
+	{
+		handle->scrubbing = FALSE;
+		mm_player_set_mute(_player_get_mm_handle(handle), handle->scrub_muted);
+	}
+	if(target)
+		*target = handle->scrub_target;
+	pthread_mutex_unlock(&handle->seek_lock);
+	return scrubbing;
+}
+
+/*
+* Runs on the message thread. The settings and the counters are also accessed by the
+* application threads, the last delivered event by _player_reset(), hence the atomics.
+*/
+static bool __buffering_should_deliver(player_s * handle, int percent)
+{
+	int64_t now = __get_monotonic_ms();
+	int last_percent = __atomic_load_n(&handle->buffering_last_percent, __ATOMIC_RELAXED);
+
+	// the start and the end of buffering are never coalesced
+	if(percent > 0 && percent < 100 && last_percent >= 0)
+	{
+		int min_interval = __atomic_load_n(&handle->buffering_min_interval, __ATOMIC_RELAXED);
+		int min_delta = __atomic_load_n(&handle->buffering_min_delta, __ATOMIC_RELAXED);
+		if((min_interval > 0 && now - __atomic_load_n(&handle->buffering_last_time, __ATOMIC_RELAXED) < min_interval) ||
+			(min_delta > 0 && abs(percent - last_percent) < min_delta))
+		{
+			__atomic_add_fetch(&handle->buffering_coalesced, 1, __ATOMIC_RELAXED);
+			return FALSE;
+		}
+	}
+	__atomic_store_n(&handle->buffering_last_percent, percent, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->buffering_last_time, now, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&handle->buffering_delivered, 1, __ATOMIC_RELAXED);
+	return TRUE;
+}
+
+static int __get_pcm_bytes_per_sec(player_s * handle)
+{
+	// player_audio_pcm_read() may wait for long, it only counts itself for the query
+	PLAYER_MM_GUARD(handle);
+	int bytes_per_sec = __atomic_load_n(&handle->pcm_bytes_per_sec, __ATOMIC_RELAXED);
+	if(bytes_per_sec == 0)
+	{
+		int sample_rate = 0;
+		int channel = 0;
+		mm_player_get_attribute(_player_get_mm_handle(handle), NULL, MM_PLAYER_AUDIO_SAMPLERATE, &sample_rate, MM_PLAYER_AUDIO_CHANNEL, &channel, (char*)NULL);
+		// pcm extraction always outputs signed 16 bits samples
+		bytes_per_sec = sample_rate * channel * 2;
+		__atomic_store_n(&handle->pcm_bytes_per_sec, bytes_per_sec, __ATOMIC_RELAXED);
+	}
+	return bytes_per_sec;
+}
+
+/*
+* pcm_ring is only swapped under pcm_lock and its users take a reference under it,
+* so the ring outlives a close racing with the audio stream or with a reader.
+*/
+static _player_pcm_ring_s* __pcm_ring_get(player_s *handle)
+{
+	_player_pcm_ring_s *ring;
+	if(__atomic_load_n(&handle->pcm_ring, __ATOMIC_ACQUIRE) == NULL)
+		return NULL;
+	pthread_mutex_lock(&handle->pcm_lock);
+	ring = handle->pcm_ring ? _player_pcm_ring_ref(handle->pcm_ring) : NULL;
+	pthread_mutex_unlock(&handle->pcm_lock);
+	return ring;
+}
+
+/* Must come before the pipeline goes down, which waits for a producer blocked on a full ring */
+static bool __pcm_ring_release(player_s *handle)
+{
+	pthread_mutex_lock(&handle->pcm_lock);
+	_player_pcm_ring_s *ring = handle->pcm_ring;
+	__atomic_store_n(&handle->pcm_ring, NULL, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&handle->pcm_lock);
+	_player_pcm_ring_destroy(ring);
+	return ring != NULL;
+}
+
+static int __switch_to_next_source(player_s *handle);
+
 static int __msg_callback(int message, void *param, void *user_data)
 {
 	player_s * handle = (player_s*)user_data;
+	PLAYER_MM_GUARD(handle);
 	MMMessageParamType *msg = (MMMessageParamType*)param;
-	LOGI("[%s] Start : Got message type : 0x%x" ,__FUNCTION__, message);
+	PLAYER_PROBE1(message, message);
+	if(message == MM_MESSAGE_BUFFERING)
+	{
+		_player_stats_buffering(handle, msg->connection.buffering);
+		if(!_player_wants_event(handle, _PLAYER_EVENT_TYPE_BUFFERING) || !__buffering_should_deliver(handle, msg->connection.buffering))
+			return 1;
+	}
+	PLAYER_TRACE("[%s] Start : Got message type : 0x%x" ,__FUNCTION__, message);
 	player_error_e err_code = PLAYER_ERROR_NONE;
+	unsigned int seek_generation;
+	const void *seek_cb;
+	void *seek_user_data = NULL;
+	bool seek_with_position;
 	switch(message)
 	{
 		case MM_MESSAGE_ERROR: //0x01
+			__seek_abort(handle);
 			err_code = __convert_error_code(msg->code,(char*)__FUNCTION__);
 			break;
 		case  MM_MESSAGE_STATE_CHANGED:	//0x03
-			LOGE("STATE CHANGED INTERNALLY - from : %d,  to : %d (CAPI State : %d)", msg->state.previous, msg->state.current, handle->state);
+			__position_invalidate(handle);
+			PLAYER_TRACE("STATE CHANGED INTERNALLY - from : %d,  to : %d (CAPI State : %d)", msg->state.previous, msg->state.current, _player_get_state(handle));
 
-			if(handle->state == PLAYER_STATE_PLAYING && msg->state.current == MM_PLAYER_STATE_PAUSED &&  handle->user_cb[_PLAYER_EVENT_TYPE_PAUSE] )
+			if(_player_get_state(handle) == PLAYER_STATE_IDLE && msg->state.previous == MM_PLAYER_STATE_READY && msg->state.current == MM_PLAYER_STATE_PAUSED)
+			{
+				// prerolled : the first frame has been decoded
+				if(_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_PREPARE)) // asyc && prepared cb has been set
+				{
+					_player_set_state(handle, PLAYER_STATE_READY);
+					MMTA_ACUM_ITEM_END("[CAPI] player_prepare", 0);
+					_player_stats_record(&handle->stats.prepare, &handle->stats_prepare_start);
+					PLAYER_PROBE(prepared);
+					_player_post_event(handle, _PLAYER_EVENT_TYPE_PREPARE, 0, 0, NULL, 0);
+					_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PREPARE, NULL, NULL);
+				}
+			}
+			else if(_player_get_state(handle) == PLAYER_STATE_PLAYING && msg->state.current == MM_PLAYER_STATE_PAUSED &&  _player_wants_event(handle, _PLAYER_EVENT_TYPE_PAUSE) )
 			{
-				LOGE("[%s] Invoke the paused callback", __FUNCTION__);
-				((player_paused_cb)handle->user_cb[_PLAYER_EVENT_TYPE_PAUSE])(handle->user_data[_PLAYER_EVENT_TYPE_PAUSE]);
+				PLAYER_TRACE("[%s] Invoke the paused callback", __FUNCTION__);
+				_player_post_event(handle, _PLAYER_EVENT_TYPE_PAUSE, 0, 0, NULL, 0);
 			}
 			break;
 		case MM_MESSAGE_READY_TO_RESUME: //0x05
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_INTERRUPT] )
+			if( _player_wants_event(handle, _PLAYER_EVENT_TYPE_INTERRUPT) )
 			{
-				((player_interrupted_cb)handle->user_cb[_PLAYER_EVENT_TYPE_INTERRUPT])(PLAYER_INTERRUPTED_COMPLETED,handle->user_data[_PLAYER_EVENT_TYPE_INTERRUPT]);
+				_player_post_event(handle, _PLAYER_EVENT_TYPE_INTERRUPT, PLAYER_INTERRUPTED_COMPLETED, 0, NULL, 0);
 			}
 			break;
 		case MM_MESSAGE_BEGIN_OF_STREAM: //0x104
-			if(handle->is_prepare_sync)//sync && started cb has been set
+			_player_stats_record(&handle->stats.start_to_begin, &handle->stats_start_start);
+			if(_player_wants_event(handle, _PLAYER_EVENT_TYPE_BEGIN))
 			{
-				if(handle->user_cb[_PLAYER_EVENT_TYPE_BEGIN])
-				{
-					MMTA_ACUM_ITEM_END("[CAPI] player_start ~ BOS", 0);
-					((player_started_cb)handle->user_cb[_PLAYER_EVENT_TYPE_BEGIN])(handle->user_data[_PLAYER_EVENT_TYPE_BEGIN]);
-				}
+				MMTA_ACUM_ITEM_END("[CAPI] player_start ~ BOS", 0);
+				_player_post_event(handle, _PLAYER_EVENT_TYPE_BEGIN, 0, 0, NULL, 0);
 			}
-			else
+			break;
+		case MM_MESSAGE_END_OF_STREAM://0x105
+			if(__atomic_load_n(&handle->is_next_prepared, __ATOMIC_ACQUIRE) && _player_get_state(handle) == PLAYER_STATE_PLAYING)
 			{
-				if(handle->state!=PLAYER_STATE_IDLE)
+				if(__switch_to_next_source(handle) == PLAYER_ERROR_NONE)
 				{
-					LOGE("[%s] Nothing to happen in BOS [current state : %d] - (prepared_cb should be called when user invoke prepare()).  ", __FUNCTION__, handle->state);
+					_player_post_event(handle, _PLAYER_EVENT_TYPE_TRACK_CHANGED, 0, 0, NULL, 0);
+					break;
 				}
-				else
+			}
+			__atomic_store_n(&handle->position_at_end, 1, __ATOMIC_RELEASE);
+			__position_invalidate(handle);
+			{
+				_player_pcm_ring_s *ring = __pcm_ring_get(handle);
+				if(ring)
 				{
-					handle->state=PLAYER_STATE_READY;
-					if(handle->user_cb[_PLAYER_EVENT_TYPE_PREPARE]) // asyc && prepared cb has been set
-					{
-						mm_player_pause(handle->mm_handle);
-						mm_player_set_mute(handle->mm_handle,0);
-						((player_prepared_cb)handle->user_cb[_PLAYER_EVENT_TYPE_PREPARE])(handle->user_data[_PLAYER_EVENT_TYPE_PREPARE]);
-						handle->user_cb[_PLAYER_EVENT_TYPE_PREPARE] = NULL;
-						handle->user_data[_PLAYER_EVENT_TYPE_PREPARE] = NULL;
-					}
+					_player_pcm_ring_set_eos(ring);
+					_player_pcm_ring_unref(ring);
 				}
 			}
-			break;
-		case MM_MESSAGE_END_OF_STREAM://0x105
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_COMPLETE] )
-			{
-				((player_completed_cb)handle->user_cb[_PLAYER_EVENT_TYPE_COMPLETE])(handle->user_data[_PLAYER_EVENT_TYPE_COMPLETE]);
-			}	
+			_player_post_event(handle, _PLAYER_EVENT_TYPE_COMPLETE, 0, 0, NULL, 0);
 			break;
 		case MM_MESSAGE_BUFFERING: //0x103
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_BUFFERING] )
-			{
-				((player_buffering_cb)handle->user_cb[_PLAYER_EVENT_TYPE_BUFFERING])(msg->connection.buffering,handle->user_data[_PLAYER_EVENT_TYPE_BUFFERING]);
-			}
+			_player_post_event(handle, _PLAYER_EVENT_TYPE_BUFFERING, msg->connection.buffering, 0, NULL, 0);
 			break;
 		case MM_MESSAGE_STATE_INTERRUPTED: //0x04
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_INTERRUPT] )
+			__position_invalidate(handle);
+			// the drops requested through this API abort the seeks themselves, this one is not
+			if(msg->state.current == MM_PLAYER_STATE_READY || msg->state.current == MM_PLAYER_STATE_NULL)
+				__seek_abort(handle);
+			if( _player_wants_event(handle, _PLAYER_EVENT_TYPE_INTERRUPT) )
 			{
-				handle->state = __convert_player_state(msg->state.current);
-				((player_interrupted_cb)handle->user_cb[_PLAYER_EVENT_TYPE_INTERRUPT])(__convert_interrupted_code(msg->code),handle->user_data[_PLAYER_EVENT_TYPE_INTERRUPT]);
+				_player_set_state(handle, __convert_player_state(msg->state.current));
+				_player_post_event(handle, _PLAYER_EVENT_TYPE_INTERRUPT, __convert_interrupted_code(msg->code), 0, NULL, 0);
 			}
 			break;
 		case MM_MESSAGE_CONNECTION_TIMEOUT: //0x102
@@ -303,25 +673,38 @@ static int __msg_callback(int message, void *param, void *user_data)
 			err_code = PLAYER_ERROR_CONNECTION_FAILED;
 			break;
 		case MM_MESSAGE_UPDATE_SUBTITLE: //0x109
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_SUBTITLE] )
+			if( _player_wants_event(handle, _PLAYER_EVENT_TYPE_SUBTITLE) )
 			{
-				((player_subtitle_updated_cb)handle->user_cb[_PLAYER_EVENT_TYPE_SUBTITLE])(msg->subtitle.duration, (char*)msg->data,handle->user_data[_PLAYER_EVENT_TYPE_SUBTITLE]);
+				_player_post_event(handle, _PLAYER_EVENT_TYPE_SUBTITLE, msg->subtitle.duration, 0, msg->data, msg->data ? strlen((char*)msg->data) + 1 : 0);
 			}	
 			break;
 		case MM_MESSAGE_VIDEO_NOT_CAPTURED: //0x113
+			if(_player_thumbnail_captured(handle, NULL, 0, 0, 0))
+				break;
 			LOGE("[%s] PLAYER_ERROR_VIDEO_CAPTURE_FAILED (0x%08x)",__FUNCTION__, PLAYER_ERROR_VIDEO_CAPTURE_FAILED);
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_ERROR] )
-			{
-				((player_error_cb)handle->user_cb[_PLAYER_EVENT_TYPE_ERROR])(PLAYER_ERROR_VIDEO_CAPTURE_FAILED,handle->user_data[_PLAYER_EVENT_TYPE_ERROR]);
-			}	
+			_player_post_event(handle, _PLAYER_EVENT_TYPE_ERROR, PLAYER_ERROR_VIDEO_CAPTURE_FAILED, 0, NULL, 0);
 			break;
 		case MM_MESSAGE_VIDEO_CAPTURED: //0x110
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE] )
+			if(_player_thumbnail_is_running(handle))
+			{
+				int w = 0;
+				int h = 0;
+				MMPlayerVideoCapture* capture = (MMPlayerVideoCapture *)msg->data;
+				mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_VIDEO_WIDTH ,&w,  MM_PLAYER_VIDEO_HEIGHT, &h, (char*)NULL);
+				_player_thumbnail_captured(handle, capture->data, w, h, capture->size);
+				if (capture->data)
+				{
+					g_free(capture->data);
+					capture->data = NULL;
+				}
+				break;
+			}
+			if( _player_has_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE) )
 			{
 				int w;
 				int h;
-				int ret = mm_player_get_attribute(handle->mm_handle, NULL,MM_PLAYER_VIDEO_WIDTH ,&w,  MM_PLAYER_VIDEO_HEIGHT, &h, (char*)NULL);
-				if(ret != MM_ERROR_NONE && handle->user_cb[_PLAYER_EVENT_TYPE_ERROR] )
+				int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_VIDEO_WIDTH ,&w,  MM_PLAYER_VIDEO_HEIGHT, &h, (char*)NULL);
+				if(ret != MM_ERROR_NONE && _player_has_user_cb(handle, _PLAYER_EVENT_TYPE_ERROR) )
 				{
 					LOGE("[%s] PLAYER_ERROR_VIDEO_CAPTURE_FAILED (0x%08x) : Failed to get video size on video captured (0x%x)" ,__FUNCTION__, PLAYER_ERROR_VIDEO_CAPTURE_FAILED, ret);
 					err_code=PLAYER_ERROR_VIDEO_CAPTURE_FAILED;
@@ -329,7 +712,7 @@ static int __msg_callback(int message, void *param, void *user_data)
 				else
 				{
 					MMPlayerVideoCapture* capture = (MMPlayerVideoCapture *)msg->data;
-					((player_video_captured_cb)handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE])(capture->data, w, h, capture->size, handle->user_data[_PLAYER_EVENT_TYPE_CAPTURE]);
+					_player_post_event(handle, _PLAYER_EVENT_TYPE_CAPTURE, w, h, capture->data, capture->size);
 
 					if (capture->data)
 					{
@@ -337,8 +720,7 @@ static int __msg_callback(int message, void *param, void *user_data)
 						capture->data = NULL;
 					}
 				}
-				handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
-				handle->user_data[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
+				_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE, NULL, NULL);
 			}	
 			break;	
 		case MM_MESSAGE_FILE_NOT_SUPPORTED: //0x10f
@@ -354,12 +736,19 @@ static int __msg_callback(int message, void *param, void *user_data)
 			err_code = PLAYER_ERROR_NOT_SUPPORTED_FILE;
 			break;
 		case MM_MESSAGE_SEEK_COMPLETED: //0x114
-			if( handle->user_cb[_PLAYER_EVENT_TYPE_SEEK])
+			__position_invalidate(handle);
+			if(_player_thumbnail_seek_completed(handle))
+				break;
+			_player_stats_record(&handle->stats.seek, &handle->stats_seek_start);
+			seek_with_position = __seek_get_completed(handle, &seek_generation, &seek_cb, &seek_user_data);
+			if(seek_cb || _player_wants_event(handle, _PLAYER_EVENT_TYPE_SEEK))
 			{
-				((player_seek_completed_cb)handle->user_cb[_PLAYER_EVENT_TYPE_SEEK])(handle->user_data[_PLAYER_EVENT_TYPE_SEEK]);
-				handle->user_cb[_PLAYER_EVENT_TYPE_SEEK] = NULL;
-				handle->user_data[_PLAYER_EVENT_TYPE_SEEK] = NULL;
+				int pos = 0;
+				if(seek_with_position && mm_player_get_position(_player_get_mm_handle(handle), MM_PLAYER_POS_FORMAT_TIME, &pos) != MM_ERROR_NONE)
+					LOGW("[%s] Failed to get the position reached by the seek", __FUNCTION__);
+				_player_post_callback(handle, _PLAYER_EVENT_TYPE_SEEK, seek_cb, seek_user_data, pos, seek_with_position, NULL, 0);
 			}
+			__seek_issue_pending(handle, seek_generation);
 			break;
 		case MM_MESSAGE_UNKNOWN: //0x00
 		case MM_MESSAGE_WARNING: //0x02
@@ -377,95 +766,675 @@ static int __msg_callback(int message, void *param, void *user_data)
 			break;
 	}
 
-	if(err_code != PLAYER_ERROR_NONE && handle->user_cb[_PLAYER_EVENT_TYPE_ERROR])
+	if(err_code != PLAYER_ERROR_NONE)
 	{
-		((player_error_cb)handle->user_cb[_PLAYER_EVENT_TYPE_ERROR])(err_code,handle->user_data[_PLAYER_EVENT_TYPE_ERROR]);
+		_player_stats_error(handle, err_code);
+		_player_post_event(handle, _PLAYER_EVENT_TYPE_ERROR, err_code, 0, NULL, 0);
 	}
-	LOGE("[%s] End", __FUNCTION__);
+	PLAYER_TRACE("[%s] End", __FUNCTION__);
 	return 1;
 }
 
+static player_video_frame_format_e __convert_pixel_format(int format)
+{
+	switch(format)
+	{
+		case MM_PIXEL_FORMAT_I420:
+			return PLAYER_VIDEO_FRAME_FORMAT_I420;
+		case MM_PIXEL_FORMAT_RGB565:
+			return PLAYER_VIDEO_FRAME_FORMAT_RGB565;
+		case MM_PIXEL_FORMAT_ARGB:
+			return PLAYER_VIDEO_FRAME_FORMAT_ARGB8888;
+		default:
+			// NV12, YUYV and the others have no player_video_frame_format_e
+			return PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN;
+	}
+}
+
+/* Forgets the format of the video stream, the next frame asks the pipeline again */
+static void __video_stream_invalidate(player_s *handle)
+{
+	__atomic_store_n(&handle->video_stream_width, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->video_frame_anchor_time, 0, __ATOMIC_RELAXED);
+}
+
+/*
+* The video stream callback carries no format, it is the one of the caps the pipeline
+* negotiated for the stream, which it reports through an attribute. The attribute is
+* only read again when the resolution or the size of the frames changes, as it does
+* when the caps are negotiated again.
+*/
+static player_video_frame_format_e __video_stream_format(player_s *handle, int width, int height, unsigned int size)
+{
+	if(__atomic_load_n(&handle->video_stream_width, __ATOMIC_RELAXED) == width && __atomic_load_n(&handle->video_stream_height, __ATOMIC_RELAXED) == height
+		&& __atomic_load_n(&handle->video_stream_size, __ATOMIC_RELAXED) == size)
+		return __atomic_load_n(&handle->video_stream_format, __ATOMIC_RELAXED);
+
+	int format = MM_PIXEL_FORMAT_INVALID;
+	if(mm_player_get_attribute(_player_get_mm_handle(handle), NULL, "video_stream_format", &format, (char*)NULL) != MM_ERROR_NONE)
+		LOGW("[%s] The pipeline does not report the format of the video stream", __FUNCTION__);
+	player_video_frame_format_e converted = __convert_pixel_format(format);
+	__atomic_store_n(&handle->video_stream_format, converted, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->video_stream_height, height, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->video_stream_size, size, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->video_stream_width, width, __ATOMIC_RELAXED);
+	return converted;
+}
+
+/*
+* The timestamp of a decoded frame : the interpolated position when it is enabled, otherwise
+* the position queried at most every _PLAYER_VIDEO_FRAME_RESYNC_INTERVAL and extrapolated in
+* between. Only the streaming thread uses the frame anchor.
+*/
+static int __video_frame_timestamp(player_s *handle)
+{
+	int timestamp = 0;
+	float rate;
+
+	if(__position_extrapolate(handle, &timestamp))
+		return timestamp;
+
+	unsigned int generation = __atomic_load_n(&handle->position_generation, __ATOMIC_ACQUIRE);
+	int64_t anchor_time = __atomic_load_n(&handle->video_frame_anchor_time, __ATOMIC_RELAXED);
+	int64_t now = __get_monotonic_ms();
+	if(anchor_time != 0 && now - anchor_time < _PLAYER_VIDEO_FRAME_RESYNC_INTERVAL && __atomic_load_n(&handle->video_frame_anchor_generation, __ATOMIC_RELAXED) == generation)
+	{
+		__atomic_load(&handle->playback_rate, &rate, __ATOMIC_RELAXED);
+		int64_t pos = __atomic_load_n(&handle->video_frame_anchor, __ATOMIC_RELAXED) + (int64_t)((now - anchor_time) * rate);
+		return pos > 0 ? (int)pos : 0;
+	}
+
+	if(mm_player_get_position(_player_get_mm_handle(handle), MM_PLAYER_POS_FORMAT_TIME, &timestamp) != MM_ERROR_NONE)
+		return 0;
+	__atomic_store_n(&handle->video_frame_anchor, timestamp, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->video_frame_anchor_generation, generation, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->video_frame_anchor_time, now, __ATOMIC_RELAXED);
+	return timestamp;
+}
+
 static bool  __video_stream_callback(void *stream, int stream_size, void *user_data, int width, int height)
 {
 	player_s * handle = (player_s*)user_data;
-	if( handle->user_cb[_PLAYER_EVENT_TYPE_VIDEO_FRAME])
+	PLAYER_MM_GUARD(handle);
+	PLAYER_PROBE3(video_frame, width, height, stream_size);
+	if(_player_thumbnail_frame(handle, stream, width, height, stream_size, __video_stream_format(handle, width, height, stream_size)))
+		return TRUE;
+	void *cb_data = NULL;
+	player_video_frame_decoded_cb decoded_cb = (player_video_frame_decoded_cb)_player_get_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME, &cb_data);
+	if(decoded_cb)
+	{
+		if(_player_get_state(handle)==PLAYER_STATE_PLAYING)
+			decoded_cb((unsigned char *)stream, width, height, stream_size, cb_data);
+		else
+			PLAYER_TRACE("[%s] Skip stream - current state : %d", __FUNCTION__,_player_get_state(handle));
+	}	
+	player_video_frame_cb frame_cb = (player_video_frame_cb)_player_get_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF, &cb_data);
+	_player_frame_pool_s *pool = __atomic_load_n(&handle->frame_pool, __ATOMIC_ACQUIRE);
+	if(frame_cb && pool)
 	{
-		if(handle->state==PLAYER_STATE_PLAYING)
-			((player_video_frame_decoded_cb)handle->user_cb[_PLAYER_EVENT_TYPE_VIDEO_FRAME])((unsigned char *)stream, width, height, stream_size, handle->user_data[_PLAYER_EVENT_TYPE_VIDEO_FRAME]);
+		if(_player_get_state(handle)==PLAYER_STATE_PLAYING)
+		{
+			player_video_frame_h frame = _player_frame_pool_get(pool, stream, stream_size, width, height, __video_stream_format(handle, width, height, stream_size), __video_frame_timestamp(handle));
+			if(frame)
+			{
+				frame_cb(frame, cb_data);
+				player_video_frame_unref(frame);
+			}
+			else
+				PLAYER_TRACE("[%s] Drop frame - every frame is held by the application", __FUNCTION__);
+		}
+		else
+			PLAYER_TRACE("[%s] Skip stream - current state : %d", __FUNCTION__,_player_get_state(handle));
+	}
+	return TRUE;
+}
+
+static bool  __audio_stream_callback(void *stream, int stream_size, void *user_data)
+{
+	player_s * handle = (player_s*)user_data;
+	PLAYER_MM_GUARD(handle);
+	PLAYER_PROBE1(audio_frame, stream_size);
+	void *cb_data = NULL;
+	player_audio_frame_decoded_cb decoded_cb = (player_audio_frame_decoded_cb)_player_get_user_cb(handle, _PLAYER_EVENT_TYPE_AUDIO_FRAME, &cb_data);
+	if(decoded_cb)
+	{
+		if(_player_get_state(handle)==PLAYER_STATE_PLAYING)
+			decoded_cb((unsigned char *)stream, stream_size, cb_data);
 		else
-			LOGE("[%s] Skip stream - current state : %d", __FUNCTION__,handle->state);
+			PLAYER_TRACE("[%s] Skip stream - current state : %d", __FUNCTION__,_player_get_state(handle));
 	}	
+	// the streaming thread is the only writer, player_get_decoding_speed() reads them on any thread
+	int64_t now = __get_monotonic_ms();
+	if(__atomic_load_n(&handle->pcm_decoded_bytes, __ATOMIC_RELAXED) == 0)
+		__atomic_store_n(&handle->pcm_first_time, now, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->pcm_last_time, now, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&handle->pcm_decoded_bytes, stream_size, __ATOMIC_RELEASE);
+	_player_pcm_ring_s *ring = __pcm_ring_get(handle);
+	if(ring)
+	{
+		_player_pcm_ring_write(ring, stream, stream_size);
+		_player_pcm_ring_unref(ring);
+	}
+	return TRUE;
+}
+
+static int __pd_message_callback(int message, void *param, void *user_data)
+{
+	player_s * handle = (player_s*)user_data;
+	player_pd_message_type_e type;
+	switch(message)
+	{
+		case MM_MESSAGE_PD_DOWNLOADER_START:
+			type = PLAYER_PD_STARTED;
+			break;
+		case MM_MESSAGE_PD_DOWNLOADER_END:
+			type = PLAYER_PD_COMPLETED;
+			break;
+		default:
+			return 0;
+	}
+
+	_player_post_event(handle, _PLAYER_EVENT_TYPE_PD, type, 0, NULL, 0);
+	return 0;
+}
+
+static bool __supported_audio_effect_type (int  filter, int type, void *user_data)
+{
+	player_s * handle = (player_s*)user_data;
+	if(filter != MM_AUDIO_FILTER_TYPE_CUSTOM || type == MM_AUDIO_FILTER_CUSTOM_EQ)
+	{
+		PLAYER_INFO("[%s] Skip invalid filter: %d or type : %d",__FUNCTION__, filter, type);
+		return TRUE;
+	}
+
+	void *cb_data = NULL;
+	player_audio_effect_supported_effect_cb callback = (player_audio_effect_supported_effect_cb)_player_get_user_cb(handle, _PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE, &cb_data);
+	if(callback)
+	{
+		return callback(type, cb_data);
+	}
+	return FALSE;
+}
+
+static bool __supported_audio_effect_preset (int  filter, int type, void *user_data)
+{
+	player_s * handle = (player_s*)user_data;
+	if(filter != MM_AUDIO_FILTER_TYPE_PRESET)
+	{
+		PLAYER_INFO("[%s] Skip invalid filter: %d or type : %d",__FUNCTION__, filter, type);
+		return TRUE;
+	}
+
+	void *cb_data = NULL;
+	player_audio_effect_supported_effect_cb callback = (player_audio_effect_supported_effect_cb)_player_get_user_cb(handle, _PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET, &cb_data);
+	if(callback)
+	{
+		return callback(type, cb_data);
+	}
+	return FALSE;
+}
+
+static int __next_msg_callback(int message, void *param, void *user_data)
+{
+	player_s * handle = (player_s*)user_data;
+	MMMessageParamType *msg = (MMMessageParamType*)param;
+	switch(message)
+	{
+		case MM_MESSAGE_STATE_CHANGED:
+			if(msg->state.previous == MM_PLAYER_STATE_READY && msg->state.current == MM_PLAYER_STATE_PAUSED)
+			{
+				PLAYER_INFO("[%s] Next source has been prerolled", __FUNCTION__);
+				__atomic_store_n(&handle->is_next_prepared, TRUE, __ATOMIC_RELEASE);
+			}
+			break;
+		case MM_MESSAGE_ERROR:
+		case MM_MESSAGE_FILE_NOT_SUPPORTED:
+		case MM_MESSAGE_FILE_NOT_FOUND:
+		case MM_MESSAGE_DRM_NOT_AUTHORIZED:
+			LOGE("[%s] Failed to preroll the next source (message : 0x%x), playback will complete normally", __FUNCTION__, message);
+			__atomic_store_n(&handle->is_next_prepared, FALSE, __ATOMIC_RELEASE);
+			break;
+		default:
+			break;
+	}
+	return 1;
+}
+
+static void* __release_mm_handle(void *data)
+{
+	MMHandleType mm_handle = (MMHandleType)(uintptr_t)data;
+	mm_player_unrealize(mm_handle);
+	mm_player_destroy(mm_handle);
+	return NULL;
+}
+
+
+#define _PLAYER_METADATA_DURATION	0x01
+#define _PLAYER_METADATA_VIDEO_SIZE	0x02
+#define _PLAYER_METADATA_TAGS		0x04
+
+/*
+* The metadata cache is shared by the getters, which may run on any thread, and is
+* only touched under metadata_lock. The lock is held across the query of a miss, the
+* attribute getters of mm-player never call back.
+*/
+static void __metadata_clear(player_s *handle)
+{
+	int i;
+
+	handle->metadata_valid = 0;
+	for(i = 0; i < _PLAYER_METADATA_TAG_NUM; i++)
+	{
+		free(handle->metadata_tags[i]);
+		handle->metadata_tags[i] = NULL;
+	}
+}
+
+static void __metadata_invalidate(player_s *handle)
+{
+	pthread_mutex_lock(&handle->metadata_lock);
+	__metadata_clear(handle);
+	pthread_mutex_unlock(&handle->metadata_lock);
+}
+
+/*
+* Called with metadata_lock held. The gapless switch changes the source on the message
+* thread, it only bumps metadata_source and the cache is dropped by the next getter.
+*/
+static bool __metadata_lookup(player_s *handle, unsigned int item)
+{
+	unsigned int source = __atomic_load_n(&handle->metadata_source, __ATOMIC_ACQUIRE);
+
+	if(handle->metadata_cached_source != source)
+	{
+		__metadata_clear(handle);
+		handle->metadata_cached_source = source;
+	}
+	if(handle->metadata_valid & item)
+	{
+		__atomic_add_fetch(&handle->metadata_hits, 1, __ATOMIC_RELAXED);
+		return TRUE;
+	}
+	__atomic_add_fetch(&handle->metadata_misses, 1, __ATOMIC_RELAXED);
+	return FALSE;
+}
+
+/* Called with metadata_lock held, a value queried before a switch of source is not kept */
+static void __metadata_set_valid(player_s *handle, unsigned int item)
+{
+	if(handle->metadata_cached_source == __atomic_load_n(&handle->metadata_source, __ATOMIC_ACQUIRE))
+		handle->metadata_valid |= item;
+}
+
+static bool __push_need_data_callback(unsigned int size, void *user_data)
+{
+	player_s * handle = (player_s*)user_data;
+	_player_post_event(handle, _PLAYER_EVENT_TYPE_PUSH_NEED_DATA, size, 0, NULL, 0);
+	return TRUE;
+}
+
+static bool __push_enough_data_callback(void *user_data)
+{
+	player_s * handle = (player_s*)user_data;
+	_player_post_event(handle, _PLAYER_EVENT_TYPE_PUSH_ENOUGH_DATA, 0, 0, NULL, 0);
 	return TRUE;
 }
 
-static bool  __audio_stream_callback(void *stream, int stream_size, void *user_data)
+static void __push_source_release(player_s *handle)
+{
+	if(!handle->is_push_source)
+		return;
+	mm_player_set_buffer_need_data_callback(_player_get_mm_handle(handle), NULL, NULL);
+	mm_player_set_buffer_enough_data_callback(_player_get_mm_handle(handle), NULL, NULL);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PUSH_NEED_DATA, NULL, NULL);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PUSH_ENOUGH_DATA, NULL, NULL);
+	handle->is_push_source = FALSE;
+}
+
+/*
+* The int attributes this API sets on the pipeline, with their value in a new pipeline.
+* _player_reset() restores them, and the next source follows the current one on
+* those marked to follow. The display surface and the volume are handled apart.
+*/
+typedef struct {
+	const char *name;
+	int value;
+	bool follow;
+} _player_attribute_s;
+
+static const _player_attribute_s __api_attributes[] = {
+	{ "display_surface_use_multi", 0, TRUE },
+	// the next source stays hidden until the switch, which shows it as the current one
+	{ "display_visible", 1, FALSE },
+	{ "display_method", PLAYER_DISPLAY_MODE_LETTER_BOX, TRUE },
+	{ "display_zoom", 1, TRUE },
+	{ "display_evas_do_scaling", 1, TRUE },
+	{ MM_PLAYER_VIDEO_ROTATION, PLAYER_DISPLAY_ROTATION_NONE, TRUE },
+	{ MM_PLAYER_PLAYBACK_COUNT, 0, TRUE },
+	{ "sound_volume_type", SOUND_TYPE_MEDIA, TRUE },
+	{ "pcm_extraction", FALSE, TRUE },
+	{ "pcm_extraction_start_msec", 0, TRUE },
+	{ "pcm_extraction_end_msec", 0, TRUE },
+	// the progressive download belongs to the uri of the current source
+	{ "pd_mode", MM_PLAYER_PD_MODE_NONE, FALSE },
+	{ "subtitle_silent", 1, TRUE },
+	{ "accurate_seek", FALSE, TRUE },
+};
+
+#define _PLAYER_API_ATTRIBUTE_NUM	(int)(sizeof(__api_attributes) / sizeof(__api_attributes[0]))
+
+static bool __wants_video_stream(player_s *handle)
+{
+	return _player_has_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME) || _player_has_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF);
+}
+
+static bool __wants_audio_stream(player_s *handle)
+{
+	return _player_has_user_cb(handle, _PLAYER_EVENT_TYPE_AUDIO_FRAME) || __atomic_load_n(&handle->pcm_ring, __ATOMIC_ACQUIRE);
+}
+
+/* Sets the callbacks of the handle on @a mm_handle, or clears them */
+static void __set_stream_callbacks(player_s *handle, MMHandleType mm_handle, bool set)
+{
+	mm_player_set_message_callback(mm_handle, set ? __msg_callback : NULL, set ? (void*)handle : NULL);
+	mm_player_set_video_stream_callback(mm_handle, set && __wants_video_stream(handle) ? __video_stream_callback : NULL, set ? (void*)handle : NULL);
+	mm_player_set_audio_stream_callback(mm_handle, set && __wants_audio_stream(handle) ? __audio_stream_callback : NULL, set ? (void*)handle : NULL);
+}
+
+/* The previous source of a switch, see PLAYER_MM_GUARD() */
+typedef struct {
+	player_s *handle;
+	MMHandleType mm_handle;
+	int slot;
+	pthread_t previous;
+	bool joinable;
+} _player_release_s;
+
+static void* __release_previous_source(void *data)
+{
+	_player_release_s *release = (_player_release_s*)data;
+
+	// a call counted before the last switches may still use this pipeline as well
+	if(release->joinable)
+		pthread_join(release->previous, NULL);
+	while(__atomic_load_n(&release->handle->mm_users[release->slot], __ATOMIC_ACQUIRE) > 0)
+		usleep(1000);
+	__release_mm_handle((void*)(uintptr_t)release->mm_handle);
+	free(release);
+	return NULL;
+}
+
+/* Joins the thread which releases the previous source of the last switch, and so of all the switches */
+static void __release_thread_join(player_s *handle)
+{
+	pthread_mutex_lock(&handle->next_lock);
+	bool joinable = handle->release_joinable;
+	pthread_t thread = handle->release_thread;
+	handle->release_joinable = FALSE;
+	pthread_mutex_unlock(&handle->next_lock);
+	if(joinable)
+		pthread_join(thread, NULL);
+}
+
+/*
+* next_mm_handle is taken under next_lock, so that the switch on the message thread
+* and player_unset_next_source() never both own the next source.
+*/
+static void __release_next_source(player_s *handle)
+{
+	pthread_mutex_lock(&handle->next_lock);
+	MMHandleType next = handle->next_mm_handle;
+	handle->next_mm_handle = 0;
+	__atomic_store_n(&handle->is_next_prepared, FALSE, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&handle->next_lock);
+
+	if(next)
+		__release_mm_handle((void*)(uintptr_t)next);
+}
+
+/* Waits for the previous sources of the switches, the caller must not hold PLAYER_MM_GUARD() */
+static void __release_previous_sources(player_s *handle)
 {
-	player_s * handle = (player_s*)user_data;
-	if( handle->user_cb[_PLAYER_EVENT_TYPE_AUDIO_FRAME] )
-	{
-		if(handle->state==PLAYER_STATE_PLAYING)
-			((player_audio_frame_decoded_cb)handle->user_cb[_PLAYER_EVENT_TYPE_AUDIO_FRAME])((unsigned char *)stream, stream_size, handle->user_data[_PLAYER_EVENT_TYPE_AUDIO_FRAME]);
-		else
-			LOGE("[%s] Skip stream - current state : %d", __FUNCTION__,handle->state);
-	}	
-	return TRUE;
+	__release_thread_join(handle);
+	pthread_mutex_lock(&handle->next_lock);
+	MMHandleType retired = handle->retired_mm_handle;
+	handle->retired_mm_handle = 0;
+	pthread_mutex_unlock(&handle->next_lock);
+	if(retired)
+		__release_mm_handle((void*)(uintptr_t)retired);
 }
 
-static int __pd_message_callback(int message, void *param, void *user_data)
+static int __prepare_next_source(player_s *handle, const char *uri, const void *data, int size)
 {
-	player_s * handle = (player_s*)user_data;
-	player_pd_message_type_e type;
-	switch(message)
+	MMHandleType current = _player_get_mm_handle(handle);
+	MMHandleType next;
+	MMPlayerVolumeType vol;
+	int mute = 0;
+	int ret;
+	int i;
+
+	__release_next_source(handle);
+
+	ret = mm_player_create(&next);
+	if(ret != MM_ERROR_NONE)
+		return __convert_error_code(ret,"__prepare_next_source");
+
+	if(data)
+		ret = mm_player_set_attribute(next, NULL, MM_PLAYER_CONTENT_URI, uri, strlen(uri), MM_PLAYER_MEMORY_SRC, data, size, (char*)NULL);
+	else
+		ret = mm_player_set_attribute(next, NULL, MM_PLAYER_CONTENT_URI, uri, strlen(uri), (char*)NULL);
+
+	if(ret == MM_ERROR_NONE)
 	{
-		case MM_MESSAGE_PD_DOWNLOADER_START:
-			type = PLAYER_PD_STARTED;
-			break;
-		case MM_MESSAGE_PD_DOWNLOADER_END:
-			type = PLAYER_PD_COMPLETED;
-			break;
-		default:
-			return 0;
+		// follow the current source : same output, kept hidden until the switch
+		if (handle->display_type == ((int)MM_DISPLAY_SURFACE_NULL))
+			ret = mm_player_set_attribute(next, NULL, "display_surface_type", MM_DISPLAY_SURFACE_NULL, (char*)NULL);
+		else
+			ret = mm_player_set_attribute(next, NULL, "display_surface_type", handle->display_type, "display_overlay", handle->display_type == PLAYER_DISPLAY_TYPE_X11 ? &handle->display_handle : handle->display_handle, sizeof(handle->display_handle), "display_visible", 0, (char*)NULL);
+	}
+	if(ret == MM_ERROR_NONE && handle->second_display_type != (int)MM_DISPLAY_SURFACE_NULL)
+		ret = mm_player_set_attribute(next, NULL, "display_overlay_ext", handle->second_display_type == PLAYER_DISPLAY_TYPE_X11 ? &handle->second_display_handle : handle->second_display_handle, sizeof(handle->second_display_handle), (char*)NULL);
+	for(i = 0; i < _PLAYER_API_ATTRIBUTE_NUM && ret == MM_ERROR_NONE; i++)
+	{
+		int value = __api_attributes[i].value;
+		if(__api_attributes[i].follow && mm_player_get_attribute(current, NULL, __api_attributes[i].name, &value, (char*)NULL) == MM_ERROR_NONE)
+			ret = mm_player_set_attribute(next, NULL, __api_attributes[i].name, value, (char*)NULL);
+	}
+	if(ret == MM_ERROR_NONE && mm_player_get_volume(current, &vol) == MM_ERROR_NONE)
+		mm_player_set_volume(next, &vol);
+	if(ret == MM_ERROR_NONE && mm_player_get_mute(current, &mute) == MM_ERROR_NONE)
+		mm_player_set_mute(next, mute);
+	if(ret == MM_ERROR_NONE)
+		ret = mm_player_set_message_callback(next, __next_msg_callback, (void*)handle);
+	if(ret == MM_ERROR_NONE)
+		ret = mm_player_set_attribute(next, NULL, "profile_async_start", 1, (char*)NULL);
+	if(ret == MM_ERROR_NONE)
+		ret = mm_player_realize(next);
+	if(ret == MM_ERROR_NONE)
+	{
+		// preroll in the background, __next_msg_callback() tells when it is done
+		ret = mm_player_pause(next);
+		if(ret != MM_ERROR_NONE)
+			mm_player_unrealize(next);
 	}
 
-	if( handle->user_cb[_PLAYER_EVENT_TYPE_PD] )
+	if(ret != MM_ERROR_NONE)
 	{
-		((player_pd_message_cb)handle->user_cb[_PLAYER_EVENT_TYPE_PD])(type, handle->user_data[_PLAYER_EVENT_TYPE_PD]);
+		mm_player_destroy(next);
+		return __convert_error_code(ret,"__prepare_next_source");
 	}
-	return 0;
+	pthread_mutex_lock(&handle->next_lock);
+	handle->next_mm_handle = next;
+	pthread_mutex_unlock(&handle->next_lock);
+	return PLAYER_ERROR_NONE;
 }
 
-static bool __supported_audio_effect_type (int  filter, int type, void *user_data)
+static int __switch_to_next_source(player_s *handle)
 {
-	player_s * handle = (player_s*)user_data;
-	if(filter != MM_AUDIO_FILTER_TYPE_CUSTOM || type == MM_AUDIO_FILTER_CUSTOM_EQ)
+	MMHandleType prev = _player_get_mm_handle(handle);
+	int visible = 1;
+
+	pthread_mutex_lock(&handle->next_lock);
+	MMHandleType next = handle->next_mm_handle;
+	handle->next_mm_handle = 0;
+	pthread_mutex_unlock(&handle->next_lock);
+	if(next == 0)
+		return PLAYER_ERROR_INVALID_OPERATION;
+
+	// the frames and messages of prev must not reach the application once next took over
+	__set_stream_callbacks(handle, prev, FALSE);
+	__set_stream_callbacks(handle, next, TRUE);
+	if(handle->display_type == PLAYER_DISPLAY_TYPE_X11 || handle->display_type == PLAYER_DISPLAY_TYPE_EVAS)
 	{
-		LOGI("[%s] Skip invalid filter: %d or type : %d",__FUNCTION__, filter, type);
-		return TRUE;
+		mm_player_get_attribute(prev, NULL, "display_visible", &visible, (char*)NULL);
+		mm_player_set_attribute(prev, NULL, "display_visible", 0, (char*)NULL);
+		mm_player_set_attribute(next, NULL, "display_visible", visible, (char*)NULL);
 	}
+	int ret = mm_player_resume(next);
+	if(ret != MM_ERROR_NONE)
+	{
+		LOGE("[%s] Failed to resume the next source (0x%x)", __FUNCTION__, ret);
+		__set_stream_callbacks(handle, next, FALSE);
+		__set_stream_callbacks(handle, prev, TRUE);
+		if(handle->display_type == PLAYER_DISPLAY_TYPE_X11 || handle->display_type == PLAYER_DISPLAY_TYPE_EVAS)
+			mm_player_set_attribute(prev, NULL, "display_visible", visible, (char*)NULL);
+		mm_player_set_message_callback(next, __next_msg_callback, (void*)handle);
+		__atomic_store_n(&handle->is_next_prepared, FALSE, __ATOMIC_RELEASE);
+		pthread_mutex_lock(&handle->next_lock);
+		if(handle->next_mm_handle == 0)
+		{
+			handle->next_mm_handle = next;
+			next = 0;
+		}
+		pthread_mutex_unlock(&handle->next_lock);
+		// replaced meanwhile by another next source
+		if(next)
+			__release_mm_handle((void*)(uintptr_t)next);
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	}
+
+	__atomic_store_n(&handle->mm_handle, next, __ATOMIC_SEQ_CST);
+	unsigned int epoch = __atomic_fetch_add(&handle->mm_epoch, 1, __ATOMIC_SEQ_CST);
+	__atomic_store_n(&handle->is_next_prepared, FALSE, __ATOMIC_RELEASE);
+	handle->is_stopped = FALSE;
+	__atomic_add_fetch(&handle->metadata_source, 1, __ATOMIC_RELEASE);
+	__position_invalidate(handle);
+	__video_stream_invalidate(handle);
+	PLAYER_INFO("[%s] Switched to the next source", __FUNCTION__);
 
-	if( handle->user_cb[_PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE] )
+	// we are on the message thread of the previous pipeline, it can't be unrealized from here
+	_player_release_s *release = (_player_release_s*)malloc(sizeof(_player_release_s));
+	pthread_t thread;
+	pthread_mutex_lock(&handle->next_lock);
+	if(release)
 	{
-		return ((player_audio_effect_supported_effect_cb)handle->user_cb[_PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE])(type, handle->user_data[_PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE]);
+		release->handle = handle;
+		release->mm_handle = prev;
+		release->slot = epoch & 1;
+		release->previous = handle->release_thread;
+		release->joinable = handle->release_joinable;
 	}
-	return FALSE;
+	if(release && pthread_create(&thread, NULL, __release_previous_source, release) == 0)
+	{
+		handle->release_thread = thread;
+		handle->release_joinable = TRUE;
+	}
+	else
+	{
+		free(release);
+		LOGW("[%s] Failed to create the release thread, the previous source will be released later", __FUNCTION__);
+		if(handle->retired_mm_handle)
+			LOGE("[%s] Previous source is already waiting for release, leaking it", __FUNCTION__);
+		handle->retired_mm_handle = prev;
+	}
+	pthread_mutex_unlock(&handle->next_lock);
+	return PLAYER_ERROR_NONE;
 }
 
-static bool __supported_audio_effect_preset (int  filter, int type, void *user_data)
+int _player_reset(player_h player)
 {
-	player_s * handle = (player_s*)user_data;
-	if(filter != MM_AUDIO_FILTER_TYPE_PRESET)
-	{
-		LOGI("[%s] Skip invalid filter: %d or type : %d",__FUNCTION__, filter, type);
-		return TRUE;
-	}
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	int ret;
+	int i;
 
-	if( handle->user_cb[_PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET] )
+	_player_thumbnail_stop(handle);
+	__pcm_ring_release(handle);
+	if (__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		return ((player_audio_effect_supported_effect_cb)handle->user_cb[_PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET])(type, handle->user_data[_PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET]);
+		ret = mm_player_unrealize(_player_get_mm_handle(handle));
+		if(ret != MM_ERROR_NONE)
+			return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
-	return FALSE;
-}
+	__release_next_source(handle);
+	__release_previous_sources(handle);
+
+	mm_player_set_message_callback(_player_get_mm_handle(handle), NULL, NULL);
+	mm_player_set_video_stream_callback(_player_get_mm_handle(handle), NULL, NULL);
+	mm_player_set_audio_stream_callback(_player_get_mm_handle(handle), NULL, NULL);
+	mm_player_set_pd_message_callback(_player_get_mm_handle(handle), NULL, NULL);
+	_player_dispatcher_release(handle);
+	_player_frame_pool_release(handle->frame_pool);
+	handle->frame_pool = NULL;
+	__video_stream_invalidate(handle);
+	__atomic_store_n(&handle->pcm_bytes_per_sec, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->pcm_decoded_bytes, 0, __ATOMIC_RELAXED);
+	mm_player_set_pcm_extraction_mode(_player_get_mm_handle(handle), TRUE);
+	for(i = 0; i < _PLAYER_EVENT_TYPE_NUM; i++)
+		_player_set_user_cb(handle, i, NULL, NULL);
+	_player_listener_clear(handle);
+
+	// restore the attributes which can be changed through this API
+	ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,
+		"display_surface_type", MM_DISPLAY_SURFACE_NULL,
+		"display_overlay_ext", NULL, 0,
+		"streaming_cookie", "", 0,
+		"subtitle_uri", "", 0,
+		"pd_location", "", 0,
+		(char*)NULL);
+	for(i = 0; i < _PLAYER_API_ATTRIBUTE_NUM && ret == MM_ERROR_NONE; i++)
+		ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, __api_attributes[i].name, __api_attributes[i].value, (char*)NULL);
+	if(ret != MM_ERROR_NONE)
+		return __convert_error_code(ret,(char*)__FUNCTION__);
 
+	MMPlayerVolumeType vol;
+	vol.level[MM_VOLUME_CHANNEL_LEFT] = 1.0;
+	vol.level[MM_VOLUME_CHANNEL_RIGHT] = 1.0;
+	mm_player_set_volume(_player_get_mm_handle(handle), &vol);
+	mm_player_set_mute(_player_get_mm_handle(handle), 0);
+	// the filters are kept by the pipeline, they only apply while it is realized
+	if(mm_player_sound_filter_custom_clear_ext_all(_player_get_mm_handle(handle)) != MM_ERROR_NONE || mm_player_sound_filter_custom_clear_eq_all(_player_get_mm_handle(handle)) != MM_ERROR_NONE)
+		LOGW("[%s] Failed to clear the audio effects", __FUNCTION__);
+
+	handle->display_handle = NULL;
+	handle->second_display_handle = NULL;
+	handle->display_type = MM_DISPLAY_SURFACE_NULL; // means DISPLAY_TYPE_NONE(3)
+	handle->second_display_type = MM_DISPLAY_SURFACE_NULL;
+	handle->is_stopped = FALSE;
+	handle->pcm_start = 0;
+	__atomic_store_n(&handle->buffering_min_interval, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->buffering_min_delta, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->buffering_last_percent, -1, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->buffering_delivered, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->buffering_coalesced, 0, __ATOMIC_RELAXED);
+	__metadata_invalidate(handle);
+	handle->metadata_hits = 0;
+	handle->metadata_misses = 0;
+	handle->playback_rate = 1.0;
+	handle->position_resync_interval = 0;
+	handle->position_at_end = 0;
+	__position_invalidate(handle);
+	__seek_reset(handle);
+	pthread_mutex_lock(&handle->seek_lock);
+	handle->scrubbing = FALSE;
+	pthread_mutex_unlock(&handle->seek_lock);
+	__mmap_release(handle);
+	__push_source_release(handle);
+	_player_stats_reset(handle);
+	handle->seek_accurate = FALSE;
+	_player_set_state(handle, PLAYER_STATE_IDLE);
+	return PLAYER_ERROR_NONE;
+}
 
 /*
 * Public Implementation
@@ -473,7 +1442,8 @@ static bool __supported_audio_effect_preset (int  filter, int type, void *user_d
 
 int player_create (player_h *player)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	MMTA_INIT();
 	MMTA_ACUM_ITEM_BEGIN("[CAPI] player_create", 0);
@@ -486,12 +1456,13 @@ int player_create (player_h *player)
 		LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
 		return PLAYER_ERROR_OUT_OF_MEMORY;
 	}
+	int64_t begin = __get_monotonic_ms();
 	int ret = mm_player_create(&handle->mm_handle);
 	MMTA_ACUM_ITEM_END("[CAPI] player_create", 0);
 	if( ret != MM_ERROR_NONE)
 	{
 		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION);
-		handle->state = PLAYER_STATE_NONE;
+		_player_set_state(handle, PLAYER_STATE_NONE);
 		free(handle);
 		handle=NULL;
 		return PLAYER_ERROR_INVALID_OPERATION;
@@ -499,10 +1470,20 @@ int player_create (player_h *player)
 	else
 	{
 		*player = (player_h)handle;
-		handle->state = PLAYER_STATE_IDLE;
+		_player_set_state(handle, PLAYER_STATE_IDLE);
 		handle->display_type = MM_DISPLAY_SURFACE_NULL; // means DISPLAY_TYPE_NONE(3)
 		handle->second_display_type = MM_DISPLAY_SURFACE_NULL;
-		LOGE("[%s] End", __FUNCTION__);
+		handle->buffering_last_percent = -1;
+		handle->playback_rate = 1.0;
+		pthread_mutex_init(&handle->seek_lock, NULL);
+		pthread_mutex_init(&handle->listener_lock, NULL);
+		pthread_mutex_init(&handle->pcm_lock, NULL);
+		pthread_mutex_init(&handle->thumbnail_lock, NULL);
+		pthread_mutex_init(&handle->dispatch_lock, NULL);
+		pthread_mutex_init(&handle->next_lock, NULL);
+		pthread_mutex_init(&handle->metadata_lock, NULL);
+		_player_stats_record_value(&handle->stats.create, (unsigned int)(__get_monotonic_ms() - begin));
+		PLAYER_TRACE("[%s] End", __FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
@@ -510,48 +1491,64 @@ int player_create (player_h *player)
 
 int player_destroy (player_h player)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
 	MMTA_ACUM_ITEM_SHOW_RESULT_TO(MMTA_SHOW_FILE);
+	_player_thumbnail_stop(handle);
+	__pcm_ring_release(handle);
+	__release_next_source(handle);
+	__release_previous_sources(handle);
 
-	if (mm_player_destroy(handle->mm_handle)!= MM_ERROR_NONE)
+	if (mm_player_destroy(_player_get_mm_handle(handle))!= MM_ERROR_NONE)
 	{
 		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION);
 		return PLAYER_ERROR_INVALID_OPERATION;
 	}
 	else
 	{
-		handle->state = PLAYER_STATE_NONE;
+		_player_set_state(handle, PLAYER_STATE_NONE);
+		_player_dispatcher_release(handle);
+		_player_frame_pool_release(handle->frame_pool);
+		__metadata_invalidate(handle);
+		pthread_mutex_destroy(&handle->seek_lock);
+		pthread_mutex_destroy(&handle->listener_lock);
+		pthread_mutex_destroy(&handle->pcm_lock);
+		pthread_mutex_destroy(&handle->thumbnail_lock);
+		pthread_mutex_destroy(&handle->dispatch_lock);
+		pthread_mutex_destroy(&handle->next_lock);
+		pthread_mutex_destroy(&handle->metadata_lock);
+		__mmap_release(handle);
 		free(handle);
 		handle= NULL;
-		LOGE("[%s] End", __FUNCTION__);
+		PLAYER_TRACE("[%s] End", __FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int 	player_prepare_async (player_h player, player_prepared_cb callback, void* user_data)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
-	handle->is_prepare_sync=0;
 
-	if(handle->user_cb[_PLAYER_EVENT_TYPE_PREPARE])
+	if(_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_PREPARE))
 	{
 		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : preparing... we can't do any more " ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
 		return PLAYER_ERROR_INVALID_OPERATION;
 	}
 	else
 	{
-		LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_PREPARE);
-		handle->user_cb[_PLAYER_EVENT_TYPE_PREPARE] = callback;
-		handle->user_data[_PLAYER_EVENT_TYPE_PREPARE] = user_data;
+		PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_PREPARE);
+		_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PREPARE, callback, user_data);
 	}
 
 	int ret;
-	ret = mm_player_set_message_callback(handle->mm_handle, __msg_callback, (void*)handle);
+	ret = mm_player_set_message_callback(_player_get_mm_handle(handle), __msg_callback, (void*)handle);
 	if(ret != MM_ERROR_NONE)
 	{
 		LOGW("[%s] Failed to set message callback function (0x%x)" ,__FUNCTION__, ret);
@@ -559,7 +1556,7 @@ int 	player_prepare_async (player_h player, player_prepared_cb callback, void* u
 
 	if (handle->display_type==((int)MM_DISPLAY_SURFACE_NULL))
 	{
-		ret = mm_player_set_attribute(handle->mm_handle, NULL, "display_surface_type", MM_DISPLAY_SURFACE_NULL, (char*)NULL);
+		ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "display_surface_type", MM_DISPLAY_SURFACE_NULL, (char*)NULL);
 		if(ret != MM_ERROR_NONE)
 		{
 			LOGW("[%s] Failed to set display surface type 'MM_DISPLAY_SURFACE_NULL' (0x%x)" ,__FUNCTION__, ret);
@@ -567,41 +1564,50 @@ int 	player_prepare_async (player_h player, player_prepared_cb callback, void* u
 	}
 	else
 	{
-		mm_player_set_attribute(handle->mm_handle, NULL,"display_visible" , 0, (char*)NULL);
+		mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_visible" , 0, (char*)NULL);
 	}
 
-	ret = mm_player_set_attribute(handle->mm_handle, NULL, "profile_async_start", 1, (char*)NULL);
+	ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "profile_async_start", 1, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		LOGE("[%s] Failed to set profile_async_start '1' (0x%x)" ,__FUNCTION__, ret);
 	}
-	ret = mm_player_realize(handle->mm_handle);
-	mm_player_set_mute(handle->mm_handle, 1);
-	mm_player_start(handle->mm_handle);
-	LOGE("START on Prepare() Async!!!!!!");
+	MMTA_ACUM_ITEM_BEGIN("[CAPI] player_prepare", 0);
+	_player_stats_mark(&handle->stats_prepare_start);
+	ret = mm_player_realize(_player_get_mm_handle(handle));
+	if(ret == MM_ERROR_NONE)
+	{
+		// preroll only : player_prepared_cb() is invoked when the pipeline reaches PAUSED
+		ret = mm_player_pause(_player_get_mm_handle(handle));
+		if(ret != MM_ERROR_NONE)
+			mm_player_unrealize(_player_get_mm_handle(handle));
+	}
 
 	if(ret != MM_ERROR_NONE)
 	{
+		_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PREPARE, NULL, NULL);
+		handle->stats_prepare_start = 0;
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
-		LOGE("[%s] End", __FUNCTION__);
+		PLAYER_TRACE("[%s] End", __FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int 	player_prepare (player_h player)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	MMTA_ACUM_ITEM_BEGIN("[CAPI] player_prepare", 0);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
-	handle->is_prepare_sync=1;
 
 	int ret;
-	ret = mm_player_set_message_callback(handle->mm_handle, __msg_callback, (void*)handle);
+	ret = mm_player_set_message_callback(_player_get_mm_handle(handle), __msg_callback, (void*)handle);
 	if(ret != MM_ERROR_NONE)
 	{
 		LOGW("[%s] Failed to set message callback function (0x%x)" ,__FUNCTION__, ret);
@@ -609,7 +1615,7 @@ int 	player_prepare (player_h player)
 
 	if (handle->display_type==((int)MM_DISPLAY_SURFACE_NULL))
 	{
-		ret = mm_player_set_attribute(handle->mm_handle, NULL, "display_surface_type", MM_DISPLAY_SURFACE_NULL, (char*)NULL);
+		ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "display_surface_type", MM_DISPLAY_SURFACE_NULL, (char*)NULL);
 		if(ret != MM_ERROR_NONE)
 		{
 			LOGW("[%s] Failed to set display surface type 'MM_DISPLAY_SURFACE_NULL' (0x%x)" ,__FUNCTION__, ret);
@@ -617,70 +1623,93 @@ int 	player_prepare (player_h player)
 	}
 	else
 	{
-		mm_player_set_attribute(handle->mm_handle, NULL,"display_visible" , 0, (char*)NULL);
+		mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_visible" , 0, (char*)NULL);
 	}
 
-	ret = mm_player_set_attribute(handle->mm_handle, NULL, "profile_async_start", 0, (char*)NULL);
+	ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "profile_async_start", 0, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		LOGE("[%s] Failed to set profile_async_start '0' (0x%x)" ,__FUNCTION__, ret);
 	}
 
-	int err;
-	mm_player_set_mute(handle->mm_handle, 1);
-	ret = mm_player_realize(handle->mm_handle);
-	err = mm_player_start(handle->mm_handle);
-	LOGE("START on Prepare() Sync!!!!!! : %d", err);
-	err = mm_player_pause(handle->mm_handle);
-	mm_player_set_mute(handle->mm_handle, 0);
+	_player_stats_mark(&handle->stats_prepare_start);
+	ret = mm_player_realize(_player_get_mm_handle(handle));
+	if(ret == MM_ERROR_NONE)
+	{
+		// preroll only : stop at PAUSED with the first frame decoded, player_start() resumes from here
+		ret = mm_player_pause(_player_get_mm_handle(handle));
+		if(ret != MM_ERROR_NONE)
+			mm_player_unrealize(_player_get_mm_handle(handle));
+	}
 
 	MMTA_ACUM_ITEM_END("[CAPI] player_prepare", 0);
 	if(ret != MM_ERROR_NONE)
 	{
+		handle->stats_prepare_start = 0;
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
-		handle->state = PLAYER_STATE_READY;
-		LOGE("[%s] End", __FUNCTION__);
+		_player_stats_record(&handle->stats.prepare, &handle->stats_prepare_start);
+		_player_set_state(handle, PLAYER_STATE_READY);
+		PLAYER_TRACE("[%s] End", __FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int 	player_unprepare (player_h player)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
-	
-	int ret = mm_player_unrealize(handle->mm_handle);
+
+	_player_thumbnail_stop(handle);
+	__pcm_ring_release(handle);
+	__release_next_source(handle);
+	int ret = mm_player_unrealize(_player_get_mm_handle(handle));
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
-		handle->state = PLAYER_STATE_IDLE;
+		_player_set_state(handle, PLAYER_STATE_IDLE);
 		handle->display_type = MM_DISPLAY_SURFACE_NULL; // means DISPLAY_TYPE_NONE(3)
 		handle->second_display_type = MM_DISPLAY_SURFACE_NULL; // means DISPLAY_TYPE_NONE(3)
-		LOGE("[%s] End", __FUNCTION__);
+		__atomic_store_n(&handle->pcm_bytes_per_sec, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&handle->pcm_decoded_bytes, 0, __ATOMIC_RELAXED);
+		__metadata_invalidate(handle);
+		__video_stream_invalidate(handle);
+		handle->playback_rate = 1.0;
+		handle->position_at_end = 0;
+		__position_invalidate(handle);
+		__seek_reset(handle);
+		__scrub_stop(handle, NULL);
+		PLAYER_TRACE("[%s] End", __FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int 	player_set_uri (player_h player, const char *uri)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(uri);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
 	
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,MM_PLAYER_CONTENT_URI , uri, strlen(uri), (char*)NULL);
+	__metadata_invalidate(handle);
+	__mmap_release(handle);
+	__push_source_release(handle);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_CONTENT_URI , uri, strlen(uri), (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -691,16 +1720,21 @@ int 	player_set_uri (player_h player, const char *uri)
 
 int 	player_set_memory_buffer (player_h player, const void *data, int size)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(data);
 	PLAYER_CHECK_CONDITION(size>=0,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
 	
 	char uri[PATH_MAX] ;
 	
 	snprintf(uri, sizeof(uri),"mem:///ext=%s,size=%d","", size);
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,MM_PLAYER_CONTENT_URI, uri, strlen(uri), MM_PLAYER_MEMORY_SRC, data,size,(char*)NULL);
+	__metadata_invalidate(handle);
+	__mmap_release(handle);
+	__push_source_release(handle);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_CONTENT_URI, uri, strlen(uri), MM_PLAYER_MEMORY_SRC, data,size,(char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -709,28 +1743,167 @@ int 	player_set_memory_buffer (player_h player, const void *data, int size)
 		return PLAYER_ERROR_NONE;
 }
 
+int 	player_set_mmap_file (player_h player, const char *path, int64_t offset, int length)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(path);
+	PLAYER_CHECK_CONDITION(offset>=0 && length>=0,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
+
+	_player_mmap_s *map = NULL;
+	int ret = _player_mmap_open(path, offset, length, &map);
+	if(ret != PLAYER_ERROR_NONE)
+		return ret;
+
+	// the extension helps the type finding of the memory source
+	const char *ext = strrchr(path, '.');
+	if(ext == NULL || strchr(ext, '/'))
+		ext = ".";
+	char uri[PATH_MAX] ;
+	int size;
+	const void *data = _player_mmap_get_data(map, &size);
+	snprintf(uri, sizeof(uri),"mem:///ext=%s,size=%d", ext + 1, size);
+
+	ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_CONTENT_URI, uri, strlen(uri), MM_PLAYER_MEMORY_SRC, data,size,(char*)NULL);
+	if(ret != MM_ERROR_NONE)
+	{
+		_player_mmap_close(map);
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	}
+	__metadata_invalidate(handle);
+	__mmap_release(handle);
+	__push_source_release(handle);
+	handle->mmap = map;
+	PLAYER_INFO("[%s] %s mapped, %d bytes", __FUNCTION__, path, size);
+	return PLAYER_ERROR_NONE;
+}
+
+int 	player_set_push_source (player_h player, player_push_need_data_cb need_data_cb, player_push_enough_data_cb enough_data_cb, void *user_data)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
+
+	const char *uri = "buff://";
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_CONTENT_URI, uri, strlen(uri), (char*)NULL);
+	if(ret == MM_ERROR_NONE)
+		ret = mm_player_set_buffer_need_data_callback(_player_get_mm_handle(handle), __push_need_data_callback, (void*)handle);
+	if(ret == MM_ERROR_NONE)
+		ret = mm_player_set_buffer_enough_data_callback(_player_get_mm_handle(handle), __push_enough_data_callback, (void*)handle);
+	if(ret != MM_ERROR_NONE)
+	{
+		mm_player_set_buffer_need_data_callback(_player_get_mm_handle(handle), NULL, NULL);
+		mm_player_set_buffer_enough_data_callback(_player_get_mm_handle(handle), NULL, NULL);
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	}
+
+	__metadata_invalidate(handle);
+	__mmap_release(handle);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PUSH_NEED_DATA, need_data_cb, user_data);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PUSH_ENOUGH_DATA, enough_data_cb, user_data);
+	handle->is_push_source = TRUE;
+	return PLAYER_ERROR_NONE;
+}
+
+int 	player_push_buffer (player_h player, const void *data, int size)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(data);
+	PLAYER_CHECK_CONDITION(size>0,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if(!handle->is_push_source)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : the source isn't a push source" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+
+	// mm-player copies the data into its own buffer
+	int ret = mm_player_push_buffer(_player_get_mm_handle(handle), (unsigned char*)data, size);
+	if(ret != MM_ERROR_NONE)
+	{
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	}
+	PLAYER_TRACE("[%s] pushed %d bytes",__FUNCTION__, size);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_set_next_uri (player_h player, const char *uri)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(uri);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if (!__player_state_validate(handle, PLAYER_STATE_READY))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+	return __prepare_next_source(handle, uri, NULL, 0);
+}
+
+int player_set_next_memory_buffer (player_h player, const void *data, int size)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(data);
+	PLAYER_CHECK_CONDITION(size>=0,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if (!__player_state_validate(handle, PLAYER_STATE_READY))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+
+	char uri[PATH_MAX] ;
+
+	snprintf(uri, sizeof(uri),"mem:///ext=%s,size=%d","", size);
+	return __prepare_next_source(handle, uri, data, size);
+}
+
+int player_unset_next_source (player_h player)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	__release_next_source(handle);
+	return PLAYER_ERROR_NONE;
+}
+
 int 	player_get_state (player_h player, player_state_e *state)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(state);
 	player_s * handle = (player_s *) player;
-	*state = handle->state;
+	PLAYER_MM_GUARD(handle);
+	*state = _player_get_state(handle);
 	MMPlayerStateType currentStat = MM_PLAYER_STATE_NULL;
-	mm_player_get_state(handle->mm_handle, &currentStat);
-	LOGE("[%s] State : %d (FW state : %d)", __FUNCTION__,handle->state, currentStat);
+	mm_player_get_state(_player_get_mm_handle(handle), &currentStat);
+	PLAYER_TRACE("[%s] State : %d (FW state : %d)", __FUNCTION__,_player_get_state(handle), currentStat);
 	return PLAYER_ERROR_NONE;
 }
 
 int 	player_set_volume (player_h player, float left, float right)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_CHECK_CONDITION(left>=0 && left <= 1.0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 	PLAYER_CHECK_CONDITION(right>=0 && right <= 1.0 ,PLAYER_ERROR_INVALID_PARAMETER, "PLAYER_ERROR_INVALID_PARAMETER" );
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	MMPlayerVolumeType vol;
 	vol.level[MM_VOLUME_CHANNEL_LEFT] = left;
 	vol.level[MM_VOLUME_CHANNEL_RIGHT] = right;
-	int ret = mm_player_set_volume(handle->mm_handle,&vol);
+	int ret = mm_player_set_volume(_player_get_mm_handle(handle),&vol);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -743,12 +1916,14 @@ int 	player_set_volume (player_h player, float left, float right)
 
 int 	player_get_volume (player_h player, float *left, float *right)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(left);
 	PLAYER_NULL_ARG_CHECK(right);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	MMPlayerVolumeType vol;
-	int ret = mm_player_get_volume(handle->mm_handle,&vol);
+	int ret = mm_player_get_volume(_player_get_mm_handle(handle),&vol);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -763,10 +1938,12 @@ int 	player_get_volume (player_h player, float *left, float *right)
 
 int player_set_sound_type(player_h player, sound_type_e type)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"sound_volume_type" , type, (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"sound_volume_type" , type, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -777,36 +1954,36 @@ int player_set_sound_type(player_h player, sound_type_e type)
 
 int 	player_start (player_h player)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	MMTA_ACUM_ITEM_BEGIN("[CAPI] player_start only", 0);
 	MMTA_ACUM_ITEM_BEGIN("[CAPI] player_start ~ BOS", 0);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	int ret;
-	if ( handle->state  ==PLAYER_STATE_READY || handle->state ==PLAYER_STATE_PAUSED)
+	if ( _player_get_state(handle)  ==PLAYER_STATE_READY || _player_get_state(handle) ==PLAYER_STATE_PAUSED)
 	{
+		// the stream only begins when starting from READY, resuming doesn't post it
+		if(_player_get_state(handle) == PLAYER_STATE_READY)
+			_player_stats_mark(&handle->stats_start_start);
 		if(handle->display_type == PLAYER_DISPLAY_TYPE_X11 || handle->display_type == PLAYER_DISPLAY_TYPE_EVAS)
 		{
-			ret = mm_player_set_attribute(handle->mm_handle, NULL,"display_visible" , 1, (char*)NULL);
-			LOGE("[%s] show video display : %d",__FUNCTION__, ret);
-		}
-		if(handle->is_prepare_sync)
-		{
-			//TODO: fix it !
-			ret = mm_player_pause(handle->mm_handle);
+			ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_visible" , 1, (char*)NULL);
+			PLAYER_TRACE("[%s] show video display : %d",__FUNCTION__, ret);
 		}
 		if(handle->is_stopped)
 		{
-			ret = mm_player_start(handle->mm_handle);
+			ret = mm_player_start(_player_get_mm_handle(handle));
 			handle->is_stopped = FALSE;
-			LOGE("[%s] stop -> start() ",__FUNCTION__);
+			PLAYER_TRACE("[%s] stop -> start() ",__FUNCTION__);
 		}
 		else
-			ret = mm_player_resume(handle->mm_handle);
+			ret = mm_player_resume(_player_get_mm_handle(handle));
 	}
 	else
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
@@ -816,136 +1993,227 @@ int 	player_start (player_h player)
 	}
 	else
 	{
-		handle->state = PLAYER_STATE_PLAYING;
-		LOGE("[%s] End", __FUNCTION__);
+		_player_set_state(handle, PLAYER_STATE_PLAYING);
+		__atomic_store_n(&handle->position_at_end, 0, __ATOMIC_RELEASE);
+		__position_invalidate(handle);
+		PLAYER_TRACE("[%s] End", __FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int 	player_stop (player_h player)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	if (handle->state == PLAYER_STATE_PLAYING || handle->state == PLAYER_STATE_PAUSED)
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) == PLAYER_STATE_PLAYING || _player_get_state(handle) == PLAYER_STATE_PAUSED)
 	{
-		int ret = mm_player_stop(handle->mm_handle);
+		int ret = mm_player_stop(_player_get_mm_handle(handle));
 		if(ret != MM_ERROR_NONE)
 		{
 			return __convert_error_code(ret,(char*)__FUNCTION__);
 		}
 		else
 		{
-			handle->state = PLAYER_STATE_READY;
+			_player_set_state(handle, PLAYER_STATE_READY);
 			handle->is_stopped = TRUE;
-			LOGE("[%s] End", __FUNCTION__);
+			__position_invalidate(handle);
+			__seek_abort(handle);
+			PLAYER_TRACE("[%s] End", __FUNCTION__);
 			return PLAYER_ERROR_NONE;
 		}
 	}
 	else
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 }
 
 int 	player_pause (player_h player)
 {
-	LOGE("[%s] Start", __FUNCTION__);
+	PLAYER_PROBE_API();
+	PLAYER_TRACE("[%s] Start", __FUNCTION__);
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_PLAYING);
 	
-	int ret = mm_player_pause(handle->mm_handle);
+	int ret = mm_player_pause(_player_get_mm_handle(handle));
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
-		handle->state = PLAYER_STATE_PAUSED;
-		LOGE("[%s] End", __FUNCTION__);
+		_player_set_state(handle, PLAYER_STATE_PAUSED);
+		__position_invalidate(handle);
+		PLAYER_TRACE("[%s] End", __FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int 	player_set_position (player_h player, int millisecond, player_seek_completed_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_CHECK_CONDITION(millisecond>=0  ,PLAYER_ERROR_INVALID_PARAMETER ,"PLAYER_ERROR_INVALID_PARAMETER" );
 
 	player_s * handle = (player_s *) player;
-	if(handle->user_cb[_PLAYER_EVENT_TYPE_SEEK])
-	{
-		LOGE("[%s] PLAYER_ERROR_SEEK_FAILED (0x%08x) : seeking... we can't do any more " ,__FUNCTION__, PLAYER_ERROR_SEEK_FAILED);
-		return PLAYER_ERROR_SEEK_FAILED;
-	}
-	else
+	PLAYER_MM_GUARD(handle);
+	if(_player_thumbnail_is_running(handle))
 	{
-		LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_SEEK);
-		handle->user_cb[_PLAYER_EVENT_TYPE_SEEK] = callback;
-		handle->user_data[_PLAYER_EVENT_TYPE_SEEK] = user_data;
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : extracting thumbnails" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
 	}
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_SEEK);
+	return __seek_start(handle, MM_PLAYER_POS_FORMAT_TIME, millisecond, FALSE, callback, user_data, FALSE);
+}
 
-	int ret = mm_player_set_position(handle->mm_handle, MM_PLAYER_POS_FORMAT_TIME, millisecond);
-	if(ret != MM_ERROR_NONE)
+int 	player_set_position_ratio (player_h player, int percent, player_seek_completed_cb callback, void *user_data)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_CHECK_CONDITION(percent>=0 && percent <= 100 ,PLAYER_ERROR_INVALID_PARAMETER ,"PLAYER_ERROR_INVALID_PARAMETER" );
+
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if(_player_thumbnail_is_running(handle))
 	{
-		return __convert_error_code(ret,(char*)__FUNCTION__);
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : extracting thumbnails" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
 	}
-	else
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_SEEK);
+	return __seek_start(handle, MM_PLAYER_POS_FORMAT_PERCENT, percent, FALSE, callback, user_data, FALSE);
+}
+
+int 	player_set_position_ex (player_h player, int millisecond, player_seek_mode_e mode, player_seek_completed_ex_cb callback, void *user_data)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_CHECK_CONDITION(millisecond>=0  ,PLAYER_ERROR_INVALID_PARAMETER ,"PLAYER_ERROR_INVALID_PARAMETER" );
+	PLAYER_CHECK_CONDITION(mode == PLAYER_SEEK_MODE_KEYFRAME || mode == PLAYER_SEEK_MODE_ACCURATE ,PLAYER_ERROR_INVALID_PARAMETER ,"PLAYER_ERROR_INVALID_PARAMETER" );
+
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if(_player_thumbnail_is_running(handle))
 	{
-		return PLAYER_ERROR_NONE;
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : extracting thumbnails" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
 	}
+	PLAYER_INFO("[%s] Event type : %d, mode : %d",__FUNCTION__, _PLAYER_EVENT_TYPE_SEEK, mode);
+	return __seek_start(handle, MM_PLAYER_POS_FORMAT_TIME, millisecond, mode == PLAYER_SEEK_MODE_ACCURATE, callback, user_data, TRUE);
 }
 
-int 	player_set_position_ratio (player_h player, int percent, player_seek_completed_cb callback, void *user_data)
+int 	player_scrub_begin (player_h player)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
-	PLAYER_CHECK_CONDITION(percent>=0 && percent <= 100 ,PLAYER_ERROR_INVALID_PARAMETER ,"PLAYER_ERROR_INVALID_PARAMETER" );
-
 	player_s * handle = (player_s *) player;
-	if(handle->user_cb[_PLAYER_EVENT_TYPE_SEEK])
+	PLAYER_MM_GUARD(handle);
+	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_SEEK_FAILED (0x%08x) : seeking... we can't do any more " ,__FUNCTION__, PLAYER_ERROR_SEEK_FAILED);
-		return PLAYER_ERROR_SEEK_FAILED;
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
 	}
-	else
+	pthread_mutex_lock(&handle->seek_lock);
+	if(handle->scrubbing || _player_thumbnail_is_running(handle))
 	{
-		LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_SEEK);
-		handle->user_cb[_PLAYER_EVENT_TYPE_SEEK] = callback;
-		handle->user_data[_PLAYER_EVENT_TYPE_SEEK] = user_data;
+		pthread_mutex_unlock(&handle->seek_lock);
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : already scrubbing or extracting thumbnails" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
 	}
 
-	int ret = mm_player_set_position(handle->mm_handle, MM_PLAYER_POS_FORMAT_PERCENT , percent);
+	int ret = mm_player_get_mute(_player_get_mm_handle(handle), &handle->scrub_muted);
+	if(ret == MM_ERROR_NONE)
+		ret = mm_player_set_mute(_player_get_mm_handle(handle), 1);
 	if(ret != MM_ERROR_NONE)
 	{
+		pthread_mutex_unlock(&handle->seek_lock);
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
-	else
+	handle->scrub_target = -1;
+	handle->scrubbing = TRUE;
+	pthread_mutex_unlock(&handle->seek_lock);
+	PLAYER_INFO("[%s] Start scrubbing",__FUNCTION__);
+	return PLAYER_ERROR_NONE;
+}
+
+int 	player_scrub_update (player_h player, int millisecond)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_CHECK_CONDITION(millisecond>=0  ,PLAYER_ERROR_INVALID_PARAMETER ,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	pthread_mutex_lock(&handle->seek_lock);
+	if(!handle->scrubbing)
+	{
+		pthread_mutex_unlock(&handle->seek_lock);
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : not scrubbing" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+	if(millisecond == handle->scrub_target)
 	{
+		pthread_mutex_unlock(&handle->seek_lock);
 		return PLAYER_ERROR_NONE;
 	}
+
+	// keyframe seeks without a callback : a newer update replaces the pending one silently
+	handle->scrub_target = millisecond;
+	pthread_mutex_unlock(&handle->seek_lock);
+	PLAYER_TRACE("[%s] target : %d",__FUNCTION__, millisecond);
+	return __seek_start(handle, MM_PLAYER_POS_FORMAT_TIME, millisecond, FALSE, NULL, NULL, FALSE);
+}
+
+int 	player_scrub_end (player_h player, player_seek_completed_ex_cb callback, void *user_data)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	int target;
+	if(!__scrub_stop(handle, &target))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : not scrubbing" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+
+	PLAYER_INFO("[%s] End scrubbing at %d",__FUNCTION__, target);
+	if(target < 0)
+		return PLAYER_ERROR_NONE;
+	return __seek_start(handle, MM_PLAYER_POS_FORMAT_TIME, target, TRUE, callback, user_data, TRUE);
 }
 
 
 int 	player_get_position (player_h player, int *millisecond)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(millisecond);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
+	if(__position_extrapolate(handle, millisecond))
+		return PLAYER_ERROR_NONE;
+
 	int pos;
-	int ret = mm_player_get_position(handle->mm_handle, MM_PLAYER_POS_FORMAT_TIME , &pos);
+	unsigned int generation = __atomic_load_n(&handle->position_generation, __ATOMIC_ACQUIRE);
+	int ret = mm_player_get_position(_player_get_mm_handle(handle), MM_PLAYER_POS_FORMAT_TIME , &pos);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
+		__position_anchor(handle, generation, pos);
+		__mmap_follow(handle, MM_PLAYER_POS_FORMAT_TIME, pos);
 		*millisecond = pos;
 		return PLAYER_ERROR_NONE;
 	}
@@ -953,16 +2221,18 @@ int 	player_get_position (player_h player, int *millisecond)
 
 int 	player_get_position_ratio (player_h player,int *percent)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(percent);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 	int pos;
-	int ret = mm_player_get_position(handle->mm_handle, MM_PLAYER_POS_FORMAT_PERCENT, &pos);
+	int ret = mm_player_get_position(_player_get_mm_handle(handle), MM_PLAYER_POS_FORMAT_PERCENT, &pos);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -976,10 +2246,21 @@ int 	player_get_position_ratio (player_h player,int *percent)
 
 int 	player_set_mute (player_h player, bool muted)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
-	int ret = mm_player_set_mute(handle->mm_handle, muted);
+	// the audio stays off until the end of scrubbing, which applies this
+	pthread_mutex_lock(&handle->seek_lock);
+	if(handle->scrubbing)
+	{
+		handle->scrub_muted = muted;
+		pthread_mutex_unlock(&handle->seek_lock);
+		return PLAYER_ERROR_NONE;
+	}
+	int ret = mm_player_set_mute(_player_get_mm_handle(handle), muted);
+	pthread_mutex_unlock(&handle->seek_lock);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -992,12 +2273,22 @@ int 	player_set_mute (player_h player, bool muted)
 
 int 	player_is_muted (player_h player, bool *muted)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(muted);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
+	pthread_mutex_lock(&handle->seek_lock);
+	if(handle->scrubbing)
+	{
+		*muted = handle->scrub_muted ? TRUE : FALSE;
+		pthread_mutex_unlock(&handle->seek_lock);
+		return PLAYER_ERROR_NONE;
+	}
+	pthread_mutex_unlock(&handle->seek_lock);
 	int _mute;
-	int ret = mm_player_get_mute(handle->mm_handle, &_mute);
+	int ret = mm_player_get_mute(_player_get_mm_handle(handle), &_mute);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1018,11 +2309,13 @@ int 	player_is_muted (player_h player, bool *muted)
 
 int 	player_set_looping (player_h player, bool looping)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_IDLE))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
@@ -1031,7 +2324,7 @@ int 	player_set_looping (player_h player, bool looping)
 	{
 		value = -1;
 	}
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,MM_PLAYER_PLAYBACK_COUNT , value, (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_PLAYBACK_COUNT , value, (char*)NULL);
 	
 	if(ret != MM_ERROR_NONE)
 	{
@@ -1045,16 +2338,18 @@ int 	player_set_looping (player_h player, bool looping)
 
 int 	player_is_looping (player_h player, bool *looping)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(looping);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_IDLE))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 	int count;
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,MM_PLAYER_PLAYBACK_COUNT , &count, (char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_PLAYBACK_COUNT , &count, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1075,45 +2370,64 @@ int 	player_is_looping (player_h player, bool *looping)
 
 int 	player_get_duration (player_h player, int *duration)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(duration);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
+	pthread_mutex_lock(&handle->metadata_lock);
+	if(__metadata_lookup(handle, _PLAYER_METADATA_DURATION))
+	{
+		*duration = handle->metadata_duration;
+		pthread_mutex_unlock(&handle->metadata_lock);
+		return PLAYER_ERROR_NONE;
+	}
 	int _duration;
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,MM_PLAYER_CONTENT_DURATION, &_duration, (char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_CONTENT_DURATION, &_duration, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
+		pthread_mutex_unlock(&handle->metadata_lock);
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
+		// live streams report 0 until the duration is known
+		if(_duration > 0)
+		{
+			handle->metadata_duration = _duration;
+			__metadata_set_valid(handle, _PLAYER_METADATA_DURATION);
+		}
+		pthread_mutex_unlock(&handle->metadata_lock);
 		*duration = _duration;
-		LOGE("[%s] duration : %d",__FUNCTION__,_duration);
+		PLAYER_TRACE("[%s] duration : %d",__FUNCTION__,_duration);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int player_set_display(player_h player, player_display_type_e type, player_display_h display)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
 	int ret;
 	// in case of multi surface
 	if(handle->second_display_type!=(int)MM_DISPLAY_SURFACE_NULL)
 	{
-		if (handle->state != PLAYER_STATE_PLAYING && handle->state != PLAYER_STATE_PAUSED)
+		if (_player_get_state(handle) != PLAYER_STATE_PLAYING && _player_get_state(handle) != PLAYER_STATE_PAUSED)
 		{
-			LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+			LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 			return PLAYER_ERROR_INVALID_STATE;
 		}
-		LOGE("[%s] Change Type : %d",__FUNCTION__, type);
+		PLAYER_TRACE("[%s] Change Type : %d",__FUNCTION__, type);
 
-		ret = mm_player_set_attribute(handle->mm_handle, NULL,"display_surface_type", type,(char*)NULL);
+		ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_surface_type", type,(char*)NULL);
 		if(ret != MM_ERROR_NONE)
 		{
 			return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1125,12 +2439,12 @@ int player_set_display(player_h player, player_display_type_e type, player_displ
 			player_display_type_e temp_type = handle->display_type;
 			handle->display_type = handle->second_display_type;
 			handle->second_display_type = temp_type;
-			LOGE("[%s]change surface - main Type : %d, main display addr : %x , second Type : %d, seconds display addr : %x ",__FUNCTION__,handle->display_type, handle->display_handle,  handle->second_display_type, handle->second_display_handle );
+			PLAYER_TRACE("[%s]change surface - main Type : %d, main display addr : %x , second Type : %d, seconds display addr : %x ",__FUNCTION__,handle->display_type, handle->display_handle,  handle->second_display_type, handle->second_display_handle );
 			return PLAYER_ERROR_NONE;
 		}
 		else
 		{
-			LOGE("[%s] Skip change display : same type");
+			PLAYER_TRACE("[%s] Skip change display : same type",__FUNCTION__);
 			return PLAYER_ERROR_NONE;
 		}
 	}
@@ -1138,21 +2452,21 @@ int player_set_display(player_h player, player_display_type_e type, player_displ
 	// normal case
 	if (!__player_state_validate(handle, PLAYER_STATE_IDLE))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
 	if (type == handle->display_type) // same type
 	{
 		handle->display_handle = display;
-		ret = mm_player_set_attribute(handle->mm_handle, NULL, "display_overlay" , type == PLAYER_DISPLAY_TYPE_X11 ? &handle->display_handle : display, sizeof(display), (char*)NULL);
+		ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "display_overlay" , type == PLAYER_DISPLAY_TYPE_X11 ? &handle->display_handle : display, sizeof(display), (char*)NULL);
 	} else	if(handle->display_type == (int)MM_DISPLAY_SURFACE_NULL) // first
 	{
 		handle->display_handle = display;
 		handle->display_type = type;
-		LOGE("[%s] video display has been set initailly - type :%d",__FUNCTION__,type);
-		LOGE("[%s] main Type : %d, main display addr : %x",__FUNCTION__,handle->display_type, handle->display_handle);
-		ret = mm_player_set_attribute(handle->mm_handle, NULL, "display_surface_use_multi",0,"display_surface_type", type, "display_overlay" , type == PLAYER_DISPLAY_TYPE_X11 ? &handle->display_handle : display, sizeof(display), (char*)NULL);
+		PLAYER_TRACE("[%s] video display has been set initailly - type :%d",__FUNCTION__,type);
+		PLAYER_TRACE("[%s] main Type : %d, main display addr : %x",__FUNCTION__,handle->display_type, handle->display_handle);
+		ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "display_surface_use_multi",0,"display_surface_type", type, "display_overlay" , type == PLAYER_DISPLAY_TYPE_X11 ? &handle->display_handle : display, sizeof(display), (char*)NULL);
 	}
 	else //secondary
 	{
@@ -1160,9 +2474,9 @@ int player_set_display(player_h player, player_display_type_e type, player_displ
 		handle->second_display_type = handle->display_type;
 		handle->display_handle = display;
 		handle->display_type = type;
-		LOGE("[%s] video display has been set again- type :%d",__FUNCTION__,type);
-		LOGE("[%s] main Type : %d, main display addr : %x , second Type : %d, seconds display addr : %x ",__FUNCTION__,handle->display_type, handle->display_handle,  handle->second_display_type, handle->second_display_handle);
-		ret = mm_player_set_attribute(handle->mm_handle, NULL, "display_surface_use_multi",1,"display_surface_type", type, "display_overlay" , type == PLAYER_DISPLAY_TYPE_X11 ? &handle->display_handle : display, sizeof(display), "display_overlay_ext",handle->second_display_type == PLAYER_DISPLAY_TYPE_X11 ? &handle->second_display_handle: handle->second_display_handle, sizeof(handle->second_display_handle) ,(char*)NULL);
+		PLAYER_TRACE("[%s] video display has been set again- type :%d",__FUNCTION__,type);
+		PLAYER_TRACE("[%s] main Type : %d, main display addr : %x , second Type : %d, seconds display addr : %x ",__FUNCTION__,handle->display_type, handle->display_handle,  handle->second_display_type, handle->second_display_handle);
+		ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "display_surface_use_multi",1,"display_surface_type", type, "display_overlay" , type == PLAYER_DISPLAY_TYPE_X11 ? &handle->display_handle : display, sizeof(display), "display_overlay_ext",handle->second_display_type == PLAYER_DISPLAY_TYPE_X11 ? &handle->second_display_handle: handle->second_display_handle, sizeof(handle->second_display_handle) ,(char*)NULL);
 	}
 
 	if(ret != MM_ERROR_NONE)
@@ -1173,16 +2487,18 @@ int player_set_display(player_h player, player_display_type_e type, player_displ
 	}
 	else
 	{
-		LOGE("[%s] End",__FUNCTION__);
+		PLAYER_TRACE("[%s] End",__FUNCTION__);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
 int player_is_display_mode_changeable(player_h player, bool* changeable)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(changeable);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	switch(handle->display_type)
 	{
 		case PLAYER_DISPLAY_TYPE_X11:
@@ -1193,7 +2509,7 @@ int player_is_display_mode_changeable(player_h player, bool* changeable)
 			char *sink_name = NULL;
 			int length;
 			int scaling;
-			int ret = mm_player_get_attribute(handle->mm_handle, NULL,"display_evas_surface_sink" ,&sink_name, &length, "display_evas_do_scaling", &scaling, (char*)NULL);
+			int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,"display_evas_surface_sink" ,&sink_name, &length, "display_evas_do_scaling", &scaling, (char*)NULL);
 			if(ret != MM_ERROR_NONE)
 				*changeable = FALSE;
 			if (!strncmp(sink_name,"evaspixmapsink",length) && scaling==1)
@@ -1211,10 +2527,12 @@ int player_is_display_mode_changeable(player_h player, bool* changeable)
 
 int player_set_display_mode(player_h player, player_display_mode_e mode)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"display_method" , mode, (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_method" , mode, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1225,10 +2543,12 @@ int player_set_display_mode(player_h player, player_display_mode_e mode)
 
 int player_get_display_mode(player_h player, player_display_mode_e *mode)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(mode);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,"display_method"  ,mode, (char*)NULL);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,"display_method"  ,mode, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1241,17 +2561,21 @@ int player_get_display_mode(player_h player, player_display_mode_e *mode)
 
 int player_set_playback_rate(player_h player, float rate)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_CHECK_CONDITION(rate>=-5.0 && rate <= 5.0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_PLAYING);
 
-	int ret = mm_player_set_play_speed(handle->mm_handle, rate);
+	__position_invalidate(handle);
+	int ret = mm_player_set_play_speed(_player_get_mm_handle(handle), rate);
 
 	switch (ret)
 	{
 	case MM_ERROR_NONE:
 	case MM_ERROR_PLAYER_NO_OP:
+		__atomic_store(&handle->playback_rate, &rate, __ATOMIC_RELAXED);
 		ret = PLAYER_ERROR_NONE;
 		break;
 	case MM_ERROR_NOT_SUPPORT_API:
@@ -1268,10 +2592,12 @@ int player_set_playback_rate(player_h player, float rate)
 
 int player_set_x11_display_rotation(player_h player, player_display_rotation_e rotation)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,MM_PLAYER_VIDEO_ROTATION , rotation, (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_VIDEO_ROTATION , rotation, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1282,10 +2608,12 @@ int player_set_x11_display_rotation(player_h player, player_display_rotation_e r
 
 int player_get_x11_display_rotation( player_h player, player_display_rotation_e *rotation)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(rotation);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,MM_PLAYER_VIDEO_ROTATION ,rotation, (char*)NULL);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_VIDEO_ROTATION ,rotation, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1298,8 +2626,10 @@ int player_get_x11_display_rotation( player_h player, player_display_rotation_e
 
 int player_set_x11_display_visible(player_h player, bool visible)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
 	int value = 0;
 	if(visible==TRUE)
@@ -1307,7 +2637,7 @@ int player_set_x11_display_visible(player_h player, bool visible)
 		value = 1;
 	}
 
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"display_visible" , value, (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_visible" , value, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1318,11 +2648,13 @@ int player_set_x11_display_visible(player_h player, bool visible)
 
 int player_is_x11_display_visible(player_h player, bool* visible)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(visible);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	int count;
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,"display_visible" ,&count, (char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,"display_visible" ,&count, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1344,11 +2676,13 @@ int player_is_x11_display_visible(player_h player, bool* visible)
 
 int player_set_x11_display_zoom(player_h player, int level)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_CHECK_CONDITION(level>0 && level < 10 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"display_zoom" , level, (char*)NULL);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_zoom" , level, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1359,11 +2693,13 @@ int player_set_x11_display_zoom(player_h player, int level)
 
 int player_get_x11_display_zoom( player_h player, int *level)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(level);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	int _level;
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,"display_zoom" , &_level, (char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,"display_zoom" , &_level, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		*level=-1;
@@ -1378,89 +2714,92 @@ int player_get_x11_display_zoom( player_h player, int *level)
 
 int player_enable_evas_display_scaling(player_h player, bool enable)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
-	player_s * handle = (player_s *) player;
-
-	int scaling = enable?1:0;
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"display_evas_do_scaling" , scaling, (char*)NULL);
-	if(ret != MM_ERROR_NONE)
-	{
-		return __convert_error_code(ret,(char*)__FUNCTION__);
-	}
-	else
-		return PLAYER_ERROR_NONE;
-}
-
-int player_get_content_info(player_h player, player_content_info_e key, char ** value)
-{
-	PLAYER_INSTANCE_CHECK(player);
-	PLAYER_NULL_ARG_CHECK(value);
-	player_s * handle = (player_s *) player;
-	if (!__player_state_validate(handle, PLAYER_STATE_READY))
-	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
-		return PLAYER_ERROR_INVALID_STATE;
-	}
-
-	char* attr=NULL;
-	char* val=NULL;
-	int val_len=0;
-
-	switch(key)
-	{
-		case PLAYER_CONTENT_INFO_ALBUM:
-			attr = MM_PLAYER_TAG_ALBUM;
-			break;
-		case PLAYER_CONTENT_INFO_ARTIST:
-			attr = MM_PLAYER_TAG_ARTIST;
-			break;
-		case PLAYER_CONTENT_INFO_AUTHOR:
-			attr = MM_PLAYER_TAG_AUTHOUR;
-			break;
-		case PLAYER_CONTENT_INFO_GENRE:
-			attr = MM_PLAYER_TAG_GENRE;
-			break;
-		case PLAYER_CONTENT_INFO_TITLE:
-			attr = MM_PLAYER_TAG_TITLE;
-			break;
-		case PLAYER_CONTENT_INFO_YEAR:
-			attr = MM_PLAYER_TAG_DATE;
-			break;
-		default:
-				attr=NULL;
-	}
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,attr ,&val, &val_len, (char*)NULL);
+	int scaling = enable?1:0;
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"display_evas_do_scaling" , scaling, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
+		return PLAYER_ERROR_NONE;
+}
+
+int player_get_content_info(player_h player, player_content_info_e key, char ** value)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(value);
+	PLAYER_CHECK_CONDITION(key >= PLAYER_CONTENT_INFO_ALBUM && key <= PLAYER_CONTENT_INFO_YEAR,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		*value = NULL;
-		if(val!=NULL)
-			*value = strndup(val,val_len);
-		else
-			*value = strndup("",0);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+
+	// the tags are fetched together on the first miss, indexed by player_content_info_e
+	pthread_mutex_lock(&handle->metadata_lock);
+	if(!__metadata_lookup(handle, _PLAYER_METADATA_TAGS))
+	{
+		char* val[_PLAYER_METADATA_TAG_NUM] = {NULL,};
+		int val_len[_PLAYER_METADATA_TAG_NUM] = {0,};
+		int i;
 
-		if (*value == NULL)
+		int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,
+			MM_PLAYER_TAG_ALBUM, &val[PLAYER_CONTENT_INFO_ALBUM], &val_len[PLAYER_CONTENT_INFO_ALBUM],
+			MM_PLAYER_TAG_ARTIST, &val[PLAYER_CONTENT_INFO_ARTIST], &val_len[PLAYER_CONTENT_INFO_ARTIST],
+			MM_PLAYER_TAG_AUTHOUR, &val[PLAYER_CONTENT_INFO_AUTHOR], &val_len[PLAYER_CONTENT_INFO_AUTHOR],
+			MM_PLAYER_TAG_GENRE, &val[PLAYER_CONTENT_INFO_GENRE], &val_len[PLAYER_CONTENT_INFO_GENRE],
+			MM_PLAYER_TAG_TITLE, &val[PLAYER_CONTENT_INFO_TITLE], &val_len[PLAYER_CONTENT_INFO_TITLE],
+			MM_PLAYER_TAG_DATE, &val[PLAYER_CONTENT_INFO_YEAR], &val_len[PLAYER_CONTENT_INFO_YEAR],
+			(char*)NULL);
+		if(ret != MM_ERROR_NONE)
 		{
-			LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x) : fail to strdup ", __FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
-			return PLAYER_ERROR_OUT_OF_MEMORY;
+			pthread_mutex_unlock(&handle->metadata_lock);
+			return __convert_error_code(ret,(char*)__FUNCTION__);
 		}
-		return PLAYER_ERROR_NONE;
+		for(i = 0; i < _PLAYER_METADATA_TAG_NUM; i++)
+		{
+			free(handle->metadata_tags[i]);
+			handle->metadata_tags[i] = val[i] ? strndup(val[i], val_len[i]) : strndup("", 0);
+			if(handle->metadata_tags[i] == NULL)
+			{
+				__metadata_clear(handle);
+				pthread_mutex_unlock(&handle->metadata_lock);
+				LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x) : fail to strdup ", __FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+				return PLAYER_ERROR_OUT_OF_MEMORY;
+			}
+		}
+		__metadata_set_valid(handle, _PLAYER_METADATA_TAGS);
 	}
+
+	*value = strdup(handle->metadata_tags[key]);
+	pthread_mutex_unlock(&handle->metadata_lock);
+	if (*value == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x) : fail to strdup ", __FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+		return PLAYER_ERROR_OUT_OF_MEMORY;
+	}
+	return PLAYER_ERROR_NONE;
 }
 
 int player_get_codec_info(player_h player, char **audio_codec, char **video_codec)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(audio_codec);
 	PLAYER_NULL_ARG_CHECK(video_codec);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
@@ -1469,7 +2808,7 @@ int player_get_codec_info(player_h player, char **audio_codec, char **video_code
 	char* video=NULL;
 	int video_len=0;
 
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,MM_PLAYER_AUDIO_CODEC,&audio,&audio_len,MM_PLAYER_VIDEO_CODEC,&video,&video_len,(char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_AUDIO_CODEC,&audio,&audio_len,MM_PLAYER_VIDEO_CODEC,&video,&video_len,(char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1494,17 +2833,19 @@ int player_get_codec_info(player_h player, char **audio_codec, char **video_code
 
 int player_get_audio_stream_info(player_h player, int *sample_rate, int *channel, int *bit_rate)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(sample_rate);
 	PLAYER_NULL_ARG_CHECK(channel);
 	PLAYER_NULL_ARG_CHECK(bit_rate);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,MM_PLAYER_AUDIO_SAMPLERATE,sample_rate,MM_PLAYER_AUDIO_CHANNEL,channel,MM_PLAYER_AUDIO_BITRATE,bit_rate,(char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_AUDIO_SAMPLERATE,sample_rate,MM_PLAYER_AUDIO_CHANNEL,channel,MM_PLAYER_AUDIO_BITRATE,bit_rate,(char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1514,16 +2855,18 @@ int player_get_audio_stream_info(player_h player, int *sample_rate, int *channel
 
 int player_get_video_stream_info(player_h player, int *fps, int *bit_rate)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(fps);
 	PLAYER_NULL_ARG_CHECK(bit_rate);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,"content_video_fps",fps,"content_video_bitrate",bit_rate,(char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,"content_video_fps",fps,"content_video_bitrate",bit_rate,(char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1533,43 +2876,146 @@ int player_get_video_stream_info(player_h player, int *fps, int *bit_rate)
 
 int player_get_video_size (player_h player, int *width, int *height)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(width);
 	PLAYER_NULL_ARG_CHECK(height);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
+	pthread_mutex_lock(&handle->metadata_lock);
+	if(__metadata_lookup(handle, _PLAYER_METADATA_VIDEO_SIZE))
+	{
+		*width = handle->metadata_width;
+		*height = handle->metadata_height;
+		pthread_mutex_unlock(&handle->metadata_lock);
+		return PLAYER_ERROR_NONE;
+	}
 	int w;
 	int h;
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,MM_PLAYER_VIDEO_WIDTH ,&w,  MM_PLAYER_VIDEO_HEIGHT, &h, (char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,MM_PLAYER_VIDEO_WIDTH ,&w,  MM_PLAYER_VIDEO_HEIGHT, &h, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
+		pthread_mutex_unlock(&handle->metadata_lock);
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
+		if(w > 0 && h > 0)
+		{
+			handle->metadata_width = w;
+			handle->metadata_height = h;
+			__metadata_set_valid(handle, _PLAYER_METADATA_VIDEO_SIZE);
+		}
+		pthread_mutex_unlock(&handle->metadata_lock);
 		*width = w;
 		*height = h;
-		LOGE("[%s] width : %d, height : %d",__FUNCTION__,w, h);
+		PLAYER_TRACE("[%s] width : %d, height : %d",__FUNCTION__,w, h);
 		return PLAYER_ERROR_NONE;
 	}
 }
 
+int _player_media_info_set_strings(player_media_info_s *info, char **val, int *len)
+{
+	char **field[_PLAYER_MEDIA_INFO_STRING_NUM] = {&info->album, &info->artist, &info->author, &info->genre, &info->title, &info->year, &info->audio_codec, &info->video_codec};
+	size_t total = 0;
+	int i;
+
+	// every string goes in a single block, so that releasing is one free()
+	for(i = 0; i < _PLAYER_MEDIA_INFO_STRING_NUM; i++)
+		total += (val[i] ? len[i] : 0) + 1;
+
+	char *arena = (char*)malloc(total);
+	if(arena == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+		memset(info, 0, sizeof(player_media_info_s));
+		return PLAYER_ERROR_OUT_OF_MEMORY;
+	}
+	info->arena = arena;
+	for(i = 0; i < _PLAYER_MEDIA_INFO_STRING_NUM; i++)
+	{
+		int n = val[i] ? strnlen(val[i], len[i]) : 0;
+		if(n > 0)
+			memcpy(arena, val[i], n);
+		arena[n] = '\0';
+		*field[i] = arena;
+		arena += (val[i] ? len[i] : 0) + 1;
+	}
+	return PLAYER_ERROR_NONE;
+}
+
+int player_get_media_info(player_h player, player_media_info_s *info)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(info);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if (!__player_state_validate(handle, PLAYER_STATE_READY))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+
+	char *val[_PLAYER_MEDIA_INFO_STRING_NUM] = {NULL,};
+	int len[_PLAYER_MEDIA_INFO_STRING_NUM] = {0,};
+
+	memset(info, 0, sizeof(player_media_info_s));
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,
+		MM_PLAYER_TAG_ALBUM, &val[0], &len[0],
+		MM_PLAYER_TAG_ARTIST, &val[1], &len[1],
+		MM_PLAYER_TAG_AUTHOUR, &val[2], &len[2],
+		MM_PLAYER_TAG_GENRE, &val[3], &len[3],
+		MM_PLAYER_TAG_TITLE, &val[4], &len[4],
+		MM_PLAYER_TAG_DATE, &val[5], &len[5],
+		MM_PLAYER_AUDIO_CODEC, &val[6], &len[6],
+		MM_PLAYER_VIDEO_CODEC, &val[7], &len[7],
+		MM_PLAYER_AUDIO_SAMPLERATE, &info->sample_rate,
+		MM_PLAYER_AUDIO_CHANNEL, &info->channel,
+		MM_PLAYER_AUDIO_BITRATE, &info->audio_bit_rate,
+		"content_video_fps", &info->fps,
+		"content_video_bitrate", &info->video_bit_rate,
+		MM_PLAYER_VIDEO_WIDTH, &info->width,
+		MM_PLAYER_VIDEO_HEIGHT, &info->height,
+		MM_PLAYER_CONTENT_DURATION, &info->duration,
+		(char*)NULL);
+	if(ret != MM_ERROR_NONE)
+	{
+		memset(info, 0, sizeof(player_media_info_s));
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	}
+
+	return _player_media_info_set_strings(info, val, len);
+}
+
+int player_release_media_info(player_media_info_s *info)
+{
+	PLAYER_PROBE_API();
+	PLAYER_NULL_ARG_CHECK(info);
+	free(info->arena);
+	memset(info, 0, sizeof(player_media_info_s));
+	return PLAYER_ERROR_NONE;
+}
+
 int player_get_album_art(player_h player, void **album_art, int *size)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(size);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
-	int ret = mm_player_get_attribute(handle->mm_handle, NULL,"tag_album_cover",album_art,size,(char*)NULL);
+	int ret = mm_player_get_attribute(_player_get_mm_handle(handle), NULL,"tag_album_cover",album_art,size,(char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1579,15 +3025,17 @@ int player_get_album_art(player_h player, void **album_art, int *size)
 
 int player_get_track_count(player_h player, player_track_type_e type, int *count)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(count);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_READY))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) :  current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
-	int ret = mm_player_get_track_count(handle->mm_handle, type, count);
+	int ret = mm_player_get_track_count(_player_get_mm_handle(handle), type, count);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1597,26 +3045,30 @@ int player_get_track_count(player_h player, player_track_type_e type, int *count
 
 int player_audio_effect_set_value(player_h player, audio_effect_e effect, int value)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_set_level(handle->mm_handle,effect,0,value);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_set_level(_player_get_mm_handle(handle),effect,0,value);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
-		ret = mm_player_sound_filter_custom_apply(handle->mm_handle);
+		ret = mm_player_sound_filter_custom_apply(_player_get_mm_handle(handle));
 		return (ret==MM_ERROR_NONE)?PLAYER_ERROR_NONE:__convert_error_code(ret,(char*)__FUNCTION__);
 	}
 }
 
 int player_audio_effect_get_value(player_h player, audio_effect_e effect, int *value)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(value);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_get_level(handle->mm_handle,effect,0,value);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_get_level(_player_get_mm_handle(handle),effect,0,value);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1625,27 +3077,31 @@ int player_audio_effect_get_value(player_h player, audio_effect_e effect, int *v
 
 int player_audio_effect_clear(player_h player, audio_effect_e effect)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_clear_ext_all(handle->mm_handle);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_clear_ext_all(_player_get_mm_handle(handle));
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
-		ret = mm_player_sound_filter_custom_apply(handle->mm_handle);
+		ret = mm_player_sound_filter_custom_apply(_player_get_mm_handle(handle));
 		return (ret==MM_ERROR_NONE)?PLAYER_ERROR_NONE:__convert_error_code(ret,(char*)__FUNCTION__);
 	}
 }
 
 int player_audio_effect_get_value_range(player_h player, audio_effect_e effect, int* min, int* max)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(min);
 	PLAYER_NULL_ARG_CHECK(max);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_get_level_range(handle->mm_handle, effect, min, max);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_get_level_range(_player_get_mm_handle(handle), effect, min, max);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1654,10 +3110,12 @@ int player_audio_effect_get_value_range(player_h player, audio_effect_e effect,
 
 int player_audio_effect_is_available(player_h player, audio_effect_e effect, bool *available)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(available);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_is_supported_custom_filter_type(handle->mm_handle, effect);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_is_supported_custom_filter_type(_player_get_mm_handle(handle), effect);
 	if(ret != MM_ERROR_NONE)
 		*available = FALSE;
 	else
@@ -1667,14 +3125,15 @@ int player_audio_effect_is_available(player_h player, audio_effect_e effect, boo
 
 int player_audio_effect_foreach_supported_effect(player_h player, player_audio_effect_supported_effect_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(callback);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE);
-	handle->user_cb[_PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE] = callback;
-	handle->user_data[_PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE] = user_data;
-	int ret = mm_player_get_foreach_present_supported_filter_type(handle->mm_handle, MM_AUDIO_FILTER_TYPE_CUSTOM, __supported_audio_effect_type, (void*)handle);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE);
+	_player_set_user_cb(handle, _PLAYER_SUPPORTED_AUDIO_EFFECT_TYPE, callback, user_data);
+	int ret = mm_player_get_foreach_present_supported_filter_type(_player_get_mm_handle(handle), MM_AUDIO_FILTER_TYPE_CUSTOM, __supported_audio_effect_type, (void*)handle);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1683,9 +3142,11 @@ int player_audio_effect_foreach_supported_effect(player_h player, player_audio_e
 
 int player_audio_effect_set_preset(player_h player, audio_effect_preset_e preset)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_preset_apply(handle->mm_handle, preset);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_preset_apply(_player_get_mm_handle(handle), preset);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1694,10 +3155,12 @@ int player_audio_effect_set_preset(player_h player, audio_effect_preset_e preset
 
 int player_audio_effect_preset_is_available(player_h player, audio_effect_preset_e preset, bool *available)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(available);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_is_supported_preset_filter_type(handle->mm_handle, preset);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_is_supported_preset_filter_type(_player_get_mm_handle(handle), preset);
 	if(ret != MM_ERROR_NONE)
 		*available = FALSE;
 	else
@@ -1707,14 +3170,15 @@ int player_audio_effect_preset_is_available(player_h player, audio_effect_preset
 
 int player_audio_effect_foreach_supported_preset(player_h player, player_audio_effect_supported_preset_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(callback);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET);
-	handle->user_cb[_PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET] = callback;
-	handle->user_data[_PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET] = user_data;
-	int ret = mm_player_get_foreach_present_supported_filter_type(handle->mm_handle, MM_AUDIO_FILTER_TYPE_PRESET, __supported_audio_effect_preset, (void*)handle);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET);
+	_player_set_user_cb(handle, _PLAYER_SUPPORTED_AUDIO_EFFECT_PRESET, callback, user_data);
+	int ret = mm_player_get_foreach_present_supported_filter_type(_player_get_mm_handle(handle), MM_AUDIO_FILTER_TYPE_PRESET, __supported_audio_effect_preset, (void*)handle);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1723,10 +3187,12 @@ int player_audio_effect_foreach_supported_preset(player_h player, player_audio_e
 
 int player_audio_effect_get_equalizer_bands_count (player_h player, int *count)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(count);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_get_eq_bands_number(handle->mm_handle, count);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_get_eq_bands_number(_player_get_mm_handle(handle), count);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1735,10 +3201,12 @@ int player_audio_effect_get_equalizer_bands_count (player_h player, int *count)
 
 int player_audio_effect_set_equalizer_all_bands(player_h player, int *band_levels, int length)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(band_levels);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_set_level_eq_from_list(handle->mm_handle, band_levels, length);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_set_level_eq_from_list(_player_get_mm_handle(handle), band_levels, length);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1747,26 +3215,30 @@ int player_audio_effect_set_equalizer_all_bands(player_h player, int *band_level
 
 int player_audio_effect_set_equalizer_band_level(player_h player, int index, int level)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_set_level(handle->mm_handle,MM_AUDIO_FILTER_CUSTOM_EQ, index, level);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_set_level(_player_get_mm_handle(handle),MM_AUDIO_FILTER_CUSTOM_EQ, index, level);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	}
 	else
 	{
-		ret = mm_player_sound_filter_custom_apply(handle->mm_handle);
+		ret = mm_player_sound_filter_custom_apply(_player_get_mm_handle(handle));
 		return (ret==MM_ERROR_NONE)?PLAYER_ERROR_NONE:__convert_error_code(ret,(char*)__FUNCTION__);
 	}
 }
 
 int player_audio_effect_get_equalizer_band_level(player_h player, int index, int *level)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(level);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_get_level(handle->mm_handle,MM_AUDIO_FILTER_CUSTOM_EQ, index, level);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_get_level(_player_get_mm_handle(handle),MM_AUDIO_FILTER_CUSTOM_EQ, index, level);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1775,11 +3247,13 @@ int player_audio_effect_get_equalizer_band_level(player_h player, int index, int
 
 int player_audio_effect_get_equalizer_level_range(player_h player, int* min, int* max)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(min);
 	PLAYER_NULL_ARG_CHECK(max);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_get_level_range(handle->mm_handle, MM_AUDIO_FILTER_CUSTOM_EQ, min, max);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_get_level_range(_player_get_mm_handle(handle), MM_AUDIO_FILTER_CUSTOM_EQ, min, max);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1788,9 +3262,11 @@ int player_audio_effect_get_equalizer_level_range(player_h player, int* min, int
 
 int player_audio_effect_equalizer_clear(player_h player)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_sound_filter_custom_clear_eq_all(handle->mm_handle);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_sound_filter_custom_clear_eq_all(_player_get_mm_handle(handle));
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -1799,10 +3275,12 @@ int player_audio_effect_equalizer_clear(player_h player)
 
 int player_audio_effect_equalizer_is_available(player_h player, bool *available)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(available);
 	player_s * handle = (player_s *) player;
-	int ret = mm_player_is_supported_custom_filter_type(handle->mm_handle, MM_AUDIO_FILTER_CUSTOM_EQ);
+	PLAYER_MM_GUARD(handle);
+	int ret = mm_player_is_supported_custom_filter_type(_player_get_mm_handle(handle), MM_AUDIO_FILTER_CUSTOM_EQ);
 	if(ret != MM_ERROR_NONE)
 		*available = FALSE;
 	else
@@ -1812,12 +3290,14 @@ int player_audio_effect_equalizer_is_available(player_h player, bool *available)
 
 int player_set_subtitle_path(player_h player,const char* path)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(path);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
 
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"subtitle_uri" , path, strlen(path),"subtitle_silent", 0, (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"subtitle_uri" , path, strlen(path),"subtitle_silent", 0, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1828,16 +3308,18 @@ int player_set_subtitle_path(player_h player,const char* path)
 
 int player_set_subtitle_position(player_h player, int millisecond)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_CHECK_CONDITION(millisecond>=0  ,PLAYER_ERROR_INVALID_PARAMETER ,"PLAYER_ERROR_INVALID_PARAMETER" );
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	if (!__player_state_validate(handle, PLAYER_STATE_PLAYING))
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
-	int ret = mm_player_adjust_subtitle_position(handle->mm_handle, MM_PLAYER_POS_FORMAT_TIME, millisecond);
+	int ret = mm_player_adjust_subtitle_position(_player_get_mm_handle(handle), MM_PLAYER_POS_FORMAT_TIME, millisecond);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1848,12 +3330,14 @@ int player_set_subtitle_position(player_h player, int millisecond)
 
 int player_set_progressive_download_path(player_h player, const char *path)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(path);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
 
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"pd_mode", MM_PLAYER_PD_MODE_URI, "pd_location", path, strlen(path), (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"pd_mode", MM_PLAYER_PD_MODE_URI, "pd_location", path, strlen(path), (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1864,19 +3348,21 @@ int player_set_progressive_download_path(player_h player, const char *path)
 
 int player_get_progressive_download_status(player_h player, unsigned long *current, unsigned long *total_size)
 {
+	PLAYER_PROBE_API();
 
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(current);
 	PLAYER_NULL_ARG_CHECK(total_size);
 	player_s * handle = (player_s *) player;
-	if (handle->state != PLAYER_STATE_PLAYING && handle->state != PLAYER_STATE_PAUSED)
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) != PLAYER_STATE_PLAYING && _player_get_state(handle) != PLAYER_STATE_PAUSED)
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 	guint64 _current;
 	guint64 _total;
-	int ret = mm_player_get_pd_status(handle->mm_handle, &_current, &_total);
+	int ret = mm_player_get_pd_status(_player_get_mm_handle(handle), &_current, &_total);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1891,36 +3377,40 @@ int player_get_progressive_download_status(player_h player, unsigned long *curre
 
 int player_capture_video(player_h player, player_video_captured_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(callback);
 
 	player_s * handle = (player_s *) player;
-	if(handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE])
+	PLAYER_MM_GUARD(handle);
+	if(_player_thumbnail_is_running(handle))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : extracting thumbnails" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+	if(_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE))
 	{
 		LOGE("[%s] PLAYER_ERROR_VIDEO_CAPTURE_FAILED (0x%08x) : capturing... we can't do any more " ,__FUNCTION__, PLAYER_ERROR_VIDEO_CAPTURE_FAILED);
 		return PLAYER_ERROR_VIDEO_CAPTURE_FAILED;
 	}
 	else
 	{
-		LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_CAPTURE);
-		handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE] = callback;
-		handle->user_data[_PLAYER_EVENT_TYPE_CAPTURE] = user_data;
+		PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_CAPTURE);
+		_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE, callback, user_data);
 	}
 
-	if(handle->state == PLAYER_STATE_PAUSED || handle->state == PLAYER_STATE_PLAYING )
+	if(_player_get_state(handle) == PLAYER_STATE_PAUSED || _player_get_state(handle) == PLAYER_STATE_PLAYING )
 	{
-		int ret = mm_player_do_video_capture(handle->mm_handle);
+		int ret = mm_player_do_video_capture(_player_get_mm_handle(handle));
 		if(ret==MM_ERROR_PLAYER_NO_OP)
 		{
-			handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
-			handle->user_data[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
+			_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE, NULL, NULL);
 			LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : video display must be set : %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION, handle->display_type);
 			return PLAYER_ERROR_INVALID_OPERATION;
 		}
 		if(ret != MM_ERROR_NONE)
 		{
-			handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
-			handle->user_data[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
+			_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE, NULL, NULL);
 			return __convert_error_code(ret,(char*)__FUNCTION__);
 		}
 		else
@@ -1928,22 +3418,23 @@ int player_capture_video(player_h player, player_video_captured_cb callback, voi
 	}
 	else
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) : current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, handle->state);
-		handle->user_cb[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
-		handle->user_data[_PLAYER_EVENT_TYPE_CAPTURE] = NULL;
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE (0x%08x) : current state - %d" ,__FUNCTION__, PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE, NULL, NULL);
 		return PLAYER_ERROR_INVALID_STATE;
 	}	
 }
 
 int player_set_streaming_cookie(player_h player, const char *cookie, int size)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(cookie);
 	PLAYER_CHECK_CONDITION(size>=0,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
 	
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL,"streaming_cookie", cookie, size, (char*)NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL,"streaming_cookie", cookie, size, (char*)NULL);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1954,18 +3445,20 @@ int player_set_streaming_cookie(player_h player, const char *cookie, int size)
 
 int player_get_streaming_download_progress(player_h player, int *start, int *current)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(start);
 	PLAYER_NULL_ARG_CHECK(current);
 	player_s * handle = (player_s *) player;
-	if (handle->state != PLAYER_STATE_PLAYING && handle->state != PLAYER_STATE_PAUSED)
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) != PLAYER_STATE_PLAYING && _player_get_state(handle) != PLAYER_STATE_PAUSED)
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 	int _current;
 	int _start;
-	int ret = mm_player_get_buffer_position(handle->mm_handle,MM_PLAYER_POS_FORMAT_PERCENT,&_start,&_current);
+	int ret = mm_player_get_buffer_position(_player_get_mm_handle(handle),MM_PLAYER_POS_FORMAT_PERCENT,&_start,&_current);
 	if(ret != MM_ERROR_NONE)
 	{
 		return __convert_error_code(ret,(char*)__FUNCTION__);
@@ -1980,150 +3473,365 @@ int player_get_streaming_download_progress(player_h player, int *start, int *cur
 
 int 	player_set_started_cb (player_h player, player_started_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	return __set_callback(_PLAYER_EVENT_TYPE_BEGIN,player,callback,user_data);
 }
 
 int 	player_unset_started_cb (player_h player)
 {
+	PLAYER_PROBE_API();
 	return __unset_callback(_PLAYER_EVENT_TYPE_BEGIN,player);
 }
 
 int 	player_set_completed_cb (player_h player, player_completed_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	return __set_callback(_PLAYER_EVENT_TYPE_COMPLETE,player,callback,user_data);
 }
 
 int 	player_unset_completed_cb (player_h player)
 {
+	PLAYER_PROBE_API();
 	return __unset_callback(_PLAYER_EVENT_TYPE_COMPLETE,player);
 }
 
 int 	player_set_paused_cb (player_h player, player_paused_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	return __set_callback(_PLAYER_EVENT_TYPE_PAUSE,player,callback,user_data);
 }
 
 int 	player_unset_paused_cb (player_h player)
 {
+	PLAYER_PROBE_API();
 	return __unset_callback(_PLAYER_EVENT_TYPE_PAUSE,player);
 }
 
 int 	player_set_interrupted_cb (player_h player, player_interrupted_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	return __set_callback(_PLAYER_EVENT_TYPE_INTERRUPT,player,callback,user_data);
 }
 
 int 	player_unset_interrupted_cb (player_h player)
 {
+	PLAYER_PROBE_API();
 	return __unset_callback(_PLAYER_EVENT_TYPE_INTERRUPT,player);
 }
 
 int 	player_set_error_cb (player_h player, player_error_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	return __set_callback(_PLAYER_EVENT_TYPE_ERROR,player,callback,user_data);
 }
 
 int 	player_unset_error_cb (player_h player)
 {
+	PLAYER_PROBE_API();
 	return __unset_callback(_PLAYER_EVENT_TYPE_ERROR,player);
 }
 
 int 	player_set_buffering_cb (player_h player, player_buffering_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	return __set_callback(_PLAYER_EVENT_TYPE_BUFFERING,player,callback,user_data);
 }
 
 int 	player_unset_buffering_cb (player_h player)
 {
+	PLAYER_PROBE_API();
 	return __unset_callback(_PLAYER_EVENT_TYPE_BUFFERING,player);
 }
 
 int 	player_set_subtitle_updated_cb(player_h player, player_subtitle_updated_cb callback, void* user_data )
 {
+	PLAYER_PROBE_API();
 	return __set_callback(_PLAYER_EVENT_TYPE_SUBTITLE,player,callback,user_data);
 }
 
 int 	player_unset_subtitle_updated_cb (player_h player)
 {
+	PLAYER_PROBE_API();
 	return __unset_callback(_PLAYER_EVENT_TYPE_SUBTITLE,player);
 }
 
+int player_set_log_level(player_log_level_e level)
+{
+	PLAYER_PROBE_API();
+	PLAYER_CHECK_CONDITION(level>=PLAYER_LOG_LEVEL_ERROR && level<=PLAYER_LOG_LEVEL_TRACE ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	_player_log_level = level;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_set_buffering_coalescing(player_h player, int min_interval, int min_percent_delta)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_CHECK_CONDITION(min_interval>=0 && min_percent_delta>=0 && min_percent_delta<=100 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	__atomic_store_n(&handle->buffering_min_interval, min_interval, __ATOMIC_RELAXED);
+	__atomic_store_n(&handle->buffering_min_delta, min_percent_delta, __ATOMIC_RELAXED);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_get_buffering_event_count(player_h player, unsigned int *delivered, unsigned int *coalesced)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(delivered);
+	PLAYER_NULL_ARG_CHECK(coalesced);
+	player_s * handle = (player_s *) player;
+	*delivered = __atomic_load_n(&handle->buffering_delivered, __ATOMIC_RELAXED);
+	*coalesced = __atomic_load_n(&handle->buffering_coalesced, __ATOMIC_RELAXED);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_get_metadata_cache_stats(player_h player, unsigned int *hits, unsigned int *misses)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(hits);
+	PLAYER_NULL_ARG_CHECK(misses);
+	player_s * handle = (player_s *) player;
+	*hits = __atomic_load_n(&handle->metadata_hits, __ATOMIC_RELAXED);
+	*misses = __atomic_load_n(&handle->metadata_misses, __ATOMIC_RELAXED);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_set_position_interpolation(player_h player, int resync_interval)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_CHECK_CONDITION(resync_interval >= 0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	__atomic_store_n(&handle->position_resync_interval, resync_interval, __ATOMIC_RELAXED);
+	__position_invalidate(handle);
+	PLAYER_INFO("[%s] resync interval : %d",__FUNCTION__, resync_interval);
+	return PLAYER_ERROR_NONE;
+}
+
+int 	player_set_track_changed_cb (player_h player, player_track_changed_cb callback, void *user_data)
+{
+	PLAYER_PROBE_API();
+	return __set_callback(_PLAYER_EVENT_TYPE_TRACK_CHANGED,player,callback,user_data);
+}
+
+int 	player_unset_track_changed_cb (player_h player)
+{
+	PLAYER_PROBE_API();
+	return __unset_callback(_PLAYER_EVENT_TYPE_TRACK_CHANGED,player);
+}
+
+int 	player_set_seek_cancelled_cb (player_h player, player_seek_cancelled_cb callback, void *user_data)
+{
+	PLAYER_PROBE_API();
+	return __set_callback(_PLAYER_EVENT_TYPE_SEEK_CANCELLED,player,callback,user_data);
+}
+
+int 	player_unset_seek_cancelled_cb (player_h player)
+{
+	PLAYER_PROBE_API();
+	return __unset_callback(_PLAYER_EVENT_TYPE_SEEK_CANCELLED,player);
+}
+
 int player_set_video_frame_decoded_cb(player_h player, player_video_frame_decoded_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(callback);
 	player_s * handle = (player_s *) player;
-	if (handle->state != PLAYER_STATE_IDLE  &&  handle->state != PLAYER_STATE_READY)
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) != PLAYER_STATE_IDLE  &&  _player_get_state(handle) != PLAYER_STATE_READY)
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 	
-	int ret = mm_player_set_video_stream_callback(handle->mm_handle, __video_stream_callback, (void*)handle);
+	int ret = mm_player_set_video_stream_callback(_player_get_mm_handle(handle), __video_stream_callback, (void*)handle);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 
-	handle->user_cb[_PLAYER_EVENT_TYPE_VIDEO_FRAME] = callback;
-	handle->user_data[_PLAYER_EVENT_TYPE_VIDEO_FRAME] = user_data;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_VIDEO_FRAME);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME, callback, user_data);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_VIDEO_FRAME);
 	return PLAYER_ERROR_NONE;
 }
 
 int player_unset_video_frame_decoded_cb(player_h player)
 {
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME, NULL, NULL);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_VIDEO_FRAME);
+	if(_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF))
+		return PLAYER_ERROR_NONE;
+	int ret = mm_player_set_video_stream_callback(_player_get_mm_handle(handle), NULL, NULL);
+	if(ret != MM_ERROR_NONE)
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	else
+		return PLAYER_ERROR_NONE;
+}
+
+int player_extract_thumbnails(player_h player, const int *positions, int count, int width, int height, player_thumbnail_extracted_cb callback, void *user_data)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(positions);
+	PLAYER_NULL_ARG_CHECK(callback);
+	PLAYER_CHECK_CONDITION(count>0 && width>0 && height>0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	int i;
+	for(i = 0; i < count; i++)
+		PLAYER_CHECK_CONDITION(positions[i]>=0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+
+	if (_player_get_state(handle) != PLAYER_STATE_READY  &&  _player_get_state(handle) != PLAYER_STATE_PAUSED)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+	if(__seek_is_in_flight(handle) || _player_has_user_cb(handle, _PLAYER_EVENT_TYPE_CAPTURE) || _player_thumbnail_is_running(handle))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION (0x%08x) : seeking or capturing" ,__FUNCTION__, PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+
+	// without a display, the frames come from the video stream callback
+	bool headless = handle->display_type == (int)MM_DISPLAY_SURFACE_NULL;
+	bool own_stream_callback = FALSE;
+	int ret;
+	if(headless && !_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME) && !_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF))
+	{
+		ret = mm_player_set_video_stream_callback(_player_get_mm_handle(handle), __video_stream_callback, (void*)handle);
+		if(ret != MM_ERROR_NONE)
+			return __convert_error_code(ret,(char*)__FUNCTION__);
+		own_stream_callback = TRUE;
+	}
+
+	ret = _player_thumbnail_start(handle, positions, count, width, height, headless, own_stream_callback, callback, user_data);
+	if(ret != PLAYER_ERROR_NONE && own_stream_callback)
+		mm_player_set_video_stream_callback(_player_get_mm_handle(handle), NULL, NULL);
+	return ret;
+}
+
+int player_cancel_thumbnails(player_h player)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	_player_thumbnail_stop(handle);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_set_video_frame_cb(player_h player, player_video_frame_cb callback, void *user_data)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(callback);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) != PLAYER_STATE_IDLE  &&  _player_get_state(handle) != PLAYER_STATE_READY)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+
+	if(__atomic_load_n(&handle->frame_pool, __ATOMIC_ACQUIRE) == NULL)
+	{
+		_player_frame_pool_s *pool = _player_frame_pool_create(PLAYER_VIDEO_FRAME_POOL_SIZE);
+		_player_frame_pool_s *expected = NULL;
+		if(pool == NULL)
+		{
+			LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+			return PLAYER_ERROR_OUT_OF_MEMORY;
+		}
+		// the streaming thread may already run, the pool is published once and kept until the reset
+		if(!__atomic_compare_exchange_n(&handle->frame_pool, &expected, pool, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			_player_frame_pool_release(pool);
+	}
+
+	int ret = mm_player_set_video_stream_callback(_player_get_mm_handle(handle), __video_stream_callback, (void*)handle);
+	if(ret != MM_ERROR_NONE)
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF, callback, user_data);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_unset_video_frame_cb(player_h player)
+{
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
-	handle->user_cb[_PLAYER_EVENT_TYPE_VIDEO_FRAME] = NULL;
-	handle->user_data[_PLAYER_EVENT_TYPE_VIDEO_FRAME] = NULL;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_VIDEO_FRAME);
-	int ret = mm_player_set_video_stream_callback(handle->mm_handle, NULL, NULL);
+	PLAYER_MM_GUARD(handle);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF, NULL, NULL);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_VIDEO_FRAME_REF);
+	if(_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_VIDEO_FRAME))
+		return PLAYER_ERROR_NONE;
+	int ret = mm_player_set_video_stream_callback(_player_get_mm_handle(handle), NULL, NULL);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
 		return PLAYER_ERROR_NONE;
 }
 
+int player_get_video_frame_drop_count(player_h player, unsigned int *count)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(count);
+	player_s * handle = (player_s *) player;
+	*count = _player_frame_pool_get_dropped(__atomic_load_n(&handle->frame_pool, __ATOMIC_ACQUIRE));
+	return PLAYER_ERROR_NONE;
+}
+
 int player_set_audio_frame_decoded_cb(player_h player, int start, int end, player_audio_frame_decoded_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(callback);
 	PLAYER_CHECK_CONDITION(start>=0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 	PLAYER_CHECK_CONDITION(end>=start ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 	player_s * handle = (player_s *) player;
-	if (handle->state != PLAYER_STATE_IDLE  &&  handle->state != PLAYER_STATE_READY)
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) != PLAYER_STATE_IDLE  &&  _player_get_state(handle) != PLAYER_STATE_READY)
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL, "pcm_extraction",TRUE, "pcm_extraction_start_msec", start, "pcm_extraction_end_msec", end, NULL);	
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "pcm_extraction",TRUE, "pcm_extraction_start_msec", start, "pcm_extraction_end_msec", end, NULL);	
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	
-	ret = mm_player_set_audio_stream_callback(handle->mm_handle, __audio_stream_callback, (void*)handle);
+	ret = mm_player_set_audio_stream_callback(_player_get_mm_handle(handle), __audio_stream_callback, (void*)handle);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 
-	handle->user_cb[_PLAYER_EVENT_TYPE_AUDIO_FRAME] = callback;
-	handle->user_data[_PLAYER_EVENT_TYPE_AUDIO_FRAME] = user_data;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_AUDIO_FRAME);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_AUDIO_FRAME, callback, user_data);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_AUDIO_FRAME);
 	return PLAYER_ERROR_NONE;
 }
 
 int player_unset_audio_frame_decoded_cb(player_h player)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
 
-	handle->user_cb[_PLAYER_EVENT_TYPE_AUDIO_FRAME] = NULL;
-	handle->user_data[_PLAYER_EVENT_TYPE_AUDIO_FRAME] = NULL;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_AUDIO_FRAME);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_AUDIO_FRAME, NULL, NULL);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_AUDIO_FRAME);
+	if(__atomic_load_n(&handle->pcm_ring, __ATOMIC_ACQUIRE))
+		return PLAYER_ERROR_NONE;
 
-	int ret = mm_player_set_attribute(handle->mm_handle, NULL, "pcm_extraction",FALSE, NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "pcm_extraction",FALSE, NULL);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	
-	ret = mm_player_set_audio_buffer_callback(handle->mm_handle, NULL, NULL);
+	ret = mm_player_set_audio_buffer_callback(_player_get_mm_handle(handle), NULL, NULL);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 	else
@@ -2132,37 +3840,188 @@ int player_unset_audio_frame_decoded_cb(player_h player)
 
 int player_set_progressive_download_message_cb(player_h player, player_pd_message_cb callback, void *user_data)
 {
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
 	PLAYER_NULL_ARG_CHECK(callback);
 	player_s * handle = (player_s *) player;
-	if (handle->state != PLAYER_STATE_IDLE  &&  handle->state != PLAYER_STATE_READY)
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) != PLAYER_STATE_IDLE  &&  _player_get_state(handle) != PLAYER_STATE_READY)
 	{
-		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, handle->state);
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
 		return PLAYER_ERROR_INVALID_STATE;
 	}
 
-	int ret = mm_player_set_pd_message_callback(handle->mm_handle, __pd_message_callback, (void*)handle);
+	int ret = mm_player_set_pd_message_callback(_player_get_mm_handle(handle), __pd_message_callback, (void*)handle);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
 
-	handle->user_cb[_PLAYER_EVENT_TYPE_PD] = callback;
-	handle->user_data[_PLAYER_EVENT_TYPE_PD] = user_data;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_PD);
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PD, callback, user_data);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_PD);
 	return PLAYER_ERROR_NONE;
 }
 
 int player_unset_progressive_download_message_cb(player_h player)
 {
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+
+	_player_set_user_cb(handle, _PLAYER_EVENT_TYPE_PD, NULL, NULL);
+	PLAYER_INFO("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_PD);
+
+	int ret = mm_player_set_pd_message_callback(_player_get_mm_handle(handle), NULL, NULL);
+	if(ret != MM_ERROR_NONE)
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	else
+		return PLAYER_ERROR_NONE;
+}
+
+int player_audio_pcm_open(player_h player, int start, int end, unsigned int buffer_size, player_audio_pcm_overflow_e policy)
+{
+	PLAYER_PROBE_API();
 	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_CHECK_CONDITION(start>=0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	PLAYER_CHECK_CONDITION(end>=start ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	PLAYER_CHECK_CONDITION(buffer_size>0 ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
+	PLAYER_CHECK_CONDITION(policy>=PLAYER_AUDIO_PCM_OVERFLOW_BLOCK && policy<=PLAYER_AUDIO_PCM_OVERFLOW_DROP_NEWEST ,PLAYER_ERROR_INVALID_PARAMETER,"PLAYER_ERROR_INVALID_PARAMETER" );
 	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if (_player_get_state(handle) != PLAYER_STATE_IDLE  &&  _player_get_state(handle) != PLAYER_STATE_READY)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+	if(__atomic_load_n(&handle->pcm_ring, __ATOMIC_ACQUIRE))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x) : already opened" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+
+	_player_pcm_ring_s *ring = _player_pcm_ring_create(buffer_size, policy);
+	if(ring == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+		return PLAYER_ERROR_OUT_OF_MEMORY;
+	}
+
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "pcm_extraction",TRUE, "pcm_extraction_start_msec", start, "pcm_extraction_end_msec", end, NULL);
+	if(ret == MM_ERROR_NONE)
+		ret = mm_player_set_audio_stream_callback(_player_get_mm_handle(handle), __audio_stream_callback, (void*)handle);
+	if(ret != MM_ERROR_NONE)
+	{
+		_player_pcm_ring_destroy(ring);
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	}
 
-	handle->user_cb[_PLAYER_EVENT_TYPE_PD] = NULL;
-	handle->user_data[_PLAYER_EVENT_TYPE_PD] = NULL;
-	LOGI("[%s] Event type : %d ",__FUNCTION__, _PLAYER_EVENT_TYPE_PD);
+	handle->pcm_start = start;
+	__atomic_store_n(&handle->pcm_bytes_per_sec, 0, __ATOMIC_RELAXED);
+	pthread_mutex_lock(&handle->pcm_lock);
+	__atomic_store_n(&handle->pcm_ring, ring, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&handle->pcm_lock);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_audio_pcm_close(player_h player)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if(!__pcm_ring_release(handle))
+		return PLAYER_ERROR_NONE;
+	if(_player_has_user_cb(handle, _PLAYER_EVENT_TYPE_AUDIO_FRAME))
+		return PLAYER_ERROR_NONE;
 
-	int ret = mm_player_set_pd_message_callback(handle->mm_handle, NULL, NULL);
+	int ret = mm_player_set_attribute(_player_get_mm_handle(handle), NULL, "pcm_extraction",FALSE, NULL);
 	if(ret != MM_ERROR_NONE)
 		return __convert_error_code(ret,(char*)__FUNCTION__);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_audio_pcm_read(player_h player, void *buffer, unsigned int max_bytes, unsigned int *read_bytes, int *pts, int timeout)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(buffer);
+	PLAYER_NULL_ARG_CHECK(read_bytes);
+	PLAYER_NULL_ARG_CHECK(pts);
+	player_s * handle = (player_s *) player;
+	_player_pcm_ring_s *ring = __pcm_ring_get(handle);
+	if(ring == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x) : not opened" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+
+	uint64_t position = 0;
+	int ret = _player_pcm_ring_read(ring, buffer, max_bytes, read_bytes, &position, timeout);
+	_player_pcm_ring_unref(ring);
+	if(ret != PLAYER_ERROR_NONE)
+		return ret;
+
+	int bytes_per_sec = __get_pcm_bytes_per_sec(handle);
+	if(bytes_per_sec > 0)
+		*pts = handle->pcm_start + (int)(position * 1000 / bytes_per_sec);
 	else
+		*pts = handle->pcm_start;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_audio_pcm_get_stats(player_h player, unsigned int *underruns, unsigned int *overruns)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(underruns);
+	PLAYER_NULL_ARG_CHECK(overruns);
+	player_s * handle = (player_s *) player;
+	_player_pcm_ring_s *ring = __pcm_ring_get(handle);
+	if(ring == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x) : not opened" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+	_player_pcm_ring_get_stats(ring, underruns, overruns);
+	_player_pcm_ring_unref(ring);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_set_fast_decoding(player_h player, bool enable)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	PLAYER_STATE_CHECK(handle,PLAYER_STATE_IDLE);
+
+	int ret = mm_player_set_pcm_extraction_mode(_player_get_mm_handle(handle), !enable);
+	if(ret != MM_ERROR_NONE)
+		return __convert_error_code(ret,(char*)__FUNCTION__);
+	__atomic_store_n(&handle->pcm_decoded_bytes, 0, __ATOMIC_RELAXED);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_get_decoding_speed(player_h player, float *ratio)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(ratio);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	if (!__player_state_validate(handle, PLAYER_STATE_READY))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+
+	uint64_t decoded_bytes = __atomic_load_n(&handle->pcm_decoded_bytes, __ATOMIC_ACQUIRE);
+	int64_t elapsed = __atomic_load_n(&handle->pcm_last_time, __ATOMIC_RELAXED) - __atomic_load_n(&handle->pcm_first_time, __ATOMIC_RELAXED);
+	int bytes_per_sec = __get_pcm_bytes_per_sec(handle);
+	if(decoded_bytes == 0 || elapsed <= 0 || bytes_per_sec <= 0)
+	{
+		*ratio = 0;
 		return PLAYER_ERROR_NONE;
+	}
+	*ratio = (float)((double)decoded_bytes * 1000 / bytes_per_sec / elapsed);
+	return PLAYER_ERROR_NONE;
 }
@@ -0,0 +1,575 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <glib.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+/*
+* The queue is an intrusive multi-producer single-consumer list: producers (the
+* mm-player threads) only swap the head, the dispatcher is the only one to walk
+* from the tail. A stub node keeps the list non-empty so that neither side needs a lock.
+* handle->dispatcher is only swapped under dispatch_lock, and the producers hold a
+* reference while they push, so releasing the dispatcher never frees it under them.
+* The statistics are written by the draining side only.
+*/
+struct _player_dispatcher_s{
+	player_dispatch_mode_e mode;
+	_player_event_s *head;
+	_player_event_s *tail;
+	_player_event_s stub;
+	int depth;
+	int max_depth;
+	int64_t max_latency;
+	unsigned int dispatched;
+	int refcount;
+	int quit;
+	int scheduled;
+	sem_t wakeup;
+	pthread_t thread;
+	GMainContext *context;
+};
+
+/*
+* Internal Implementation
+*/
+
+static int64_t __now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void __queue_push(_player_dispatcher_s *d, _player_event_s *ev)
+{
+	_player_event_s *prev;
+
+	__atomic_store_n(&ev->next, NULL, __ATOMIC_RELAXED);
+	prev = __atomic_exchange_n(&d->head, ev, __ATOMIC_ACQ_REL);
+	__atomic_store_n(&prev->next, ev, __ATOMIC_RELEASE);
+}
+
+static _player_event_s* __queue_pop(_player_dispatcher_s *d)
+{
+	_player_event_s *tail = d->tail;
+	_player_event_s *next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+
+	if(tail == &d->stub)
+	{
+		if(next == NULL)
+			return NULL;
+		d->tail = next;
+		tail = next;
+		next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+	}
+	if(next)
+	{
+		d->tail = next;
+		return tail;
+	}
+	// a producer is between the swap and the link, it will wake us up again
+	if(tail != __atomic_load_n(&d->head, __ATOMIC_ACQUIRE))
+		return NULL;
+
+	__queue_push(d, &d->stub);
+	next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+	if(next)
+	{
+		d->tail = next;
+		return tail;
+	}
+	return NULL;
+}
+
+static void __free_event(_player_event_s *ev)
+{
+	if(ev->data)
+		free(ev->data);
+	free(ev);
+}
+
+static void __dispatcher_unref(_player_dispatcher_s *d)
+{
+	if(__atomic_sub_fetch(&d->refcount, 1, __ATOMIC_ACQ_REL) > 0)
+		return;
+
+	_player_event_s *ev;
+	while((ev = __queue_pop(d)) != NULL)
+		__free_event(ev);
+
+	if(d->context)
+		g_main_context_unref(d->context);
+	sem_destroy(&d->wakeup);
+	free(d);
+}
+
+static void __dispatcher_drain(_player_dispatcher_s *d)
+{
+	_player_event_s *ev;
+
+	while((ev = __queue_pop(d)) != NULL)
+	{
+		__atomic_sub_fetch(&d->depth, 1, __ATOMIC_RELAXED);
+		if(!__atomic_load_n(&d->quit, __ATOMIC_ACQUIRE))
+		{
+			int64_t latency = __now_us() - ev->enqueued;
+			if(latency > __atomic_load_n(&d->max_latency, __ATOMIC_RELAXED))
+				__atomic_store_n(&d->max_latency, latency, __ATOMIC_RELAXED);
+			_player_invoke_event(ev);
+			__atomic_add_fetch(&d->dispatched, 1, __ATOMIC_RELAXED);
+		}
+		__free_event(ev);
+	}
+}
+
+static void* __dispatcher_thread(void *data)
+{
+	_player_dispatcher_s *d = (_player_dispatcher_s*)data;
+
+	while(!__atomic_load_n(&d->quit, __ATOMIC_ACQUIRE))
+	{
+		if(sem_wait(&d->wakeup) != 0)
+		{
+			if(errno == EINTR)
+				continue;
+			LOGE("[%s] sem_wait failed (%d)", __FUNCTION__, errno);
+			break;
+		}
+		__dispatcher_drain(d);
+	}
+	__dispatcher_unref(d);
+	return NULL;
+}
+
+static gboolean __dispatcher_idle(gpointer data)
+{
+	_player_dispatcher_s *d = (_player_dispatcher_s*)data;
+
+	// cleared first, so that an event pushed while draining schedules a new source
+	__atomic_store_n(&d->scheduled, 0, __ATOMIC_RELEASE);
+	__dispatcher_drain(d);
+	__dispatcher_unref(d);
+	return FALSE;
+}
+
+static void __dispatcher_wakeup(_player_dispatcher_s *d)
+{
+	if(d->mode == PLAYER_DISPATCH_MODE_THREAD)
+	{
+		sem_post(&d->wakeup);
+		return;
+	}
+
+	int expected = 0;
+	if(__atomic_compare_exchange_n(&d->scheduled, &expected, 1, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+	{
+		__atomic_add_fetch(&d->refcount, 1, __ATOMIC_ACQ_REL);
+		GSource *source = g_idle_source_new();
+		g_source_set_callback(source, __dispatcher_idle, d, NULL);
+		g_source_attach(source, d->context);
+		g_source_unref(source);
+	}
+}
+
+static int __dispatcher_create(player_dispatch_mode_e mode, void *context, _player_dispatcher_s **dispatcher)
+{
+	_player_dispatcher_s *d = (_player_dispatcher_s*)calloc(1, sizeof(_player_dispatcher_s));
+	if(d == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+		return PLAYER_ERROR_OUT_OF_MEMORY;
+	}
+	d->mode = mode;
+	d->head = &d->stub;
+	d->tail = &d->stub;
+	d->refcount = 1;
+	sem_init(&d->wakeup, 0, 0);
+
+	if(mode == PLAYER_DISPATCH_MODE_THREAD)
+	{
+		d->refcount++;
+		if(pthread_create(&d->thread, NULL, __dispatcher_thread, d) != 0)
+		{
+			LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x) : failed to create the dispatcher thread" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION);
+			sem_destroy(&d->wakeup);
+			free(d);
+			return PLAYER_ERROR_INVALID_OPERATION;
+		}
+	}
+	else if(context)
+	{
+		d->context = g_main_context_ref((GMainContext*)context);
+	}
+
+	*dispatcher = d;
+	return PLAYER_ERROR_NONE;
+}
+
+static _player_dispatcher_s* __dispatcher_get(player_s *handle)
+{
+	_player_dispatcher_s *d;
+	if(__atomic_load_n(&handle->dispatcher, __ATOMIC_ACQUIRE) == NULL)
+		return NULL;
+	pthread_mutex_lock(&handle->dispatch_lock);
+	d = handle->dispatcher;
+	if(d)
+		__atomic_add_fetch(&d->refcount, 1, __ATOMIC_ACQ_REL);
+	pthread_mutex_unlock(&handle->dispatch_lock);
+	return d;
+}
+
+/*
+* Internal functions shared with player.c
+*/
+
+void _player_invoke_event(const _player_event_s *ev)
+{
+	switch(ev->type)
+	{
+		case _PLAYER_EVENT_TYPE_BEGIN:
+		case _PLAYER_EVENT_TYPE_PREPARE:
+		case _PLAYER_EVENT_TYPE_COMPLETE:
+		case _PLAYER_EVENT_TYPE_PAUSE:
+		case _PLAYER_EVENT_TYPE_TRACK_CHANGED:
+			((player_completed_cb)ev->callback)(ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_SEEK:
+			// arg1 tells a seek from player_set_position_ex(), which reports the position reached in arg0
+			if(ev->arg1)
+				((player_seek_completed_ex_cb)ev->callback)((int)ev->arg0, ev->user_data);
+			else
+				((player_seek_completed_cb)ev->callback)(ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_INTERRUPT:
+			((player_interrupted_cb)ev->callback)((player_interrupted_code_e)ev->arg0, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_ERROR:
+			((player_error_cb)ev->callback)((int)ev->arg0, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_BUFFERING:
+			((player_buffering_cb)ev->callback)((int)ev->arg0, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_SUBTITLE:
+			((player_subtitle_updated_cb)ev->callback)((unsigned long)ev->arg0, (char*)ev->data, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_CAPTURE:
+			((player_video_captured_cb)ev->callback)((unsigned char*)ev->data, (int)ev->arg0, (int)ev->arg1, ev->size, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_PD:
+			((player_pd_message_cb)ev->callback)((player_pd_message_type_e)ev->arg0, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_PUSH_NEED_DATA:
+			((player_push_need_data_cb)ev->callback)((unsigned int)ev->arg0, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_PUSH_ENOUGH_DATA:
+			((player_push_enough_data_cb)ev->callback)(ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_SEEK_CANCELLED:
+			((player_seek_cancelled_cb)ev->callback)((void*)(intptr_t)ev->arg0, ev->user_data);
+			break;
+		case _PLAYER_EVENT_TYPE_LISTENER:
+			((player_event_cb)ev->callback)((player_event_e)ev->arg0, (int)ev->arg1, ev->user_data);
+			break;
+		default:
+			LOGE("[%s] Not dispatchable event type : %d", __FUNCTION__, ev->type);
+			break;
+	}
+}
+
+static void __post(player_s *handle, _player_event_e type, const void *callback, void *user_data, long arg0, long arg1, const void *data, unsigned int size)
+{
+	_player_dispatcher_s *d = __dispatcher_get(handle);
+
+	if(d == NULL)
+	{
+		_player_event_s ev = {NULL, type, callback, user_data, arg0, arg1, (void*)data, size, 0};
+		_player_invoke_event(&ev);
+		return;
+	}
+
+	_player_event_s *ev = (_player_event_s*)calloc(1, sizeof(_player_event_s));
+	if(ev && data && size > 0)
+	{
+		ev->data = malloc(size);
+		if(ev->data)
+			memcpy(ev->data, data, size);
+		else
+		{
+			free(ev);
+			ev = NULL;
+		}
+	}
+	if(ev == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x) : event type %d is dropped" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY, type);
+		__dispatcher_unref(d);
+		return;
+	}
+	ev->type = type;
+	ev->callback = callback;
+	ev->user_data = user_data;
+	ev->arg0 = arg0;
+	ev->arg1 = arg1;
+	ev->size = size;
+	ev->enqueued = __now_us();
+
+	__queue_push(d, ev);
+
+	int depth = __atomic_add_fetch(&d->depth, 1, __ATOMIC_RELAXED);
+	int max_depth = __atomic_load_n(&d->max_depth, __ATOMIC_RELAXED);
+	while(depth > max_depth && !__atomic_compare_exchange_n(&d->max_depth, &max_depth, depth, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	__dispatcher_wakeup(d);
+	__dispatcher_unref(d);
+}
+
+/* The listener events of each event type, 0 for the types listeners cannot subscribe to */
+static const unsigned int __listener_events[_PLAYER_EVENT_TYPE_NUM] = {
+	[_PLAYER_EVENT_TYPE_BEGIN] = PLAYER_EVENT_STARTED,
+	[_PLAYER_EVENT_TYPE_COMPLETE] = PLAYER_EVENT_COMPLETED,
+	[_PLAYER_EVENT_TYPE_PAUSE] = PLAYER_EVENT_PAUSED,
+	[_PLAYER_EVENT_TYPE_INTERRUPT] = PLAYER_EVENT_INTERRUPTED,
+	[_PLAYER_EVENT_TYPE_ERROR] = PLAYER_EVENT_ERROR,
+	[_PLAYER_EVENT_TYPE_BUFFERING] = PLAYER_EVENT_BUFFERING,
+	[_PLAYER_EVENT_TYPE_SEEK] = PLAYER_EVENT_SEEK_COMPLETED,
+	[_PLAYER_EVENT_TYPE_PD] = PLAYER_EVENT_PD,
+	[_PLAYER_EVENT_TYPE_TRACK_CHANGED] = PLAYER_EVENT_TRACK_CHANGED,
+};
+
+static void __post_listeners(player_s *handle, unsigned int event, long value)
+{
+	int i;
+	for(i = 0; i < PLAYER_EVENT_LISTENER_MAX; i++)
+	{
+		_player_listener_s *l = &handle->listeners[i];
+		unsigned int seq;
+		unsigned int mask;
+		const void *callback;
+		void *user_data;
+		do
+		{
+			seq = __atomic_load_n(&l->seq, __ATOMIC_ACQUIRE);
+			mask = __atomic_load_n(&l->mask, __ATOMIC_RELAXED);
+			callback = __atomic_load_n(&l->callback, __ATOMIC_RELAXED);
+			user_data = __atomic_load_n(&l->user_data, __ATOMIC_RELAXED);
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		} while((seq & 1) || seq != __atomic_load_n(&l->seq, __ATOMIC_RELAXED));
+
+		if(callback && (mask & event))
+			__post(handle, _PLAYER_EVENT_TYPE_LISTENER, callback, user_data, event, value, NULL, 0);
+	}
+}
+
+void _player_post_event(player_s *handle, _player_event_e type, long arg0, long arg1, const void *data, unsigned int size)
+{
+	void *user_data = NULL;
+	const void *callback = _player_get_user_cb(handle, type, &user_data);
+	_player_post_callback(handle, type, callback, user_data, arg0, arg1, data, size);
+}
+
+void _player_post_callback(player_s *handle, _player_event_e type, const void *callback, void *user_data, long arg0, long arg1, const void *data, unsigned int size)
+{
+	unsigned int event = __listener_events[type] & __atomic_load_n(&handle->listener_mask, __ATOMIC_ACQUIRE);
+
+	if(callback)
+		__post(handle, type, callback, user_data, arg0, arg1, data, size);
+	if(event)
+		__post_listeners(handle, event, arg0);
+}
+
+bool _player_wants_event(player_s *handle, _player_event_e type)
+{
+	if(__listener_events[type] & __atomic_load_n(&handle->listener_mask, __ATOMIC_RELAXED))
+		return TRUE;
+	return _player_has_user_cb(handle, type);
+}
+
+/* Called with listener_lock held, the readers retry while the sequence is odd */
+static void __listener_set(player_s *handle, int id, unsigned int mask, const void *callback, void *user_data)
+{
+	_player_listener_s *l = &handle->listeners[id];
+	unsigned int seq = l->seq;
+	unsigned int listener_mask = 0;
+	int i;
+
+	__atomic_store_n(&l->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&l->mask, mask, __ATOMIC_RELAXED);
+	__atomic_store_n(&l->callback, callback, __ATOMIC_RELAXED);
+	__atomic_store_n(&l->user_data, user_data, __ATOMIC_RELAXED);
+	__atomic_store_n(&l->seq, seq + 2, __ATOMIC_RELEASE);
+
+	for(i = 0; i < PLAYER_EVENT_LISTENER_MAX; i++)
+		listener_mask |= handle->listeners[i].mask;
+	__atomic_store_n(&handle->listener_mask, listener_mask, __ATOMIC_RELEASE);
+}
+
+void _player_listener_clear(player_s *handle)
+{
+	int i;
+	pthread_mutex_lock(&handle->listener_lock);
+	for(i = 0; i < PLAYER_EVENT_LISTENER_MAX; i++)
+	{
+		if(handle->listeners[i].callback)
+			__listener_set(handle, i, 0, NULL, NULL);
+	}
+	pthread_mutex_unlock(&handle->listener_lock);
+}
+
+void _player_dispatcher_release(player_s *handle)
+{
+	pthread_mutex_lock(&handle->dispatch_lock);
+	_player_dispatcher_s *d = handle->dispatcher;
+	__atomic_store_n(&handle->dispatcher, NULL, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&handle->dispatch_lock);
+	if(d == NULL)
+		return;
+
+	__atomic_store_n(&d->quit, 1, __ATOMIC_RELEASE);
+	if(d->mode == PLAYER_DISPATCH_MODE_THREAD)
+	{
+		sem_post(&d->wakeup);
+		// the handle may be destroyed from one of its own callbacks
+		if(pthread_equal(pthread_self(), d->thread))
+			pthread_detach(d->thread);
+		else
+			pthread_join(d->thread, NULL);
+	}
+	__dispatcher_unref(d);
+}
+
+/*
+* Public Implementation
+*/
+
+int player_set_dispatch_mode(player_h player, player_dispatch_mode_e mode, void *context)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+	if(mode < PLAYER_DISPATCH_MODE_SYNC || mode > PLAYER_DISPATCH_MODE_MAIN_CONTEXT)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : mode %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, mode);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+	if(_player_get_state(handle) != PLAYER_STATE_IDLE)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_STATE(0x%08x) : current state - %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_STATE, _player_get_state(handle));
+		return PLAYER_ERROR_INVALID_STATE;
+	}
+
+	_player_dispatcher_release(handle);
+	if(mode == PLAYER_DISPATCH_MODE_SYNC)
+		return PLAYER_ERROR_NONE;
+
+	_player_dispatcher_s *d = NULL;
+	int ret = __dispatcher_create(mode, context, &d);
+	if(ret != PLAYER_ERROR_NONE)
+		return ret;
+	pthread_mutex_lock(&handle->dispatch_lock);
+	__atomic_store_n(&handle->dispatcher, d, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&handle->dispatch_lock);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_get_dispatch_stats(player_h player, player_dispatch_stats_s *stats)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(stats);
+	player_s * handle = (player_s *) player;
+	_player_dispatcher_s *d = __dispatcher_get(handle);
+
+	memset(stats, 0, sizeof(player_dispatch_stats_s));
+	if(d)
+	{
+		stats->queue_depth = __atomic_load_n(&d->depth, __ATOMIC_RELAXED);
+		stats->max_queue_depth = __atomic_load_n(&d->max_depth, __ATOMIC_RELAXED);
+		stats->max_latency = (int)__atomic_load_n(&d->max_latency, __ATOMIC_RELAXED);
+		stats->dispatched = __atomic_load_n(&d->dispatched, __ATOMIC_RELAXED);
+		__dispatcher_unref(d);
+	}
+	return PLAYER_ERROR_NONE;
+}
+
+int player_add_event_listener(player_h player, unsigned int event_mask, player_event_cb callback, void *user_data, int *id)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(callback);
+	PLAYER_NULL_ARG_CHECK(id);
+	player_s * handle = (player_s *) player;
+	int i;
+
+	if(event_mask == 0 || (event_mask & ~PLAYER_EVENT_ALL))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : event mask 0x%x" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, event_mask);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+
+	pthread_mutex_lock(&handle->listener_lock);
+	for(i = 0; i < PLAYER_EVENT_LISTENER_MAX; i++)
+	{
+		if(handle->listeners[i].callback == NULL)
+			break;
+	}
+	if(i == PLAYER_EVENT_LISTENER_MAX)
+	{
+		pthread_mutex_unlock(&handle->listener_lock);
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x) : %d listeners already" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION, PLAYER_EVENT_LISTENER_MAX);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+	__listener_set(handle, i, event_mask, callback, user_data);
+	pthread_mutex_unlock(&handle->listener_lock);
+
+	*id = i;
+	PLAYER_INFO("[%s] Listener %d, event mask : 0x%x", __FUNCTION__, i, event_mask);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_remove_event_listener(player_h player, int id)
+{
+	PLAYER_PROBE_API();
+	PLAYER_INSTANCE_CHECK(player);
+	player_s * handle = (player_s *) player;
+
+	pthread_mutex_lock(&handle->listener_lock);
+	if(id < 0 || id >= PLAYER_EVENT_LISTENER_MAX || handle->listeners[id].callback == NULL)
+	{
+		pthread_mutex_unlock(&handle->listener_lock);
+		LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : no listener %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, id);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+	__listener_set(handle, id, 0, NULL, NULL);
+	pthread_mutex_unlock(&handle->listener_lock);
+
+	PLAYER_INFO("[%s] Listener %d", __FUNCTION__, id);
+	return PLAYER_ERROR_NONE;
+}
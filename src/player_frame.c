@@ -0,0 +1,296 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+typedef struct player_video_frame_s{
+	struct player_video_frame_s *next_free;
+	_player_frame_pool_s *pool;
+	int refcount;
+	unsigned char *data;
+	unsigned int capacity;
+	unsigned int size;
+	int width;
+	int height;
+	player_video_frame_format_e format;
+	int timestamp;
+} player_video_frame_s;
+
+/*
+* Frames hold a reference on their pool, so the application may keep them
+* after the player which produced them has been destroyed.
+*/
+struct _player_frame_pool_s{
+	pthread_mutex_t lock;
+	player_video_frame_s *free_list;
+	int allocated;
+	int max_frames;
+	int refcount;
+	unsigned int dropped;
+};
+
+/*
+* Internal Implementation
+*/
+
+static void __frame_pool_unref(_player_frame_pool_s *pool)
+{
+	if(__atomic_sub_fetch(&pool->refcount, 1, __ATOMIC_ACQ_REL) > 0)
+		return;
+
+	player_video_frame_s *frame = pool->free_list;
+	while(frame)
+	{
+		player_video_frame_s *next = frame->next_free;
+		free(frame->data);
+		free(frame);
+		frame = next;
+	}
+	pthread_mutex_destroy(&pool->lock);
+	free(pool);
+}
+
+/*
+* Internal functions shared with player.c
+*/
+
+/* The bytes a frame of the format needs without padding, 0 when the format is unknown */
+unsigned int _player_video_frame_get_min_size(player_video_frame_format_e format, int width, int height)
+{
+	unsigned int pixels = (unsigned int)width * height;
+	unsigned int chroma = (unsigned int)((width + 1) / 2) * ((height + 1) / 2);
+
+	if(width <= 0 || height <= 0)
+		return 0;
+	switch(format)
+	{
+		case PLAYER_VIDEO_FRAME_FORMAT_I420:
+			return pixels + chroma * 2;
+		case PLAYER_VIDEO_FRAME_FORMAT_RGB565:
+			return pixels * 2;
+		case PLAYER_VIDEO_FRAME_FORMAT_ARGB8888:
+			return pixels * 4;
+		case PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN:
+		default:
+			return 0;
+	}
+}
+
+_player_frame_pool_s* _player_frame_pool_create(int max_frames)
+{
+	_player_frame_pool_s *pool = (_player_frame_pool_s*)calloc(1, sizeof(_player_frame_pool_s));
+	if(pool == NULL)
+		return NULL;
+	pthread_mutex_init(&pool->lock, NULL);
+	pool->max_frames = max_frames;
+	pool->refcount = 1;
+	return pool;
+}
+
+void _player_frame_pool_release(_player_frame_pool_s *pool)
+{
+	if(pool)
+		__frame_pool_unref(pool);
+}
+
+unsigned int _player_frame_pool_get_dropped(_player_frame_pool_s *pool)
+{
+	return pool ? __atomic_load_n(&pool->dropped, __ATOMIC_RELAXED) : 0;
+}
+
+player_video_frame_h _player_frame_pool_get(_player_frame_pool_s *pool, const void *data, unsigned int size, int width, int height, player_video_frame_format_e format, int timestamp)
+{
+	player_video_frame_s *frame = NULL;
+
+	pthread_mutex_lock(&pool->lock);
+	if(pool->free_list)
+	{
+		frame = pool->free_list;
+		pool->free_list = frame->next_free;
+	}
+	else if(pool->allocated < pool->max_frames)
+	{
+		frame = (player_video_frame_s*)calloc(1, sizeof(player_video_frame_s));
+		if(frame)
+			pool->allocated++;
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	if(frame && frame->capacity < size)
+	{
+		unsigned char *buffer = (unsigned char*)realloc(frame->data, size);
+		if(buffer)
+		{
+			frame->data = buffer;
+			frame->capacity = size;
+		}
+		else
+		{
+			pthread_mutex_lock(&pool->lock);
+			frame->next_free = pool->free_list;
+			pool->free_list = frame;
+			pthread_mutex_unlock(&pool->lock);
+			frame = NULL;
+		}
+	}
+
+	if(frame == NULL)
+	{
+		// every frame is held by the application
+		__atomic_add_fetch(&pool->dropped, 1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+
+	memcpy(frame->data, data, size);
+	frame->next_free = NULL;
+	frame->pool = pool;
+	frame->refcount = 1;
+	frame->size = size;
+	frame->width = width;
+	frame->height = height;
+	// a frame too short for its format would send the plane offsets out of the buffer
+	frame->format = size >= _player_video_frame_get_min_size(format, width, height) ? format : PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN;
+	frame->timestamp = timestamp;
+	__atomic_add_fetch(&pool->refcount, 1, __ATOMIC_ACQ_REL);
+	return (player_video_frame_h)frame;
+}
+
+/*
+* Public Implementation
+*/
+
+int player_video_frame_ref(player_video_frame_h frame)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	__atomic_add_fetch(&handle->refcount, 1, __ATOMIC_RELAXED);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_video_frame_unref(player_video_frame_h frame)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	if(__atomic_sub_fetch(&handle->refcount, 1, __ATOMIC_ACQ_REL) > 0)
+		return PLAYER_ERROR_NONE;
+
+	_player_frame_pool_s *pool = handle->pool;
+	pthread_mutex_lock(&pool->lock);
+	handle->next_free = pool->free_list;
+	pool->free_list = handle;
+	pthread_mutex_unlock(&pool->lock);
+	__frame_pool_unref(pool);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_video_frame_get_data(player_video_frame_h frame, unsigned char **data, unsigned int *size)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	PLAYER_NULL_ARG_CHECK(data);
+	PLAYER_NULL_ARG_CHECK(size);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	*data = handle->data;
+	*size = handle->size;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_video_frame_get_resolution(player_video_frame_h frame, int *width, int *height)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	PLAYER_NULL_ARG_CHECK(width);
+	PLAYER_NULL_ARG_CHECK(height);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	*width = handle->width;
+	*height = handle->height;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_video_frame_get_format(player_video_frame_h frame, player_video_frame_format_e *format)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	PLAYER_NULL_ARG_CHECK(format);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	*format = handle->format;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_video_frame_get_plane_count(player_video_frame_h frame, int *count)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	PLAYER_NULL_ARG_CHECK(count);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	*count = handle->format == PLAYER_VIDEO_FRAME_FORMAT_I420 ? 3 : 1;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_video_frame_get_plane(player_video_frame_h frame, int plane, int *offset, int *stride)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	PLAYER_NULL_ARG_CHECK(offset);
+	PLAYER_NULL_ARG_CHECK(stride);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	int chroma_width = (handle->width + 1) / 2;
+	int chroma_height = (handle->height + 1) / 2;
+
+	switch(handle->format)
+	{
+		case PLAYER_VIDEO_FRAME_FORMAT_I420:
+			if(plane == 0)
+			{
+				*offset = 0;
+				*stride = handle->width;
+			}
+			else if(plane == 1 || plane == 2)
+			{
+				*offset = handle->width * handle->height + (plane - 1) * chroma_width * chroma_height;
+				*stride = chroma_width;
+			}
+			else
+				break;
+			return PLAYER_ERROR_NONE;
+		case PLAYER_VIDEO_FRAME_FORMAT_RGB565:
+		case PLAYER_VIDEO_FRAME_FORMAT_ARGB8888:
+		case PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN:
+		default:
+			if(plane != 0)
+				break;
+			*offset = 0;
+			*stride = handle->height > 0 ? handle->size / handle->height : 0;
+			return PLAYER_ERROR_NONE;
+	}
+	LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : plane %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, plane);
+	return PLAYER_ERROR_INVALID_PARAMETER;
+}
+
+int player_video_frame_get_timestamp(player_video_frame_h frame, int *millisecond)
+{
+	PLAYER_NULL_ARG_CHECK(frame);
+	PLAYER_NULL_ARG_CHECK(millisecond);
+	player_video_frame_s *handle = (player_video_frame_s*)frame;
+	*millisecond = handle->timestamp;
+	return PLAYER_ERROR_NONE;
+}
@@ -0,0 +1,152 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+/* Read ahead of the playback position, and dropped from the mapping behind it */
+#define PLAYER_MMAP_WINDOW	(2 * 1024 * 1024)
+
+/*
+* The mapping is shared with the page cache, so players of the same file share
+* its pages and the kernel may reclaim them at any time. The whole range stays
+* mapped, madvise() only tells which part is going to be read next.
+*/
+struct _player_mmap_s{
+	void *addr;
+	size_t map_length;
+	const unsigned char *data;
+	int length;
+	size_t page_size;
+	long window;
+};
+
+/*
+* Internal functions shared with player.c
+*/
+
+int _player_mmap_open(const char *path, int64_t offset, int length, _player_mmap_s **map)
+{
+	struct stat st;
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if(fd < 0)
+	{
+		LOGE("[%s] Failed to open %s : %s", __FUNCTION__, path, strerror(errno));
+		return errno == ENOENT ? PLAYER_ERROR_NO_SUCH_FILE : PLAYER_ERROR_INVALID_OPERATION;
+	}
+	if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || offset >= st.st_size)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : %s is not a regular file or is shorter than %lld" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, path, (long long)offset);
+		close(fd);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+	if(length == 0)
+	{
+		if(st.st_size - offset > INT_MAX)
+		{
+			LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : %s is too large" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, path);
+			close(fd);
+			return PLAYER_ERROR_INVALID_PARAMETER;
+		}
+		length = (int)(st.st_size - offset);
+	}
+	else if(offset + length > st.st_size)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : the range is beyond the end of %s" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, path);
+		close(fd);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+
+	_player_mmap_s *m = (_player_mmap_s*)calloc(1, sizeof(_player_mmap_s));
+	if(m == NULL)
+	{
+		close(fd);
+		return PLAYER_ERROR_OUT_OF_MEMORY;
+	}
+	// mmap() wants an offset aligned on a page
+	m->page_size = (size_t)sysconf(_SC_PAGESIZE);
+	int64_t aligned = offset - offset % m->page_size;
+	m->map_length = (size_t)(offset - aligned) + length;
+	m->addr = mmap(NULL, m->map_length, PROT_READ, MAP_SHARED, fd, (off_t)aligned);
+	close(fd);
+	if(m->addr == MAP_FAILED)
+	{
+		LOGE("[%s] Failed to map %s : %s", __FUNCTION__, path, strerror(errno));
+		free(m);
+		return errno == ENOMEM ? PLAYER_ERROR_OUT_OF_MEMORY : PLAYER_ERROR_INVALID_OPERATION;
+	}
+	m->data = (const unsigned char*)m->addr + (offset - aligned);
+	m->length = length;
+	m->window = -1;
+	madvise(m->addr, m->map_length, MADV_SEQUENTIAL);
+	*map = m;
+	return PLAYER_ERROR_NONE;
+}
+
+void _player_mmap_close(_player_mmap_s *map)
+{
+	if(map == NULL)
+		return;
+	munmap(map->addr, map->map_length);
+	free(map);
+}
+
+const void* _player_mmap_get_data(_player_mmap_s *map, int *length)
+{
+	*length = map->length;
+	return map->data;
+}
+
+/* permille is the playback position relative to the length of the content */
+void _player_mmap_advise(_player_mmap_s *map, int permille)
+{
+	if(permille < 0)
+		permille = 0;
+	else if(permille > 1000)
+		permille = 1000;
+
+	size_t pos = (size_t)((map->data - (const unsigned char*)map->addr) + (int64_t)map->length * permille / 1000);
+	long window = (long)(pos / (PLAYER_MMAP_WINDOW / 2));
+
+	// may be called from the application and the message threads, only one of them advises a window
+	if(__atomic_exchange_n(&map->window, window, __ATOMIC_ACQ_REL) == window)
+		return;
+
+	size_t start = pos - pos % map->page_size;
+	size_t ahead = PLAYER_MMAP_WINDOW;
+	if(start + ahead > map->map_length)
+		ahead = map->map_length - start;
+	if(ahead > 0)
+		madvise((unsigned char*)map->addr + start, ahead, MADV_WILLNEED);
+	if(start > PLAYER_MMAP_WINDOW)
+		madvise(map->addr, start - PLAYER_MMAP_WINDOW, MADV_DONTNEED);
+	PLAYER_TRACE("[%s] position : %d/1000, offset : %zu", __FUNCTION__, permille, pos);
+}
@@ -0,0 +1,310 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+/*
+* Single-producer single-consumer ring: the audio stream callback only moves
+* write_pos and the reader only moves read_pos, except with DROP_OLDEST where the
+* producer pushes read_pos forward with a CAS. Both positions count bytes since
+* the ring was created, so they never wrap in practice and read_pos also gives
+* the timestamp of the next byte to read. The mutex is only taken to sleep and
+* wake up, never to move data. The ring is freed with its last reference, so
+* closing it never waits for the threads still inside.
+*/
+struct _player_pcm_ring_s{
+	unsigned char *data;
+	unsigned int capacity;
+	player_audio_pcm_overflow_e policy;
+	uint64_t write_pos;
+	uint64_t read_pos;
+	unsigned int underruns;
+	unsigned int overruns;
+	int refs;
+	int closed;
+	int eos;
+	int waiters;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+};
+
+/*
+* Internal Implementation
+*/
+
+static void __ring_wakeup(_player_pcm_ring_s *ring)
+{
+	// orders the position just stored before the load of waiters, which __ring_wait() does the other way
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if(__atomic_load_n(&ring->waiters, __ATOMIC_SEQ_CST) > 0)
+	{
+		pthread_mutex_lock(&ring->lock);
+		pthread_cond_broadcast(&ring->cond);
+		pthread_mutex_unlock(&ring->lock);
+	}
+}
+
+static void __ring_copy_in(_player_pcm_ring_s *ring, uint64_t pos, const unsigned char *src, unsigned int size)
+{
+	unsigned int offset = pos % ring->capacity;
+	unsigned int first = ring->capacity - offset;
+	if(first > size)
+		first = size;
+	memcpy(ring->data + offset, src, first);
+	memcpy(ring->data, src + first, size - first);
+}
+
+static void __ring_copy_out(_player_pcm_ring_s *ring, uint64_t pos, unsigned char *dst, unsigned int size)
+{
+	unsigned int offset = pos % ring->capacity;
+	unsigned int first = ring->capacity - offset;
+	if(first > size)
+		first = size;
+	memcpy(dst, ring->data + offset, first);
+	memcpy(dst + first, ring->data, size - first);
+}
+
+static void __deadline_after(struct timespec *ts, int timeout)
+{
+	clock_gettime(CLOCK_REALTIME, ts);
+	ts->tv_sec += timeout / 1000;
+	ts->tv_nsec += (long)(timeout % 1000) * 1000000;
+	if(ts->tv_nsec >= 1000000000)
+	{
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000;
+	}
+}
+
+/* Waits until ready() or the deadline, returns FALSE on timeout */
+static bool __ring_wait(_player_pcm_ring_s *ring, bool (*ready)(_player_pcm_ring_s*), const struct timespec *deadline)
+{
+	bool ret = TRUE;
+
+	pthread_mutex_lock(&ring->lock);
+	__atomic_add_fetch(&ring->waiters, 1, __ATOMIC_SEQ_CST);
+	while(!ready(ring) && !__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE))
+	{
+		if(deadline == NULL)
+			pthread_cond_wait(&ring->cond, &ring->lock);
+		else if(pthread_cond_timedwait(&ring->cond, &ring->lock, deadline) == ETIMEDOUT)
+		{
+			ret = ready(ring);
+			break;
+		}
+	}
+	__atomic_sub_fetch(&ring->waiters, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&ring->lock);
+	return ret;
+}
+
+static bool __ring_has_data(_player_pcm_ring_s *ring)
+{
+	return __atomic_load_n(&ring->write_pos, __ATOMIC_ACQUIRE) != __atomic_load_n(&ring->read_pos, __ATOMIC_ACQUIRE);
+}
+
+static bool __ring_has_room(_player_pcm_ring_s *ring)
+{
+	return __atomic_load_n(&ring->write_pos, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->read_pos, __ATOMIC_ACQUIRE) < ring->capacity;
+}
+
+static bool __ring_readable(_player_pcm_ring_s *ring)
+{
+	return __ring_has_data(ring) || __atomic_load_n(&ring->eos, __ATOMIC_ACQUIRE);
+}
+
+static void __ring_broadcast(_player_pcm_ring_s *ring)
+{
+	pthread_mutex_lock(&ring->lock);
+	pthread_cond_broadcast(&ring->cond);
+	pthread_mutex_unlock(&ring->lock);
+}
+
+/*
+* Internal functions shared with player.c
+*/
+
+_player_pcm_ring_s* _player_pcm_ring_create(unsigned int capacity, player_audio_pcm_overflow_e policy)
+{
+	_player_pcm_ring_s *ring = (_player_pcm_ring_s*)calloc(1, sizeof(_player_pcm_ring_s));
+	if(ring == NULL)
+		return NULL;
+	ring->data = (unsigned char*)malloc(capacity);
+	if(ring->data == NULL)
+	{
+		free(ring);
+		return NULL;
+	}
+	ring->capacity = capacity;
+	ring->policy = policy;
+	ring->refs = 1;
+	pthread_mutex_init(&ring->lock, NULL);
+	pthread_cond_init(&ring->cond, NULL);
+	return ring;
+}
+
+_player_pcm_ring_s* _player_pcm_ring_ref(_player_pcm_ring_s *ring)
+{
+	__atomic_add_fetch(&ring->refs, 1, __ATOMIC_RELAXED);
+	return ring;
+}
+
+void _player_pcm_ring_unref(_player_pcm_ring_s *ring)
+{
+	if(ring == NULL || __atomic_sub_fetch(&ring->refs, 1, __ATOMIC_ACQ_REL) > 0)
+		return;
+	pthread_cond_destroy(&ring->cond);
+	pthread_mutex_destroy(&ring->lock);
+	free(ring->data);
+	free(ring);
+}
+
+void _player_pcm_ring_close(_player_pcm_ring_s *ring)
+{
+	if(ring == NULL)
+		return;
+	__atomic_store_n(&ring->closed, 1, __ATOMIC_SEQ_CST);
+	__ring_broadcast(ring);
+}
+
+void _player_pcm_ring_destroy(_player_pcm_ring_s *ring)
+{
+	_player_pcm_ring_close(ring);
+	_player_pcm_ring_unref(ring);
+}
+
+void _player_pcm_ring_set_eos(_player_pcm_ring_s *ring)
+{
+	__atomic_store_n(&ring->eos, 1, __ATOMIC_SEQ_CST);
+	__ring_broadcast(ring);
+}
+
+void _player_pcm_ring_write(_player_pcm_ring_s *ring, const void *data, unsigned int size)
+{
+	const unsigned char *src = (const unsigned char*)data;
+
+	if(size > 0)
+		__atomic_store_n(&ring->eos, 0, __ATOMIC_RELEASE);
+	while(size > 0 && !__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE))
+	{
+		uint64_t w = ring->write_pos;
+		uint64_t r = __atomic_load_n(&ring->read_pos, __ATOMIC_ACQUIRE);
+		unsigned int room = ring->capacity - (unsigned int)(w - r);
+		unsigned int chunk = size;
+
+		if(chunk > room)
+		{
+			if(ring->policy == PLAYER_AUDIO_PCM_OVERFLOW_BLOCK)
+			{
+				if(room == 0)
+				{
+					__ring_wait(ring, __ring_has_room, NULL);
+					continue;
+				}
+				chunk = room;
+			}
+			else if(ring->policy == PLAYER_AUDIO_PCM_OVERFLOW_DROP_NEWEST)
+			{
+				__atomic_add_fetch(&ring->overruns, 1, __ATOMIC_RELAXED);
+				chunk = room;
+				size = room;
+				if(chunk == 0)
+					break;
+			}
+			else
+			{
+				// keep only what fits, then make room by pushing the reader forward
+				if(chunk > ring->capacity)
+				{
+					src += chunk - ring->capacity;
+					chunk = size = ring->capacity;
+				}
+				uint64_t target = w + chunk - ring->capacity;
+				while(r < target && !__atomic_compare_exchange_n(&ring->read_pos, &r, target, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+				__atomic_add_fetch(&ring->overruns, 1, __ATOMIC_RELAXED);
+			}
+		}
+
+		__ring_copy_in(ring, w, src, chunk);
+		__atomic_store_n(&ring->write_pos, w + chunk, __ATOMIC_RELEASE);
+		__ring_wakeup(ring);
+		src += chunk;
+		size -= chunk;
+	}
+}
+
+int _player_pcm_ring_read(_player_pcm_ring_s *ring, void *buffer, unsigned int max_bytes, unsigned int *read_bytes, uint64_t *position, int timeout)
+{
+	struct timespec deadline;
+
+	*read_bytes = 0;
+	if(!__ring_readable(ring) && timeout != 0)
+	{
+		if(timeout > 0)
+			__deadline_after(&deadline, timeout);
+		__ring_wait(ring, __ring_readable, timeout > 0 ? &deadline : NULL);
+	}
+
+	while(TRUE)
+	{
+		uint64_t r = __atomic_load_n(&ring->read_pos, __ATOMIC_ACQUIRE);
+		uint64_t w = __atomic_load_n(&ring->write_pos, __ATOMIC_ACQUIRE);
+		unsigned int size = (unsigned int)(w - r);
+
+		if(size == 0)
+		{
+			*position = r;
+			if(__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE) || __atomic_load_n(&ring->eos, __ATOMIC_ACQUIRE))
+				return PLAYER_ERROR_INVALID_OPERATION;
+			__atomic_add_fetch(&ring->underruns, 1, __ATOMIC_RELAXED);
+			return PLAYER_ERROR_NONE;
+		}
+		if(size > max_bytes)
+			size = max_bytes;
+
+		__ring_copy_out(ring, r, (unsigned char*)buffer, size);
+		// fails only if the producer overwrote what was just copied (DROP_OLDEST)
+		if(__atomic_compare_exchange_n(&ring->read_pos, &r, r + size, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		{
+			*read_bytes = size;
+			*position = r;
+			break;
+		}
+	}
+
+	if(ring->policy == PLAYER_AUDIO_PCM_OVERFLOW_BLOCK)
+		__ring_wakeup(ring);
+	return PLAYER_ERROR_NONE;
+}
+
+void _player_pcm_ring_get_stats(_player_pcm_ring_s *ring, unsigned int *underruns, unsigned int *overruns)
+{
+	*underruns = __atomic_load_n(&ring->underruns, __ATOMIC_RELAXED);
+	*overruns = __atomic_load_n(&ring->overruns, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,195 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+typedef struct _player_pool_s{
+	pthread_mutex_t lock;
+	player_h *idle;
+	int idle_count;
+	int low_watermark;
+	int high_watermark;
+	unsigned int hits;
+	unsigned int misses;
+	unsigned int evictions;
+} player_pool_s;
+
+/*
+* Internal Implementation
+*/
+
+static int __pool_fill(player_pool_s *pool)
+{
+	int ret = PLAYER_ERROR_NONE;
+	player_h player;
+
+	pthread_mutex_lock(&pool->lock);
+	int missing = pool->low_watermark - pool->idle_count;
+	pthread_mutex_unlock(&pool->lock);
+
+	// mm_player_create() is slow, so never hold the lock while building handles
+	while(missing-- > 0)
+	{
+		ret = player_create(&player);
+		if(ret != PLAYER_ERROR_NONE)
+			break;
+
+		pthread_mutex_lock(&pool->lock);
+		if(pool->idle_count < pool->high_watermark)
+		{
+			pool->idle[pool->idle_count++] = player;
+			player = NULL;
+		}
+		pthread_mutex_unlock(&pool->lock);
+
+		if(player)
+		{
+			player_destroy(player);
+			break;
+		}
+	}
+	return ret;
+}
+
+/*
+* Public Implementation
+*/
+
+int player_pool_create(int low_watermark, int high_watermark, player_pool_h *pool)
+{
+	PLAYER_NULL_ARG_CHECK(pool);
+	if(low_watermark < 0 || high_watermark <= 0 || low_watermark > high_watermark)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : watermarks low %d, high %d" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, low_watermark, high_watermark);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+
+	player_pool_s *handle = (player_pool_s*)calloc(1, sizeof(player_pool_s));
+	if(handle)
+		handle->idle = (player_h*)calloc(high_watermark, sizeof(player_h));
+	if(handle == NULL || handle->idle == NULL)
+	{
+		LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+		free(handle);
+		return PLAYER_ERROR_OUT_OF_MEMORY;
+	}
+	pthread_mutex_init(&handle->lock, NULL);
+	handle->low_watermark = low_watermark;
+	handle->high_watermark = high_watermark;
+
+	int ret = __pool_fill(handle);
+	if(ret != PLAYER_ERROR_NONE)
+	{
+		player_pool_destroy((player_pool_h)handle);
+		return ret;
+	}
+	*pool = (player_pool_h)handle;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_pool_destroy(player_pool_h pool)
+{
+	PLAYER_NULL_ARG_CHECK(pool);
+	player_pool_s *handle = (player_pool_s*)pool;
+	int i;
+
+	for(i = 0; i < handle->idle_count; i++)
+		player_destroy(handle->idle[i]);
+	pthread_mutex_destroy(&handle->lock);
+	free(handle->idle);
+	free(handle);
+	return PLAYER_ERROR_NONE;
+}
+
+int player_pool_acquire(player_pool_h pool, player_h *player)
+{
+	PLAYER_NULL_ARG_CHECK(pool);
+	PLAYER_INSTANCE_CHECK(player);
+	player_pool_s *handle = (player_pool_s*)pool;
+
+	pthread_mutex_lock(&handle->lock);
+	if(handle->idle_count > 0)
+	{
+		*player = handle->idle[--handle->idle_count];
+		handle->hits++;
+		pthread_mutex_unlock(&handle->lock);
+		return PLAYER_ERROR_NONE;
+	}
+	handle->misses++;
+	pthread_mutex_unlock(&handle->lock);
+
+	return player_create(player);
+}
+
+int player_pool_release(player_pool_h pool, player_h player)
+{
+	PLAYER_NULL_ARG_CHECK(pool);
+	PLAYER_INSTANCE_CHECK(player);
+	player_pool_s *handle = (player_pool_s*)pool;
+
+	if(_player_reset(player) == PLAYER_ERROR_NONE)
+	{
+		pthread_mutex_lock(&handle->lock);
+		if(handle->idle_count < handle->high_watermark)
+		{
+			handle->idle[handle->idle_count++] = player;
+			pthread_mutex_unlock(&handle->lock);
+			return PLAYER_ERROR_NONE;
+		}
+		pthread_mutex_unlock(&handle->lock);
+	}
+	else
+	{
+		LOGW("[%s] Failed to reset the player, it will not be reused" ,__FUNCTION__);
+	}
+
+	pthread_mutex_lock(&handle->lock);
+	handle->evictions++;
+	pthread_mutex_unlock(&handle->lock);
+	return player_destroy(player);
+}
+
+int player_pool_refill(player_pool_h pool)
+{
+	PLAYER_NULL_ARG_CHECK(pool);
+	return __pool_fill((player_pool_s*)pool);
+}
+
+int player_pool_get_stats(player_pool_h pool, player_pool_stats_s *stats)
+{
+	PLAYER_NULL_ARG_CHECK(pool);
+	PLAYER_NULL_ARG_CHECK(stats);
+	player_pool_s *handle = (player_pool_s*)pool;
+
+	pthread_mutex_lock(&handle->lock);
+	stats->hits = handle->hits;
+	stats->misses = handle->misses;
+	stats->evictions = handle->evictions;
+	stats->idle_count = handle->idle_count;
+	pthread_mutex_unlock(&handle->lock);
+	return PLAYER_ERROR_NONE;
+}
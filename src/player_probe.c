@@ -0,0 +1,117 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <mm.h>
+#include <mm_file.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+#define PLAYER_PROBE_FILE_SCHEME	"file://"
+
+/*
+* Public Implementation
+*/
+
+/*
+* mm-fileinfo only parses the container headers and the tags, nothing is decoded
+* or rendered. Its handles are per call, so probes may run in parallel.
+*/
+int player_probe_uri(const char *uri, player_media_info_s *info)
+{
+	PLAYER_NULL_ARG_CHECK(uri);
+	PLAYER_NULL_ARG_CHECK(info);
+
+	const char *path = uri;
+	MMHandleType content = 0;
+	MMHandleType tag = 0;
+	char *err_attr_name = NULL;
+	char *val[_PLAYER_MEDIA_INFO_STRING_NUM] = {NULL,};
+	int len[_PLAYER_MEDIA_INFO_STRING_NUM] = {0,};
+	int ret;
+
+	memset(info, 0, sizeof(player_media_info_s));
+	if(strncmp(uri, PLAYER_PROBE_FILE_SCHEME, strlen(PLAYER_PROBE_FILE_SCHEME)) == 0)
+		path = uri + strlen(PLAYER_PROBE_FILE_SCHEME);
+	else if(strstr(uri, "://"))
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_URI(0x%08x) : only local files can be probed" ,__FUNCTION__,PLAYER_ERROR_INVALID_URI);
+		return PLAYER_ERROR_INVALID_URI;
+	}
+	if(access(path, R_OK) != 0)
+	{
+		LOGE("[%s] PLAYER_ERROR_NO_SUCH_FILE(0x%08x) : %s" ,__FUNCTION__,PLAYER_ERROR_NO_SUCH_FILE, path);
+		return PLAYER_ERROR_NO_SUCH_FILE;
+	}
+
+	ret = mm_file_create_content_attrs(&content, path);
+	if(ret != MM_ERROR_NONE)
+	{
+		LOGE("[%s] PLAYER_ERROR_NOT_SUPPORTED_FILE(0x%08x) : failed to parse %s (0x%x)" ,__FUNCTION__,PLAYER_ERROR_NOT_SUPPORTED_FILE, path, ret);
+		return PLAYER_ERROR_NOT_SUPPORTED_FILE;
+	}
+	ret = mm_file_get_attrs(content, &err_attr_name,
+		MM_FILE_CONTENT_DURATION, &info->duration,
+		MM_FILE_CONTENT_AUDIO_SAMPLERATE, &info->sample_rate,
+		MM_FILE_CONTENT_AUDIO_CHANNELS, &info->channel,
+		MM_FILE_CONTENT_AUDIO_BITRATE, &info->audio_bit_rate,
+		MM_FILE_CONTENT_VIDEO_FPS, &info->fps,
+		MM_FILE_CONTENT_VIDEO_BITRATE, &info->video_bit_rate,
+		MM_FILE_CONTENT_VIDEO_WIDTH, &info->width,
+		MM_FILE_CONTENT_VIDEO_HEIGHT, &info->height,
+		NULL);
+	if(ret != MM_ERROR_NONE)
+	{
+		LOGE("[%s] Failed to get %s (0x%x)", __FUNCTION__, err_attr_name ? err_attr_name : "content attributes", ret);
+		free(err_attr_name);
+		err_attr_name = NULL;
+	}
+
+	// the tags are optional, a file without any is still a valid file
+	if(mm_file_create_tag_attrs(&tag, path) == MM_ERROR_NONE)
+	{
+		ret = mm_file_get_attrs(tag, &err_attr_name,
+			MM_FILE_TAG_ALBUM, &val[0], &len[0],
+			MM_FILE_TAG_ARTIST, &val[1], &len[1],
+			MM_FILE_TAG_AUTHOR, &val[2], &len[2],
+			MM_FILE_TAG_GENRE, &val[3], &len[3],
+			MM_FILE_TAG_TITLE, &val[4], &len[4],
+			MM_FILE_TAG_DATE, &val[5], &len[5],
+			NULL);
+		if(ret != MM_ERROR_NONE)
+		{
+			LOGE("[%s] Failed to get %s (0x%x)", __FUNCTION__, err_attr_name ? err_attr_name : "tag attributes", ret);
+			free(err_attr_name);
+			memset(val, 0, sizeof(val));
+		}
+	}
+
+	ret = _player_media_info_set_strings(info, val, len);
+
+	if(tag)
+		mm_file_destroy_tag_attrs(tag);
+	mm_file_destroy_content_attrs(content);
+	return ret;
+}
@@ -0,0 +1,206 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <mm.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+/* The order of player_stats_s.error_counts */
+static const player_error_e __errors[PLAYER_STATS_ERROR_NUM] = {
+	PLAYER_ERROR_OUT_OF_MEMORY,
+	PLAYER_ERROR_INVALID_PARAMETER,
+	PLAYER_ERROR_NO_SUCH_FILE,
+	PLAYER_ERROR_INVALID_OPERATION,
+	PLAYER_ERROR_SEEK_FAILED,
+	PLAYER_ERROR_INVALID_STATE,
+	PLAYER_ERROR_NOT_SUPPORTED_FILE,
+	PLAYER_ERROR_INVALID_URI,
+	PLAYER_ERROR_SOUND_POLICY,
+	PLAYER_ERROR_CONNECTION_FAILED,
+	PLAYER_ERROR_VIDEO_CAPTURE_FAILED,
+};
+
+/*
+* The counters are written with relaxed atomics by the application and the
+* message threads, and read the same way, so neither side ever waits. A
+* snapshot is not atomic as a whole, a histogram may miss the sample being added.
+*/
+
+/*
+* Internal Implementation
+*/
+
+static int64_t __now_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static int __error_index(int error)
+{
+	int i;
+	for(i = 0; i < PLAYER_STATS_ERROR_NUM; i++)
+	{
+		if(__errors[i] == error)
+			return i;
+	}
+	return -1;
+}
+
+static void __histogram_add(player_latency_histogram_s *h, unsigned int ms)
+{
+	int bucket = 0;
+	while(bucket < PLAYER_LATENCY_HISTOGRAM_BUCKETS - 1 && (ms >> bucket))
+		bucket++;
+
+	__atomic_add_fetch(&h->count, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&h->total, ms, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&h->buckets[bucket], 1, __ATOMIC_RELAXED);
+	unsigned int max = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+	while(ms > max && !__atomic_compare_exchange_n(&h->max, &max, ms, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+static void __histogram_load(player_latency_histogram_s *dst, player_latency_histogram_s *src)
+{
+	int i;
+	dst->count = __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+	dst->max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+	dst->total = __atomic_load_n(&src->total, __ATOMIC_RELAXED);
+	for(i = 0; i < PLAYER_LATENCY_HISTOGRAM_BUCKETS; i++)
+		dst->buckets[i] = __atomic_load_n(&src->buckets[i], __ATOMIC_RELAXED);
+}
+
+/*
+* Internal functions shared with player.c
+*/
+
+void _player_stats_mark(int64_t *mark)
+{
+	__atomic_store_n(mark, __now_ms(), __ATOMIC_RELAXED);
+}
+
+void _player_stats_record(player_latency_histogram_s *histogram, int64_t *mark)
+{
+	// only the first of concurrent records takes the mark
+	int64_t start = __atomic_exchange_n(mark, 0, __ATOMIC_RELAXED);
+	if(start > 0)
+		__histogram_add(histogram, (unsigned int)(__now_ms() - start));
+}
+
+void _player_stats_record_value(player_latency_histogram_s *histogram, unsigned int millisecond)
+{
+	__histogram_add(histogram, millisecond);
+}
+
+void _player_stats_buffering(player_s *handle, int percent)
+{
+	__atomic_add_fetch(&handle->stats.buffering_events, 1, __ATOMIC_RELAXED);
+	if(percent < 100)
+	{
+		int64_t idle = 0;
+		if(__atomic_compare_exchange_n(&handle->stats_stall_start, &idle, __now_ms(), FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			__atomic_add_fetch(&handle->stats.stalls, 1, __ATOMIC_RELAXED);
+	}
+	else
+	{
+		int64_t start = __atomic_exchange_n(&handle->stats_stall_start, 0, __ATOMIC_RELAXED);
+		if(start > 0)
+			__atomic_add_fetch(&handle->stats.stall_time, (unsigned long long)(__now_ms() - start), __ATOMIC_RELAXED);
+	}
+}
+
+void _player_stats_error(player_s *handle, int error)
+{
+	int index = __error_index(error);
+	__atomic_add_fetch(&handle->stats.errors, 1, __ATOMIC_RELAXED);
+	if(index >= 0)
+		__atomic_add_fetch(&handle->stats.error_counts[index], 1, __ATOMIC_RELAXED);
+}
+
+/* A handle given back to a pool starts over, only the cost of its creation is kept */
+void _player_stats_reset(player_s *handle)
+{
+	player_latency_histogram_s create = handle->stats.create;
+	memset(&handle->stats, 0, sizeof(player_stats_s));
+	handle->stats.create = create;
+	handle->stats_prepare_start = 0;
+	handle->stats_start_start = 0;
+	handle->stats_seek_start = 0;
+	handle->stats_stall_start = 0;
+}
+
+/*
+* Public Implementation
+*/
+
+int player_get_statistics(player_h player, player_stats_s *stats)
+{
+	PLAYER_INSTANCE_CHECK(player);
+	PLAYER_NULL_ARG_CHECK(stats);
+	player_s * handle = (player_s *) player;
+	PLAYER_MM_GUARD(handle);
+	int i;
+
+	__histogram_load(&stats->create, &handle->stats.create);
+	__histogram_load(&stats->prepare, &handle->stats.prepare);
+	__histogram_load(&stats->start_to_begin, &handle->stats.start_to_begin);
+	__histogram_load(&stats->seek, &handle->stats.seek);
+	stats->buffering_events = __atomic_load_n(&handle->stats.buffering_events, __ATOMIC_RELAXED);
+	stats->stalls = __atomic_load_n(&handle->stats.stalls, __ATOMIC_RELAXED);
+	stats->stall_time = __atomic_load_n(&handle->stats.stall_time, __ATOMIC_RELAXED);
+	int64_t stall_start = __atomic_load_n(&handle->stats_stall_start, __ATOMIC_RELAXED);
+	if(stall_start > 0)
+		stats->stall_time += (unsigned long long)(__now_ms() - stall_start);
+	stats->dropped_frames = _player_frame_pool_get_dropped(handle->frame_pool);
+	stats->errors = __atomic_load_n(&handle->stats.errors, __ATOMIC_RELAXED);
+	for(i = 0; i < PLAYER_STATS_ERROR_NUM; i++)
+		stats->error_counts[i] = __atomic_load_n(&handle->stats.error_counts[i], __ATOMIC_RELAXED);
+
+	// only the progressive download knows how much it has fetched
+	guint64 current = 0;
+	guint64 total = 0;
+	stats->downloaded_bytes = 0;
+	int state = _player_get_state(handle);
+	if((state == PLAYER_STATE_PLAYING || state == PLAYER_STATE_PAUSED)
+		&& mm_player_get_pd_status(_player_get_mm_handle(handle), &current, &total) == MM_ERROR_NONE)
+		stats->downloaded_bytes = current;
+	return PLAYER_ERROR_NONE;
+}
+
+int player_stats_get_error_count(const player_stats_s *stats, player_error_e error, unsigned int *count)
+{
+	PLAYER_NULL_ARG_CHECK(stats);
+	PLAYER_NULL_ARG_CHECK(count);
+	int index = __error_index(error);
+	if(index < 0)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_PARAMETER(0x%08x) : error 0x%x" ,__FUNCTION__,PLAYER_ERROR_INVALID_PARAMETER, error);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+	*count = stats->error_counts[index];
+	return PLAYER_ERROR_NONE;
+}
@@ -0,0 +1,451 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <mm.h>
+#include <mm_player.h>
+#include <player.h>
+#include <player_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_PLAYER"
+
+/* How long a single seek, capture or decoded frame may take */
+#define PLAYER_THUMBNAIL_STEP_TIMEOUT	3000
+
+typedef enum {
+	_THUMBNAIL_EXPECT_NONE,
+	_THUMBNAIL_EXPECT_SEEK,
+	_THUMBNAIL_EXPECT_CAPTURE,
+	_THUMBNAIL_EXPECT_FRAME,
+} _thumbnail_expect_e;
+
+typedef struct {
+	int position;
+	int index;
+} _thumbnail_target_s;
+
+/*
+* The extraction runs on its own thread, because the pipeline can't be seeked
+* or paused from the threads mm-player calls us on. Those threads only store
+* the result of the step the worker is waiting for and wake it up.
+*
+* The job is reference counted : handle->thumbnail, the worker and the event
+* threads which found it under thumbnail_lock each hold a reference.
+*/
+struct _player_thumbnail_s{
+	player_s *handle;
+	_thumbnail_target_s *targets;
+	int count;
+	int width;
+	int height;
+	bool headless;
+	bool own_stream_callback;
+	player_thumbnail_extracted_cb callback;
+	void *user_data;
+	unsigned char *output;
+	bool output_ready;
+	int expect;
+	int cancelled;
+	int running;
+	int refs;
+	bool detached;
+	int muted;
+	sem_t event;
+	pthread_t thread;
+};
+
+/*
+* Internal Implementation
+*/
+
+static void __thumbnail_free(_player_thumbnail_s *job)
+{
+	sem_destroy(&job->event);
+	free(job->output);
+	free(job->targets);
+	free(job);
+}
+
+static void __thumbnail_unref(_player_thumbnail_s *job)
+{
+	if(__atomic_sub_fetch(&job->refs, 1, __ATOMIC_ACQ_REL) == 0)
+		__thumbnail_free(job);
+}
+
+static _player_thumbnail_s* __thumbnail_get(player_s *handle)
+{
+	_player_thumbnail_s *job;
+	if(__atomic_load_n(&handle->thumbnail, __ATOMIC_ACQUIRE) == NULL)
+		return NULL;
+	pthread_mutex_lock(&handle->thumbnail_lock);
+	job = handle->thumbnail;
+	if(job)
+		__atomic_add_fetch(&job->refs, 1, __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&handle->thumbnail_lock);
+	return job;
+}
+
+static void __thumbnail_publish(player_s *handle, _player_thumbnail_s *job)
+{
+	pthread_mutex_lock(&handle->thumbnail_lock);
+	__atomic_store_n(&handle->thumbnail, job, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&handle->thumbnail_lock);
+}
+
+static int __compare_target(const void *a, const void *b)
+{
+	return ((const _thumbnail_target_s*)a)->position - ((const _thumbnail_target_s*)b)->position;
+}
+
+static unsigned char __clamp(int value)
+{
+	return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+/*
+* Nearest-neighbour downscale into RGB888. The captures are RGB888, the decoded
+* frames have the format the pipeline reports, as the application gets it.
+*/
+static bool __scale_frame(_player_thumbnail_s *job, const unsigned char *src, int width, int height, unsigned int size, bool capture, player_video_frame_format_e format)
+{
+	unsigned int pixels = (unsigned int)width * height;
+	unsigned int chroma = (unsigned int)((width + 1) / 2) * ((height + 1) / 2);
+	unsigned char *dst = job->output;
+	int x;
+	int y;
+
+	if(src == NULL || width <= 0 || height <= 0)
+		return FALSE;
+	if(capture ? size < pixels * 3 : (format == PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN || size < _player_video_frame_get_min_size(format, width, height)))
+	{
+		LOGE("[%s] Unsupported frame - format %d, %dx%d, %u bytes", __FUNCTION__, format, width, height, size);
+		return FALSE;
+	}
+
+	for(y = 0; y < job->height; y++)
+	{
+		int sy = y * height / job->height;
+		for(x = 0; x < job->width; x++)
+		{
+			int sx = x * width / job->width;
+			if(capture)
+			{
+				const unsigned char *p = src + (sy * width + sx) * 3;
+				dst[0] = p[0];
+				dst[1] = p[1];
+				dst[2] = p[2];
+			}
+			else if(format == PLAYER_VIDEO_FRAME_FORMAT_ARGB8888)
+			{
+				const unsigned char *p = src + (sy * width + sx) * 4;
+				dst[0] = p[1];
+				dst[1] = p[2];
+				dst[2] = p[3];
+			}
+			else if(format == PLAYER_VIDEO_FRAME_FORMAT_RGB565)
+			{
+				const unsigned char *p = src + (sy * width + sx) * 2;
+				unsigned int v = p[0] | (p[1] << 8);
+				dst[0] = ((v >> 11) & 0x1f) << 3;
+				dst[1] = ((v >> 5) & 0x3f) << 2;
+				dst[2] = (v & 0x1f) << 3;
+			}
+			else
+			{
+				int c = src[sy * width + sx] - 16;
+				int d = src[pixels + (sy / 2) * ((width + 1) / 2) + sx / 2] - 128;
+				int e = src[pixels + chroma + (sy / 2) * ((width + 1) / 2) + sx / 2] - 128;
+				dst[0] = __clamp((298 * c + 409 * e + 128) >> 8);
+				dst[1] = __clamp((298 * c - 100 * d - 208 * e + 128) >> 8);
+				dst[2] = __clamp((298 * c + 516 * d + 128) >> 8);
+			}
+			dst += 3;
+		}
+	}
+	return TRUE;
+}
+
+/* Claims the step the worker is waiting for, so that a late event is ignored */
+static bool __claim_step(_player_thumbnail_s *job, int expect)
+{
+	return __atomic_compare_exchange_n(&job->expect, &expect, _THUMBNAIL_EXPECT_NONE, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+/*
+* Gives up the step. If an event claimed it already, its post is on the way and is
+* taken here, otherwise it would complete the next step before it even started.
+*/
+static void __abandon_step(_player_thumbnail_s *job, int expect)
+{
+	if(__claim_step(job, expect))
+		return;
+	while(sem_wait(&job->event) != 0 && errno == EINTR);
+}
+
+static bool __wait_step(_player_thumbnail_s *job, int expect)
+{
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += PLAYER_THUMBNAIL_STEP_TIMEOUT / 1000;
+
+	while(sem_timedwait(&job->event, &deadline) != 0)
+	{
+		if(errno == EINTR)
+			continue;
+		if(__claim_step(job, expect))
+			return FALSE;
+		// the event came in along with the timeout
+		while(sem_wait(&job->event) != 0 && errno == EINTR);
+		break;
+	}
+	return !__atomic_load_n(&job->cancelled, __ATOMIC_ACQUIRE);
+}
+
+static int __extract_one(_player_thumbnail_s *job, int position)
+{
+	PLAYER_MM_GUARD(job->handle);
+	MMHandleType mm_handle = _player_get_mm_handle(job->handle);
+	int ret;
+
+	job->output_ready = FALSE;
+	__atomic_store_n(&job->expect, _THUMBNAIL_EXPECT_SEEK, __ATOMIC_RELEASE);
+	// keyframe seek, the accurate one would decode every frame up to the position
+	ret = mm_player_set_position(mm_handle, MM_PLAYER_POS_FORMAT_TIME, position);
+	if(ret != MM_ERROR_NONE)
+		__abandon_step(job, _THUMBNAIL_EXPECT_SEEK);
+	if(ret != MM_ERROR_NONE || !__wait_step(job, _THUMBNAIL_EXPECT_SEEK))
+	{
+		LOGE("[%s] Failed to seek to %d (0x%x)", __FUNCTION__, position, ret);
+		return PLAYER_ERROR_SEEK_FAILED;
+	}
+
+	if(job->headless)
+	{
+		// nothing is rendered without a display, so play until the first frame arrives
+		__atomic_store_n(&job->expect, _THUMBNAIL_EXPECT_FRAME, __ATOMIC_RELEASE);
+		ret = mm_player_resume(mm_handle);
+		if(ret == MM_ERROR_NONE)
+		{
+			__wait_step(job, _THUMBNAIL_EXPECT_FRAME);
+			mm_player_pause(mm_handle);
+		}
+		else
+			__abandon_step(job, _THUMBNAIL_EXPECT_FRAME);
+	}
+	else
+	{
+		__atomic_store_n(&job->expect, _THUMBNAIL_EXPECT_CAPTURE, __ATOMIC_RELEASE);
+		ret = mm_player_do_video_capture(mm_handle);
+		if(ret == MM_ERROR_NONE)
+			__wait_step(job, _THUMBNAIL_EXPECT_CAPTURE);
+		else
+			__abandon_step(job, _THUMBNAIL_EXPECT_CAPTURE);
+	}
+
+	if(!job->output_ready)
+	{
+		LOGE("[%s] Failed to get the frame at %d (0x%x)", __FUNCTION__, position, ret);
+		return PLAYER_ERROR_VIDEO_CAPTURE_FAILED;
+	}
+	return PLAYER_ERROR_NONE;
+}
+
+static void __restore_player(_player_thumbnail_s *job)
+{
+	PLAYER_MM_GUARD(job->handle);
+	if(job->headless)
+		mm_player_set_mute(_player_get_mm_handle(job->handle), job->muted);
+	if(job->own_stream_callback)
+		mm_player_set_video_stream_callback(_player_get_mm_handle(job->handle), NULL, NULL);
+}
+
+static void* __thumbnail_worker(void *data)
+{
+	_player_thumbnail_s *job = (_player_thumbnail_s*)data;
+	unsigned int size = (unsigned int)job->width * job->height * 3;
+	int i;
+
+	for(i = 0; i < job->count && !__atomic_load_n(&job->cancelled, __ATOMIC_ACQUIRE); i++)
+	{
+		int ret = __extract_one(job, job->targets[i].position);
+		if(__atomic_load_n(&job->cancelled, __ATOMIC_ACQUIRE))
+			break;
+		if(ret == PLAYER_ERROR_NONE)
+			job->callback(PLAYER_ERROR_NONE, job->targets[i].index, job->output, job->width, job->height, size, job->user_data);
+		else
+			job->callback(ret, job->targets[i].index, NULL, 0, 0, 0, job->user_data);
+	}
+
+	// stopped from the callback, the player may be gone already
+	if(!job->detached)
+	{
+		__restore_player(job);
+		__atomic_store_n(&job->expect, _THUMBNAIL_EXPECT_NONE, __ATOMIC_RELEASE);
+		__atomic_store_n(&job->running, 0, __ATOMIC_RELEASE);
+	}
+	__thumbnail_unref(job);
+	return NULL;
+}
+
+/*
+* Internal functions shared with player.c
+*/
+
+int _player_thumbnail_start(player_s *handle, const int *positions, int count, int width, int height, bool headless, bool own_stream_callback, player_thumbnail_extracted_cb callback, void *user_data)
+{
+	_player_thumbnail_s *job;
+	int i;
+
+	_player_thumbnail_stop(handle);
+
+	job = (_player_thumbnail_s*)calloc(1, sizeof(_player_thumbnail_s));
+	if(job == NULL)
+		goto ERROR;
+	job->targets = (_thumbnail_target_s*)malloc(sizeof(_thumbnail_target_s) * count);
+	job->output = (unsigned char*)malloc((size_t)width * height * 3);
+	if(job->targets == NULL || job->output == NULL)
+		goto ERROR;
+
+	// seeking forward only is much cheaper than going back and forth
+	for(i = 0; i < count; i++)
+	{
+		job->targets[i].position = positions[i];
+		job->targets[i].index = i;
+	}
+	qsort(job->targets, count, sizeof(_thumbnail_target_s), __compare_target);
+
+	job->handle = handle;
+	job->count = count;
+	job->width = width;
+	job->height = height;
+	job->headless = headless;
+	job->own_stream_callback = own_stream_callback;
+	job->callback = callback;
+	job->user_data = user_data;
+	job->running = 1;
+	// one for handle->thumbnail, one for the worker
+	job->refs = 2;
+	sem_init(&job->event, 0, 0);
+
+	if(headless)
+	{
+		mm_player_get_mute(handle->mm_handle, &job->muted);
+		mm_player_set_mute(handle->mm_handle, 1);
+	}
+
+	// the first seek may complete before pthread_create() returns
+	__thumbnail_publish(handle, job);
+	if(pthread_create(&job->thread, NULL, __thumbnail_worker, job) != 0)
+	{
+		LOGE("[%s] PLAYER_ERROR_INVALID_OPERATION(0x%08x) : failed to create the thumbnail thread" ,__FUNCTION__,PLAYER_ERROR_INVALID_OPERATION);
+		__thumbnail_publish(handle, NULL);
+		__restore_player(job);
+		__thumbnail_unref(job);
+		__thumbnail_unref(job);
+		return PLAYER_ERROR_INVALID_OPERATION;
+	}
+	return PLAYER_ERROR_NONE;
+
+ERROR:
+	LOGE("[%s] PLAYER_ERROR_OUT_OF_MEMORY(0x%08x)" ,__FUNCTION__,PLAYER_ERROR_OUT_OF_MEMORY);
+	if(job)
+	{
+		free(job->output);
+		free(job->targets);
+		free(job);
+	}
+	return PLAYER_ERROR_OUT_OF_MEMORY;
+}
+
+void _player_thumbnail_stop(player_s *handle)
+{
+	pthread_mutex_lock(&handle->thumbnail_lock);
+	_player_thumbnail_s *job = handle->thumbnail;
+	__atomic_store_n(&handle->thumbnail, NULL, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&handle->thumbnail_lock);
+	if(job == NULL)
+		return;
+
+	__atomic_store_n(&job->cancelled, 1, __ATOMIC_RELEASE);
+	sem_post(&job->event);
+	// the extraction may be stopped from its own callback
+	if(pthread_equal(pthread_self(), job->thread))
+	{
+		__restore_player(job);
+		job->detached = TRUE;
+		pthread_detach(job->thread);
+	}
+	else
+		pthread_join(job->thread, NULL);
+	__thumbnail_unref(job);
+}
+
+bool _player_thumbnail_is_running(player_s *handle)
+{
+	_player_thumbnail_s *job = __thumbnail_get(handle);
+	if(job == NULL)
+		return FALSE;
+	bool running = __atomic_load_n(&job->running, __ATOMIC_ACQUIRE);
+	__thumbnail_unref(job);
+	return running;
+}
+
+bool _player_thumbnail_seek_completed(player_s *handle)
+{
+	_player_thumbnail_s *job = __thumbnail_get(handle);
+	if(job == NULL)
+		return FALSE;
+	bool claimed = __claim_step(job, _THUMBNAIL_EXPECT_SEEK);
+	if(claimed)
+		sem_post(&job->event);
+	__thumbnail_unref(job);
+	return claimed;
+}
+
+static bool __thumbnail_take_frame(player_s *handle, int expect, const void *data, int width, int height, unsigned int size, player_video_frame_format_e format)
+{
+	_player_thumbnail_s *job = __thumbnail_get(handle);
+	if(job == NULL)
+		return FALSE;
+	bool claimed = __claim_step(job, expect);
+	if(claimed)
+	{
+		job->output_ready = __scale_frame(job, (const unsigned char*)data, width, height, size, expect == _THUMBNAIL_EXPECT_CAPTURE, format);
+		sem_post(&job->event);
+	}
+	__thumbnail_unref(job);
+	return claimed;
+}
+
+bool _player_thumbnail_captured(player_s *handle, const void *data, int width, int height, unsigned int size)
+{
+	return __thumbnail_take_frame(handle, _THUMBNAIL_EXPECT_CAPTURE, data, width, height, size, PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN);
+}
+
+bool _player_thumbnail_frame(player_s *handle, const void *data, int width, int height, unsigned int size, player_video_frame_format_e format)
+{
+	return __thumbnail_take_frame(handle, _THUMBNAIL_EXPECT_FRAME, data, width, height, size, format);
+}
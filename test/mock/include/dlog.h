@@ -0,0 +1,52 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the dlog header : the logs go to stderr, tagged with LOG_TAG. The debug and
+* info logs are only printed when the DLOG_MOCK_VERBOSE environment variable is set.
+*/
+
+#ifndef __MOCK_DLOG_H__
+#define __MOCK_DLOG_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#ifndef LOG_TAG
+#define LOG_TAG NULL
+#endif
+
+/* Like dlog, the format is not checked by the compiler */
+static inline void __mock_dlog_print(const char *prio, int verbose, const char *tag, const char *fmt, ...)
+{
+	va_list args;
+	if(verbose && !getenv("DLOG_MOCK_VERBOSE"))
+		return;
+	va_start(args, fmt);
+	fprintf(stderr, "%s/%s: ", prio, tag);
+	vfprintf(stderr, fmt, args);
+	fputc('\n', stderr);
+	va_end(args);
+}
+
+#define __MOCK_DLOG(prio, verbose, fmt, arg...)	__mock_dlog_print(prio, verbose, LOG_TAG, fmt, ##arg)
+
+#define LOGD(fmt, arg...)	__MOCK_DLOG("D", 1, fmt, ##arg)
+#define LOGI(fmt, arg...)	__MOCK_DLOG("I", 1, fmt, ##arg)
+#define LOGW(fmt, arg...)	__MOCK_DLOG("W", 0, fmt, ##arg)
+#define LOGE(fmt, arg...)	__MOCK_DLOG("E", 0, fmt, ##arg)
+
+#endif //__MOCK_DLOG_H__
@@ -0,0 +1,27 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the platform header, only what capi-media-player uses. See test/mock/mm_player_mock.c.
+*/
+
+#ifndef __MOCK_MM_H__
+#define __MOCK_MM_H__
+
+#include <mm_types.h>
+#include <mm_error.h>
+#include <mm_message.h>
+
+#endif //__MOCK_MM_H__
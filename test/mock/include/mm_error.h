@@ -0,0 +1,102 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* Fake of the platform header, only what capi-media-player uses. See test/mock/mm_player_mock.c.
+*/
+
+#ifndef __MOCK_MM_ERROR_H__
+#define __MOCK_MM_ERROR_H__
+
+#define MM_ERROR_NONE	0x00000000
+
+#define MM_ERROR_CLASS			((int)0x80000000)
+#define MM_ERROR_COMMON_CLASS	(MM_ERROR_CLASS | 0x00000100)
+#define MM_ERROR_PLAYER_CLASS	(MM_ERROR_CLASS | 0x00000200)
+#define MM_ERROR_STREAMING_CLASS	(MM_ERROR_CLASS | 0x00000300)
+#define MM_ERROR_POLICY_CLASS	(MM_ERROR_CLASS | 0x00000400)
+
+#define MM_ERROR_COMMON_INVALID_ARGUMENT	(MM_ERROR_COMMON_CLASS | 0x01)
+#define MM_ERROR_COMMON_INVALID_ATTRTYPE	(MM_ERROR_COMMON_CLASS | 0x02)
+#define MM_ERROR_COMMON_ATTR_NOT_EXIST	(MM_ERROR_COMMON_CLASS | 0x03)
+#define MM_ERROR_NOT_SUPPORT_API	(MM_ERROR_COMMON_CLASS | 0x04)
+
+#define MM_ERROR_PLAYER_CODEC_NOT_FOUND	(MM_ERROR_PLAYER_CLASS | 0x01)
+#define MM_ERROR_PLAYER_AUDIO_CODEC_NOT_FOUND	(MM_ERROR_PLAYER_CLASS | 0x02)
+#define MM_ERROR_PLAYER_VIDEO_CODEC_NOT_FOUND	(MM_ERROR_PLAYER_CLASS | 0x03)
+#define MM_ERROR_PLAYER_NOT_SUPPORTED_FORMAT	(MM_ERROR_PLAYER_CLASS | 0x04)
+#define MM_ERROR_PLAYER_INVALID_STATE	(MM_ERROR_PLAYER_CLASS | 0x05)
+#define MM_ERROR_PLAYER_NOT_INITIALIZED	(MM_ERROR_PLAYER_CLASS | 0x06)
+#define MM_ERROR_PLAYER_INTERNAL	(MM_ERROR_PLAYER_CLASS | 0x07)
+#define MM_ERROR_PLAYER_INVALID_STREAM	(MM_ERROR_PLAYER_CLASS | 0x08)
+#define MM_ERROR_PLAYER_NO_OP	(MM_ERROR_PLAYER_CLASS | 0x09)
+#define MM_ERROR_PLAYER_SOUND_EFFECT_NOT_SUPPORTED_FILTER	(MM_ERROR_PLAYER_CLASS | 0x0a)
+#define MM_ERROR_PLAYER_NO_FREE_SPACE	(MM_ERROR_PLAYER_CLASS | 0x0b)
+#define MM_ERROR_PLAYER_FILE_NOT_FOUND	(MM_ERROR_PLAYER_CLASS | 0x0c)
+#define MM_ERROR_PLAYER_SEEK	(MM_ERROR_PLAYER_CLASS | 0x0d)
+#define MM_ERROR_PLAYER_INVALID_URI	(MM_ERROR_PLAYER_CLASS | 0x0e)
+
+#define MM_ERROR_PLAYER_STREAMING_UNSUPPORTED_AUDIO	(MM_ERROR_STREAMING_CLASS | 0x01)
+#define MM_ERROR_PLAYER_STREAMING_UNSUPPORTED_VIDEO	(MM_ERROR_STREAMING_CLASS | 0x02)
+#define MM_ERROR_PLAYER_STREAMING_UNSUPPORTED_MEDIA_TYPE	(MM_ERROR_STREAMING_CLASS | 0x03)
+#define MM_ERROR_PLAYER_STREAMING_FAIL	(MM_ERROR_STREAMING_CLASS | 0x04)
+#define MM_ERROR_PLAYER_STREAMING_INVALID_URL	(MM_ERROR_STREAMING_CLASS | 0x05)
+#define MM_ERROR_PLAYER_STREAMING_CONNECTION_FAIL	(MM_ERROR_STREAMING_CLASS | 0x06)
+#define MM_ERROR_PLAYER_STREAMING_DNS_FAIL	(MM_ERROR_STREAMING_CLASS | 0x07)
+#define MM_ERROR_PLAYER_STREAMING_SERVER_DISCONNECTED	(MM_ERROR_STREAMING_CLASS | 0x08)
+#define MM_ERROR_PLAYER_STREAMING_INVALID_PROTOCOL	(MM_ERROR_STREAMING_CLASS | 0x09)
+#define MM_ERROR_PLAYER_STREAMING_UNEXPECTED_MSG	(MM_ERROR_STREAMING_CLASS | 0x0a)
+#define MM_ERROR_PLAYER_STREAMING_OUT_OF_MEMORIES	(MM_ERROR_STREAMING_CLASS | 0x0b)
+#define MM_ERROR_PLAYER_STREAMING_RTSP_TIMEOUT	(MM_ERROR_STREAMING_CLASS | 0x0c)
+#define MM_ERROR_PLAYER_STREAMING_BAD_REQUEST	(MM_ERROR_STREAMING_CLASS | 0x0d)
+#define MM_ERROR_PLAYER_STREAMING_NOT_AUTHORIZED	(MM_ERROR_STREAMING_CLASS | 0x0e)
+#define MM_ERROR_PLAYER_STREAMING_PAYMENT_REQUIRED	(MM_ERROR_STREAMING_CLASS | 0x0f)
+#define MM_ERROR_PLAYER_STREAMING_FORBIDDEN	(MM_ERROR_STREAMING_CLASS | 0x10)
+#define MM_ERROR_PLAYER_STREAMING_CONTENT_NOT_FOUND	(MM_ERROR_STREAMING_CLASS | 0x11)
+#define MM_ERROR_PLAYER_STREAMING_METHOD_NOT_ALLOWED	(MM_ERROR_STREAMING_CLASS | 0x12)
+#define MM_ERROR_PLAYER_STREAMING_NOT_ACCEPTABLE	(MM_ERROR_STREAMING_CLASS | 0x13)
+#define MM_ERROR_PLAYER_STREAMING_PROXY_AUTHENTICATION_REQUIRED	(MM_ERROR_STREAMING_CLASS | 0x14)
+#define MM_ERROR_PLAYER_STREAMING_SERVER_TIMEOUT	(MM_ERROR_STREAMING_CLASS | 0x15)
+#define MM_ERROR_PLAYER_STREAMING_GONE	(MM_ERROR_STREAMING_CLASS | 0x16)
+#define MM_ERROR_PLAYER_STREAMING_LENGTH_REQUIRED	(MM_ERROR_STREAMING_CLASS | 0x17)
+#define MM_ERROR_PLAYER_STREAMING_PRECONDITION_FAILED	(MM_ERROR_STREAMING_CLASS | 0x18)
+#define MM_ERROR_PLAYER_STREAMING_REQUEST_ENTITY_TOO_LARGE	(MM_ERROR_STREAMING_CLASS | 0x19)
+#define MM_ERROR_PLAYER_STREAMING_REQUEST_URI_TOO_LARGE	(MM_ERROR_STREAMING_CLASS | 0x1a)
+#define MM_ERROR_PLAYER_STREAMING_PARAMETER_NOT_UNDERSTOOD	(MM_ERROR_STREAMING_CLASS | 0x1b)
+#define MM_ERROR_PLAYER_STREAMING_CONFERENCE_NOT_FOUND	(MM_ERROR_STREAMING_CLASS | 0x1c)
+#define MM_ERROR_PLAYER_STREAMING_NOT_ENOUGH_BANDWIDTH	(MM_ERROR_STREAMING_CLASS | 0x1d)
+#define MM_ERROR_PLAYER_STREAMING_NO_SESSION_ID	(MM_ERROR_STREAMING_CLASS | 0x1e)
+#define MM_ERROR_PLAYER_STREAMING_METHOD_NOT_VALID_IN_THIS_STATE	(MM_ERROR_STREAMING_CLASS | 0x1f)
+#define MM_ERROR_PLAYER_STREAMING_HEADER_FIELD_NOT_VALID_FOR_SOURCE	(MM_ERROR_STREAMING_CLASS | 0x20)
+#define MM_ERROR_PLAYER_STREAMING_INVALID_RANGE	(MM_ERROR_STREAMING_CLASS | 0x21)
+#define MM_ERROR_PLAYER_STREAMING_PARAMETER_IS_READONLY	(MM_ERROR_STREAMING_CLASS | 0x22)
+#define MM_ERROR_PLAYER_STREAMING_AGGREGATE_OP_NOT_ALLOWED	(MM_ERROR_STREAMING_CLASS | 0x23)
+#define MM_ERROR_PLAYER_STREAMING_ONLY_AGGREGATE_OP_ALLOWED	(MM_ERROR_STREAMING_CLASS | 0x24)
+#define MM_ERROR_PLAYER_STREAMING_BAD_TRANSPORT	(MM_ERROR_STREAMING_CLASS | 0x25)
+#define MM_ERROR_PLAYER_STREAMING_DESTINATION_UNREACHABLE	(MM_ERROR_STREAMING_CLASS | 0x26)
+#define MM_ERROR_PLAYER_STREAMING_INTERNAL_SERVER_ERROR	(MM_ERROR_STREAMING_CLASS | 0x27)
+#define MM_ERROR_PLAYER_STREAMING_NOT_IMPLEMENTED	(MM_ERROR_STREAMING_CLASS | 0x28)
+#define MM_ERROR_PLAYER_STREAMING_BAD_GATEWAY	(MM_ERROR_STREAMING_CLASS | 0x29)
+#define MM_ERROR_PLAYER_STREAMING_SERVICE_UNAVAILABLE	(MM_ERROR_STREAMING_CLASS | 0x2a)
+#define MM_ERROR_PLAYER_STREAMING_GATEWAY_TIME_OUT	(MM_ERROR_STREAMING_CLASS | 0x2b)
+#define MM_ERROR_PLAYER_STREAMING_OPTION_NOT_SUPPORTED	(MM_ERROR_STREAMING_CLASS | 0x2c)
+
+#define MM_ERROR_POLICY_BLOCKED	(MM_ERROR_POLICY_CLASS | 0x01)
+#define MM_ERROR_POLICY_INTERRUPTED	(MM_ERROR_POLICY_CLASS | 0x02)
+#define MM_ERROR_POLICY_INTERNAL	(MM_ERROR_POLICY_CLASS | 0x03)
+#define MM_ERROR_POLICY_DUPLICATED	(MM_ERROR_POLICY_CLASS | 0x04)
+
+#endif //__MOCK_MM_ERROR_H__
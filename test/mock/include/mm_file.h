@@ -0,0 +1,58 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the mm-fileinfo header, only what capi-media-player uses. See test/mock/mm_file_mock.c.
+*/
+
+#ifndef __MOCK_MM_FILE_H__
+#define __MOCK_MM_FILE_H__
+
+#include <mm_types.h>
+#include <mm_error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MM_FILE_CONTENT_DURATION		"content-duration"
+#define MM_FILE_CONTENT_VIDEO_CODEC		"content-video-codec"
+#define MM_FILE_CONTENT_VIDEO_BITRATE	"content-video-bitrate"
+#define MM_FILE_CONTENT_VIDEO_FPS		"content-video-fps"
+#define MM_FILE_CONTENT_VIDEO_WIDTH		"content-video-width"
+#define MM_FILE_CONTENT_VIDEO_HEIGHT	"content-video-height"
+#define MM_FILE_CONTENT_AUDIO_CODEC		"content-audio-codec"
+#define MM_FILE_CONTENT_AUDIO_BITRATE	"content-audio-bitrate"
+#define MM_FILE_CONTENT_AUDIO_CHANNELS	"content-audio-channels"
+#define MM_FILE_CONTENT_AUDIO_SAMPLERATE	"content-audio-samplerate"
+#define MM_FILE_TAG_ARTIST				"tag-artist"
+#define MM_FILE_TAG_TITLE				"tag-title"
+#define MM_FILE_TAG_ALBUM				"tag-album"
+#define MM_FILE_TAG_GENRE				"tag-genre"
+#define MM_FILE_TAG_AUTHOR				"tag-author"
+#define MM_FILE_TAG_DATE				"tag-date"
+
+int mm_file_create_content_attrs(MMHandleType *content_attrs, const char *filename);
+int mm_file_destroy_content_attrs(MMHandleType content_attrs);
+int mm_file_create_tag_attrs(MMHandleType *tag_attrs, const char *filename);
+int mm_file_destroy_tag_attrs(MMHandleType tag_attrs);
+/* The attributes are passed as a list of (name, value) ended by NULL, strings take (char**, int*) */
+int mm_file_get_attrs(MMHandleType attrs, char **err_attr_name, const char *first_attribute_name, ...) __attribute__((sentinel));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MOCK_MM_FILE_H__
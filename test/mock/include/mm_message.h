@@ -0,0 +1,94 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the platform header, only what capi-media-player uses. See test/mock/mm_player_mock.c.
+*/
+
+#ifndef __MOCK_MM_MESSAGE_H__
+#define __MOCK_MM_MESSAGE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	MM_MESSAGE_UNKNOWN = 0x00,
+	MM_MESSAGE_ERROR = 0x01,
+	MM_MESSAGE_WARNING = 0x02,
+	MM_MESSAGE_STATE_CHANGED = 0x03,
+	MM_MESSAGE_STATE_INTERRUPTED = 0x04,
+	MM_MESSAGE_READY_TO_RESUME = 0x05,
+
+	MM_MESSAGE_CONNECTING = 0x100,
+	MM_MESSAGE_CONNECTED = 0x101,
+	MM_MESSAGE_CONNECTION_TIMEOUT = 0x102,
+	MM_MESSAGE_BUFFERING = 0x103,
+	MM_MESSAGE_BEGIN_OF_STREAM = 0x104,
+	MM_MESSAGE_END_OF_STREAM = 0x105,
+	MM_MESSAGE_BLUETOOTH_ON = 0x106,
+	MM_MESSAGE_BLUETOOTH_OFF = 0x107,
+	MM_MESSAGE_RESUMED_BY_REW = 0x108,
+	MM_MESSAGE_UPDATE_SUBTITLE = 0x109,
+	MM_MESSAGE_RTP_SENDER_REPORT = 0x10a,
+	MM_MESSAGE_RTP_RECEIVER_REPORT = 0x10b,
+	MM_MESSAGE_RTP_SESSION_STATUS = 0x10c,
+	MM_MESSAGE_SENDER_STATE = 0x10d,
+	MM_MESSAGE_RECEIVER_STATE = 0x10e,
+	MM_MESSAGE_FILE_NOT_SUPPORTED = 0x10f,
+	MM_MESSAGE_FILE_NOT_FOUND = 0x110,
+	MM_MESSAGE_DRM_NOT_AUTHORIZED = 0x111,
+	MM_MESSAGE_VIDEO_CAPTURED = 0x112,
+	MM_MESSAGE_VIDEO_NOT_CAPTURED = 0x113,
+	MM_MESSAGE_SEEK_COMPLETED = 0x114,
+	MM_MESSAGE_PD_DOWNLOADER_START = 0x115,
+	MM_MESSAGE_PD_DOWNLOADER_END = 0x116,
+};
+
+enum {
+	MM_MSG_CODE_INTERRUPTED_BY_OTHER_APP = 0x10,
+	MM_MSG_CODE_INTERRUPTED_BY_CALL_START,
+	MM_MSG_CODE_INTERRUPTED_BY_CALL_END,
+	MM_MSG_CODE_INTERRUPTED_BY_EARJACK_UNPLUG,
+	MM_MSG_CODE_INTERRUPTED_BY_RESOURCE_CONFLICT,
+	MM_MSG_CODE_INTERRUPTED_BY_ALARM_START,
+	MM_MSG_CODE_INTERRUPTED_BY_ALARM_END,
+};
+
+typedef struct {
+	int code;
+	union {
+		struct {
+			int previous;
+			int current;
+		} state;
+		struct {
+			int buffering;
+		} connection;
+		struct {
+			unsigned long duration;
+		} subtitle;
+	};
+	void *data;
+	int size;
+} MMMessageParamType;
+
+typedef int (*MMMessageCallback)(int id, void *param, void *user_param);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MOCK_MM_MESSAGE_H__
@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the platform header, only what capi-media-player uses. See test/mock/mm_player_mock.c.
+*/
+
+#ifndef __MOCK_MM_PLAYER_H__
+#define __MOCK_MM_PLAYER_H__
+
+#include <stdbool.h>
+#include <glib.h>
+#include <mm_types.h>
+#include <mm_error.h>
+#include <mm_message.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MM_PLAYER_CONTENT_URI		"profile_uri"
+#define MM_PLAYER_MEMORY_SRC		"profile_user_param"
+#define MM_PLAYER_PLAYBACK_COUNT	"profile_play_count"
+#define MM_PLAYER_CONTENT_DURATION	"content_duration"
+#define MM_PLAYER_VIDEO_ROTATION	"display_rotation"
+#define MM_PLAYER_VIDEO_WIDTH		"content_video_width"
+#define MM_PLAYER_VIDEO_HEIGHT		"content_video_height"
+#define MM_PLAYER_AUDIO_CODEC		"content_audio_codec"
+#define MM_PLAYER_VIDEO_CODEC		"content_video_codec"
+#define MM_PLAYER_AUDIO_SAMPLERATE	"content_audio_samplerate"
+#define MM_PLAYER_AUDIO_CHANNEL		"content_audio_channels"
+#define MM_PLAYER_AUDIO_BITRATE		"content_audio_bitrate"
+#define MM_PLAYER_TAG_ALBUM			"tag_album"
+#define MM_PLAYER_TAG_ARTIST		"tag_artist"
+#define MM_PLAYER_TAG_AUTHOUR		"tag_author"
+#define MM_PLAYER_TAG_GENRE			"tag_genre"
+#define MM_PLAYER_TAG_TITLE			"tag_title"
+#define MM_PLAYER_TAG_DATE			"tag_date"
+
+typedef enum {
+	MM_PLAYER_STATE_NULL,
+	MM_PLAYER_STATE_READY,
+	MM_PLAYER_STATE_PLAYING,
+	MM_PLAYER_STATE_PAUSED,
+	MM_PLAYER_STATE_NONE,
+	MM_PLAYER_STATE_NUM,
+} MMPlayerStateType;
+
+typedef enum {
+	MM_PLAYER_POS_FORMAT_TIME,
+	MM_PLAYER_POS_FORMAT_PERCENT,
+	MM_PLAYER_POS_FORMAT_NUM,
+} MMPlayerPosFormatType;
+
+typedef enum {
+	MM_VOLUME_CHANNEL_LEFT,
+	MM_VOLUME_CHANNEL_RIGHT,
+	MM_VOLUME_CHANNEL_NUM,
+} MMVolumeChannel;
+
+typedef struct {
+	float level[MM_VOLUME_CHANNEL_NUM];
+} MMPlayerVolumeType;
+
+typedef enum {
+	MM_DISPLAY_SURFACE_X,
+	MM_DISPLAY_SURFACE_EVAS,
+	MM_DISPLAY_SURFACE_GL,
+	MM_DISPLAY_SURFACE_NULL,
+	MM_DISPLAY_SURFACE_NUM,
+} MMDisplaySurfaceType;
+
+typedef enum {
+	MM_PLAYER_PD_MODE_NONE,
+	MM_PLAYER_PD_MODE_URI,
+	MM_PLAYER_PD_MODE_FILE,
+} MMPlayerPDMode;
+
+typedef enum {
+	MM_PLAYER_TRACK_TYPE_AUDIO,
+	MM_PLAYER_TRACK_TYPE_VIDEO,
+	MM_PLAYER_TRACK_TYPE_TEXT,
+} MMPlayerTrackType;
+
+typedef bool (*mm_player_video_stream_callback)(void *stream, int stream_size, void *user_param, int width, int height);
+typedef bool (*mm_player_audio_stream_callback)(void *stream, int stream_size, void *user_param);
+typedef bool (*mm_player_buffer_need_data_callback)(unsigned int size, void *user_param);
+typedef bool (*mm_player_buffer_enough_data_callback)(void *user_param);
+
+int mm_player_set_video_stream_callback(MMHandleType player, mm_player_video_stream_callback callback, void *user_param);
+int mm_player_set_audio_stream_callback(MMHandleType player, mm_player_audio_stream_callback callback, void *user_param);
+int mm_player_set_buffer_need_data_callback(MMHandleType player, mm_player_buffer_need_data_callback callback, void *user_param);
+int mm_player_set_buffer_enough_data_callback(MMHandleType player, mm_player_buffer_enough_data_callback callback, void *user_param);
+
+int mm_player_create(MMHandleType *player);
+int mm_player_destroy(MMHandleType player);
+int mm_player_realize(MMHandleType player);
+int mm_player_unrealize(MMHandleType player);
+int mm_player_get_state(MMHandleType player, MMPlayerStateType *state);
+int mm_player_set_volume(MMHandleType player, MMPlayerVolumeType *volume);
+int mm_player_get_volume(MMHandleType player, MMPlayerVolumeType *volume);
+int mm_player_start(MMHandleType player);
+int mm_player_stop(MMHandleType player);
+int mm_player_pause(MMHandleType player);
+int mm_player_resume(MMHandleType player);
+int mm_player_set_position(MMHandleType player, MMPlayerPosFormatType format, int pos);
+int mm_player_get_position(MMHandleType player, MMPlayerPosFormatType format, int *pos);
+int mm_player_get_buffer_position(MMHandleType player, MMPlayerPosFormatType format, int *start_pos, int *stop_pos);
+int mm_player_adjust_subtitle_position(MMHandleType player, MMPlayerPosFormatType format, int offset);
+int mm_player_set_message_callback(MMHandleType player, MMMessageCallback callback, void *user_param);
+int mm_player_set_pd_message_callback(MMHandleType player, MMMessageCallback callback, void *user_param);
+int mm_player_set_mute(MMHandleType player, int mute);
+int mm_player_get_mute(MMHandleType player, int *mute);
+int mm_player_set_play_speed(MMHandleType player, float rate);
+int mm_player_get_track_count(MMHandleType player, MMPlayerTrackType track_type, int *count);
+int mm_player_get_pd_status(MMHandleType player, guint64 *current_pos, guint64 *total_size);
+int mm_player_do_video_capture(MMHandleType player);
+int mm_player_push_buffer(MMHandleType player, unsigned char *buf, int size);
+
+/*
+* The attributes are passed as a list of (name, value) ended by NULL. Strings and
+* data take two arguments, the pointer and the size.
+*/
+int mm_player_set_attribute(MMHandleType player, char **err_attr_name, const char *first_attribute_name, ...) __attribute__((sentinel));
+int mm_player_get_attribute(MMHandleType player, char **err_attr_name, const char *first_attribute_name, ...) __attribute__((sentinel));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MOCK_MM_PLAYER_H__
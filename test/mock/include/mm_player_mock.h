@@ -0,0 +1,82 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef __MOCK_MM_PLAYER_MOCK_H__
+#define __MOCK_MM_PLAYER_MOCK_H__
+
+#include <mm_player.h>
+#include <mm_player_internal.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+* Controls of the fake mm-player used by the unit tests, they don't exist in mm-player.
+*
+* Each pipeline has a message thread, like the bus thread of mm-player : the state
+* changes, the seek completions and the injected messages are delivered from there,
+* in order. The synthetic frames are delivered on the calling thread, which plays
+* the streaming thread.
+*/
+
+/* Queues @a message for the message callback, @a param is copied */
+int mm_player_mock_post_message(MMHandleType player, int message, const MMMessageParamType *param);
+int mm_player_mock_post_begin_of_stream(MMHandleType player);
+/* Also moves the position to the duration */
+int mm_player_mock_post_end_of_stream(MMHandleType player);
+int mm_player_mock_post_buffering(MMHandleType player, int percent);
+int mm_player_mock_post_error(MMHandleType player, int code);
+/* Waits until the messages queued so far have been delivered */
+void mm_player_mock_flush(MMHandleType player);
+
+/*
+* mm_player_set_position() completes the seek on the message thread by default.
+* When the completion is held, it is only posted by mm_player_mock_complete_seek().
+*/
+void mm_player_mock_hold_seek(MMHandleType player, bool hold);
+int mm_player_mock_complete_seek(MMHandleType player);
+/* The number of mm_player_set_position() calls of @a player */
+int mm_player_mock_get_seek_count(MMHandleType player);
+
+/* Makes the next mm_player_realize() of @a player fail with @a error */
+void mm_player_mock_fail_realize(MMHandleType player, int error);
+
+/*
+* The frames are pushed on the calling thread, which plays the streaming thread. Like
+* the state change to NULL, mm_player_unrealize() and mm_player_destroy() wait for
+* the frames being pushed.
+*/
+/*
+* A frame of the pattern : I420 when @a bpp is 0, otherwise @a bpp bytes per pixel. The
+* "video_stream_format" attribute reports I420, RGB565 or ARGB for 0, 2 and 4.
+*/
+int mm_player_mock_push_video_frame(MMHandleType player, int width, int height, int bpp);
+/* Signed 16 bits stereo samples, the value of each byte is the offset in the stream modulo 251 */
+int mm_player_mock_push_audio_frame(MMHandleType player, unsigned int size);
+int mm_player_mock_need_data(MMHandleType player, unsigned int size);
+int mm_player_mock_enough_data(MMHandleType player);
+
+/* The content reported by the pipelines created from now on */
+void mm_player_mock_set_content(int duration, int width, int height, int sample_rate, int channel);
+/* The number of pipelines created and not destroyed yet */
+int mm_player_mock_get_alive_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MOCK_MM_PLAYER_MOCK_H__
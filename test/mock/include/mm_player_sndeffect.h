@@ -0,0 +1,67 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the platform header, only what capi-media-player uses. See test/mock/mm_player_mock.c.
+*/
+
+#ifndef __MOCK_MM_PLAYER_SNDEFFECT_H__
+#define __MOCK_MM_PLAYER_SNDEFFECT_H__
+
+#include <mm_player.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+	MM_AUDIO_FILTER_TYPE_NONE,
+	MM_AUDIO_FILTER_TYPE_PRESET,
+	MM_AUDIO_FILTER_TYPE_CUSTOM,
+} MMAudioFilterType;
+
+typedef enum {
+	MM_AUDIO_FILTER_CUSTOM_EQ,
+	MM_AUDIO_FILTER_CUSTOM_3D,
+	MM_AUDIO_FILTER_CUSTOM_BASS,
+	MM_AUDIO_FILTER_CUSTOM_ROOM_SIZE,
+	MM_AUDIO_FILTER_CUSTOM_REVERB_LEVEL,
+	MM_AUDIO_FILTER_CUSTOM_CLARITY,
+	MM_AUDIO_FILTER_CUSTOM_NUM,
+} MMAudioFilterCustom;
+
+/* The number of bands of the equalizer of the fake mm-player */
+#define MM_AUDIO_FILTER_EQ_BAND_NUM	7
+
+typedef bool (*mm_player_supported_filter_cb)(int filter, int type, void *user_param);
+
+int mm_player_sound_filter_custom_set_level(MMHandleType player, MMAudioFilterCustom filter, int option, int level);
+int mm_player_sound_filter_custom_get_level(MMHandleType player, MMAudioFilterCustom filter, int option, int *level);
+int mm_player_sound_filter_custom_get_level_range(MMHandleType player, MMAudioFilterCustom filter, int *min, int *max);
+int mm_player_sound_filter_custom_get_eq_bands_number(MMHandleType player, int *bands);
+int mm_player_sound_filter_custom_set_level_eq_from_list(MMHandleType player, int *level_list, int size);
+int mm_player_sound_filter_custom_apply(MMHandleType player);
+int mm_player_sound_filter_custom_clear_eq_all(MMHandleType player);
+int mm_player_sound_filter_custom_clear_ext_all(MMHandleType player);
+int mm_player_sound_filter_preset_apply(MMHandleType player, int preset);
+int mm_player_is_supported_custom_filter_type(MMHandleType player, MMAudioFilterCustom filter);
+int mm_player_is_supported_preset_filter_type(MMHandleType player, int preset);
+int mm_player_get_foreach_present_supported_filter_type(MMHandleType player, MMAudioFilterType filter_type, mm_player_supported_filter_cb foreach_cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MOCK_MM_PLAYER_SNDEFFECT_H__
@@ -0,0 +1,33 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the mm-ta header : the time analysis is compiled out.
+*/
+
+#ifndef __MOCK_MM_TA_H__
+#define __MOCK_MM_TA_H__
+
+#define MMTA_SHOW_STDOUT	0
+#define MMTA_SHOW_STDERR	1
+#define MMTA_SHOW_FILE		2
+
+#define MMTA_INIT()	do { } while(0)
+#define MMTA_RELEASE()	do { } while(0)
+#define MMTA_ACUM_ITEM_BEGIN(name, show)	do { } while(0)
+#define MMTA_ACUM_ITEM_END(name, show)	do { } while(0)
+#define MMTA_ACUM_ITEM_SHOW_RESULT_TO(direction)	do { } while(0)
+
+#endif //__MOCK_MM_TA_H__
@@ -0,0 +1,45 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* Fake of the platform header, only what capi-media-player uses. See test/mock/mm_player_mock.c.
+*/
+
+#ifndef __MOCK_MM_TYPES_H__
+#define __MOCK_MM_TYPES_H__
+
+typedef unsigned long MMHandleType;
+
+typedef enum {
+	MM_PIXEL_FORMAT_INVALID = -1,
+	MM_PIXEL_FORMAT_NV12 = 0,
+	MM_PIXEL_FORMAT_NV12T,
+	MM_PIXEL_FORMAT_NV16,
+	MM_PIXEL_FORMAT_NV21,
+	MM_PIXEL_FORMAT_YUYV,
+	MM_PIXEL_FORMAT_UYVY,
+	MM_PIXEL_FORMAT_422P,
+	MM_PIXEL_FORMAT_I420,
+	MM_PIXEL_FORMAT_YV12,
+	MM_PIXEL_FORMAT_RGB565,
+	MM_PIXEL_FORMAT_RGB888,
+	MM_PIXEL_FORMAT_RGBA,
+	MM_PIXEL_FORMAT_ARGB,
+	MM_PIXEL_FORMAT_ENCODED,
+	MM_PIXEL_FORMAT_NUM
+} MMPixelFormatType;
+
+#endif //__MOCK_MM_TYPES_H__
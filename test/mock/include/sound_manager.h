@@ -0,0 +1,43 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the capi-media-sound-manager header, only what capi-media-player uses.
+*/
+
+#ifndef __MOCK_SOUND_MANAGER_H__
+#define __MOCK_SOUND_MANAGER_H__
+
+#include <tizen.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+	SOUND_TYPE_SYSTEM,
+	SOUND_TYPE_NOTIFICATION,
+	SOUND_TYPE_ALARM,
+	SOUND_TYPE_RINGTONE,
+	SOUND_TYPE_MEDIA,
+	SOUND_TYPE_CALL,
+} sound_type_e;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MOCK_SOUND_MANAGER_H__
@@ -0,0 +1,34 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/*
+* Fake of the capi-base-common header, only what capi-media-player uses.
+*/
+
+#ifndef __MOCK_TIZEN_H__
+#define __MOCK_TIZEN_H__
+
+#include <errno.h>
+#include <stdbool.h>
+
+#define TIZEN_ERROR_MULTIMEDIA_CLASS	-0x01900000
+
+#define TIZEN_ERROR_NONE	0
+#define TIZEN_ERROR_OUT_OF_MEMORY	-ENOMEM
+#define TIZEN_ERROR_INVALID_PARAMETER	-EINVAL
+#define TIZEN_ERROR_NO_SUCH_FILE	-ENOENT
+#define TIZEN_ERROR_INVALID_OPERATION	-ENOSYS
+
+#endif //__MOCK_TIZEN_H__
@@ -0,0 +1,162 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* A fake mm-fileinfo for the unit tests : every file has the content set by
+* mm_player_mock_set_content() and the same tags as the fake pipelines.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <mm_file.h>
+
+typedef struct {
+	bool tag;
+	int duration;
+	int width;
+	int height;
+	int sample_rate;
+	int channel;
+} __mock_file_s;
+
+static const struct {
+	const char *name;
+	const char *value;
+} __tags[] = {
+	{ MM_FILE_TAG_ALBUM, "Album" },
+	{ MM_FILE_TAG_ARTIST, "Artist" },
+	{ MM_FILE_TAG_AUTHOR, "Author" },
+	{ MM_FILE_TAG_GENRE, "Genre" },
+	{ MM_FILE_TAG_TITLE, "Title" },
+	{ MM_FILE_TAG_DATE, "2013" },
+};
+
+/* In mm_player_mock.c */
+void __mm_player_mock_get_content(int *duration, int *width, int *height, int *sample_rate, int *channel);
+
+static int __create(MMHandleType *attrs, const char *filename, bool tag)
+{
+	if(attrs == NULL || filename == NULL)
+		return MM_ERROR_COMMON_INVALID_ARGUMENT;
+	if(access(filename, R_OK) != 0)
+		return MM_ERROR_PLAYER_FILE_NOT_FOUND;
+	__mock_file_s *file = (__mock_file_s*)calloc(1, sizeof(__mock_file_s));
+	if(file == NULL)
+		return MM_ERROR_PLAYER_NO_FREE_SPACE;
+	file->tag = tag;
+	__mm_player_mock_get_content(&file->duration, &file->width, &file->height, &file->sample_rate, &file->channel);
+	*attrs = (MMHandleType)(uintptr_t)file;
+	return MM_ERROR_NONE;
+}
+
+int mm_file_create_content_attrs(MMHandleType *content_attrs, const char *filename)
+{
+	return __create(content_attrs, filename, false);
+}
+
+int mm_file_destroy_content_attrs(MMHandleType content_attrs)
+{
+	free((void*)content_attrs);
+	return MM_ERROR_NONE;
+}
+
+int mm_file_create_tag_attrs(MMHandleType *tag_attrs, const char *filename)
+{
+	return __create(tag_attrs, filename, true);
+}
+
+int mm_file_destroy_tag_attrs(MMHandleType tag_attrs)
+{
+	free((void*)tag_attrs);
+	return MM_ERROR_NONE;
+}
+
+static int* __content_value(__mock_file_s *file, const char *name, int *scratch)
+{
+	if(strcmp(name, MM_FILE_CONTENT_DURATION) == 0)
+		return &file->duration;
+	if(strcmp(name, MM_FILE_CONTENT_VIDEO_WIDTH) == 0)
+		return &file->width;
+	if(strcmp(name, MM_FILE_CONTENT_VIDEO_HEIGHT) == 0)
+		return &file->height;
+	if(strcmp(name, MM_FILE_CONTENT_AUDIO_SAMPLERATE) == 0)
+		return &file->sample_rate;
+	if(strcmp(name, MM_FILE_CONTENT_AUDIO_CHANNELS) == 0)
+		return &file->channel;
+	if(strcmp(name, MM_FILE_CONTENT_AUDIO_BITRATE) == 0)
+		*scratch = 128000;
+	else if(strcmp(name, MM_FILE_CONTENT_VIDEO_BITRATE) == 0)
+		*scratch = 1000000;
+	else if(strcmp(name, MM_FILE_CONTENT_VIDEO_FPS) == 0)
+		*scratch = 30;
+	else if(strcmp(name, MM_FILE_CONTENT_AUDIO_CODEC) == 0 || strcmp(name, MM_FILE_CONTENT_VIDEO_CODEC) == 0)
+		*scratch = 1;
+	else
+		return NULL;
+	return scratch;
+}
+
+int mm_file_get_attrs(MMHandleType attrs, char **err_attr_name, const char *first_attribute_name, ...)
+{
+	__mock_file_s *file = (__mock_file_s*)attrs;
+	const char *name;
+	int ret = MM_ERROR_NONE;
+	va_list args;
+
+	if(file == NULL)
+		return MM_ERROR_COMMON_INVALID_ARGUMENT;
+	va_start(args, first_attribute_name);
+	for(name = first_attribute_name; name; name = va_arg(args, const char*))
+	{
+		if(file->tag)
+		{
+			unsigned int i;
+			for(i = 0; i < sizeof(__tags) / sizeof(__tags[0]); i++)
+			{
+				if(strcmp(__tags[i].name, name) == 0)
+					break;
+			}
+			if(i < sizeof(__tags) / sizeof(__tags[0]))
+			{
+				*va_arg(args, const char**) = __tags[i].value;
+				*va_arg(args, int*) = strlen(__tags[i].value);
+				continue;
+			}
+		}
+		else
+		{
+			int scratch;
+			int *value = __content_value(file, name, &scratch);
+			if(value)
+			{
+				*va_arg(args, int*) = *value;
+				continue;
+			}
+		}
+		fprintf(stderr, "mm_file_get_attrs() : unknown attribute %s\n", name);
+		if(err_attr_name)
+			*err_attr_name = strdup(name);
+		ret = MM_ERROR_COMMON_ATTR_NOT_EXIST;
+		break;
+	}
+	va_end(args);
+	return ret;
+}
@@ -0,0 +1,1181 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* A fake mm-player for the unit tests of capi-media-player on a plain Linux host.
+* Nothing is decoded : the pipelines only keep their attributes, walk through the
+* states of mm-player and post the messages it would post, from a message thread.
+* The frames are made up by mm_player_mock_push_video_frame() and friends.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <glib.h>
+#include <mm_player.h>
+#include <mm_player_internal.h>
+#include <mm_player_sndeffect.h>
+#include <mm_player_mock.h>
+
+typedef enum {
+	__ATTR_INT,
+	__ATTR_STRING,
+	__ATTR_DATA,
+} __attr_type_e;
+
+/* The attributes capi-media-player uses, any other name is rejected like an unknown attribute */
+static const struct {
+	const char *name;
+	__attr_type_e type;
+} __attrs[] = {
+	{ MM_PLAYER_CONTENT_URI, __ATTR_STRING },
+	{ MM_PLAYER_MEMORY_SRC, __ATTR_DATA },
+	{ MM_PLAYER_PLAYBACK_COUNT, __ATTR_INT },
+	{ MM_PLAYER_CONTENT_DURATION, __ATTR_INT },
+	{ MM_PLAYER_VIDEO_ROTATION, __ATTR_INT },
+	{ MM_PLAYER_VIDEO_WIDTH, __ATTR_INT },
+	{ MM_PLAYER_VIDEO_HEIGHT, __ATTR_INT },
+	{ MM_PLAYER_AUDIO_CODEC, __ATTR_STRING },
+	{ MM_PLAYER_VIDEO_CODEC, __ATTR_STRING },
+	{ MM_PLAYER_AUDIO_SAMPLERATE, __ATTR_INT },
+	{ MM_PLAYER_AUDIO_CHANNEL, __ATTR_INT },
+	{ MM_PLAYER_AUDIO_BITRATE, __ATTR_INT },
+	{ MM_PLAYER_TAG_ALBUM, __ATTR_STRING },
+	{ MM_PLAYER_TAG_ARTIST, __ATTR_STRING },
+	{ MM_PLAYER_TAG_AUTHOUR, __ATTR_STRING },
+	{ MM_PLAYER_TAG_GENRE, __ATTR_STRING },
+	{ MM_PLAYER_TAG_TITLE, __ATTR_STRING },
+	{ MM_PLAYER_TAG_DATE, __ATTR_STRING },
+	{ "tag_album_cover", __ATTR_DATA },
+	{ "content_video_fps", __ATTR_INT },
+	{ "content_video_bitrate", __ATTR_INT },
+	{ "profile_async_start", __ATTR_INT },
+	{ "accurate_seek", __ATTR_INT },
+	{ "display_surface_type", __ATTR_INT },
+	{ "display_surface_use_multi", __ATTR_INT },
+	{ "display_overlay", __ATTR_DATA },
+	{ "display_overlay_ext", __ATTR_DATA },
+	{ "display_visible", __ATTR_INT },
+	{ "display_method", __ATTR_INT },
+	{ "display_zoom", __ATTR_INT },
+	{ "display_evas_do_scaling", __ATTR_INT },
+	{ "display_evas_surface_sink", __ATTR_STRING },
+	{ "video_stream_format", __ATTR_INT },
+	{ "sound_volume_type", __ATTR_INT },
+	{ "pcm_extraction", __ATTR_INT },
+	{ "pcm_extraction_start_msec", __ATTR_INT },
+	{ "pcm_extraction_end_msec", __ATTR_INT },
+	{ "pd_mode", __ATTR_INT },
+	{ "pd_location", __ATTR_STRING },
+	{ "streaming_cookie", __ATTR_STRING },
+	{ "streaming_user_agent", __ATTR_STRING },
+	{ "subtitle_uri", __ATTR_STRING },
+	{ "subtitle_silent", __ATTR_INT },
+};
+
+#define __ATTR_NUM	(int)(sizeof(__attrs) / sizeof(__attrs[0]))
+
+typedef struct {
+	int value;
+	void *data;
+	int size;
+} __attr_value_s;
+
+typedef struct __message_s {
+	struct __message_s *next;
+	int id;
+	MMMessageParamType param;
+	MMPlayerVideoCapture capture;
+} __message_s;
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+	bool quit;
+
+	__message_s *head;
+	__message_s *tail;
+	unsigned int posted;
+	unsigned int delivered;
+	bool delivering;
+	int streaming;
+
+	MMPlayerStateType state;
+	bool sent_bos;
+	__attr_value_s attrs[__ATTR_NUM];
+
+	MMMessageCallback msg_cb;
+	void *msg_cb_param;
+	MMMessageCallback pd_cb;
+	void *pd_cb_param;
+	mm_player_video_stream_callback video_cb;
+	void *video_cb_param;
+	mm_player_audio_stream_callback audio_cb;
+	void *audio_cb_param;
+	mm_player_buffer_need_data_callback need_data_cb;
+	void *need_data_cb_param;
+	mm_player_buffer_enough_data_callback enough_data_cb;
+	void *enough_data_cb_param;
+
+	MMPlayerVolumeType volume;
+	int mute;
+	float rate;
+	int position;
+	int64_t position_time;
+	bool hold_seek;
+	int held_seeks;
+	int seek_count;
+	int fail_realize;
+	uint64_t audio_offset;
+	int eq[MM_AUDIO_FILTER_EQ_BAND_NUM];
+	int custom[MM_AUDIO_FILTER_CUSTOM_NUM];
+} __mock_player_s;
+
+static pthread_mutex_t __content_lock = PTHREAD_MUTEX_INITIALIZER;
+static int __content_duration = 60000;
+static int __content_width = 320;
+static int __content_height = 240;
+static int __content_sample_rate = 44100;
+static int __content_channel = 2;
+static int __alive;
+
+/*
+* Internal Implementation
+*/
+
+static int64_t __now_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static int __attr_index(const char *name)
+{
+	int i;
+	for(i = 0; i < __ATTR_NUM; i++)
+	{
+		if(strcmp(__attrs[i].name, name) == 0)
+			return i;
+	}
+	return -1;
+}
+
+/* Called with the lock held */
+static void __attr_set_int(__mock_player_s *p, const char *name, int value)
+{
+	p->attrs[__attr_index(name)].value = value;
+}
+
+static void __attr_set_string(__mock_player_s *p, const char *name, const char *value)
+{
+	__attr_value_s *attr = &p->attrs[__attr_index(name)];
+	free(attr->data);
+	attr->data = value ? strdup(value) : NULL;
+	attr->size = value ? strlen(value) : 0;
+}
+
+/* Called with the lock held, the position is frozen unless playing */
+static int __position(__mock_player_s *p)
+{
+	int duration = p->attrs[__attr_index(MM_PLAYER_CONTENT_DURATION)].value;
+	int64_t pos = p->position;
+	if(p->state == MM_PLAYER_STATE_PLAYING)
+		pos += (int64_t)((__now_ms() - p->position_time) * p->rate);
+	if(pos > duration)
+		pos = duration;
+	return pos < 0 ? 0 : (int)pos;
+}
+
+static void __position_freeze(__mock_player_s *p)
+{
+	p->position = __position(p);
+	p->position_time = __now_ms();
+}
+
+/* Called with the lock held */
+static void __post(__mock_player_s *p, int id, const MMMessageParamType *param)
+{
+	__message_s *msg = (__message_s*)calloc(1, sizeof(__message_s));
+	if(msg == NULL)
+		return;
+	msg->id = id;
+	if(param)
+		msg->param = *param;
+	if(p->tail)
+		p->tail->next = msg;
+	else
+		p->head = msg;
+	p->tail = msg;
+	p->posted++;
+	pthread_cond_broadcast(&p->cond);
+}
+
+static void __post_state(__mock_player_s *p, MMPlayerStateType current)
+{
+	MMMessageParamType param;
+	memset(&param, 0, sizeof(param));
+	param.state.previous = p->state;
+	param.state.current = current;
+	p->state = current;
+	__post(p, MM_MESSAGE_STATE_CHANGED, &param);
+}
+
+static void __post_begin_of_stream(__mock_player_s *p)
+{
+	if(p->sent_bos)
+		return;
+	p->sent_bos = TRUE;
+	__post(p, MM_MESSAGE_BEGIN_OF_STREAM, NULL);
+}
+
+static void __free_message(__message_s *msg)
+{
+	// VIDEO_CAPTURED hands the capture to the callback, which may free it
+	if(msg->capture.data)
+		g_free(msg->capture.data);
+	free(msg);
+}
+
+static void __drop_messages(__mock_player_s *p)
+{
+	while(p->head)
+	{
+		__message_s *msg = p->head;
+		p->head = msg->next;
+		__free_message(msg);
+		p->delivered++;
+	}
+	p->tail = NULL;
+	pthread_cond_broadcast(&p->cond);
+}
+
+static void __destroy(__mock_player_s *p)
+{
+	int i;
+	__drop_messages(p);
+	for(i = 0; i < __ATTR_NUM; i++)
+	{
+		if(__attrs[i].type == __ATTR_STRING)
+			free(p->attrs[i].data);
+	}
+	pthread_cond_destroy(&p->cond);
+	pthread_mutex_destroy(&p->lock);
+	free(p);
+	__atomic_sub_fetch(&__alive, 1, __ATOMIC_RELAXED);
+}
+
+static void* __message_thread(void *data)
+{
+	__mock_player_s *p = (__mock_player_s*)data;
+
+	pthread_mutex_lock(&p->lock);
+	while(!p->quit)
+	{
+		if(p->head == NULL)
+		{
+			pthread_cond_wait(&p->cond, &p->lock);
+			continue;
+		}
+		__message_s *msg = p->head;
+		p->head = msg->next;
+		if(p->head == NULL)
+			p->tail = NULL;
+
+		bool pd = msg->id == MM_MESSAGE_PD_DOWNLOADER_START || msg->id == MM_MESSAGE_PD_DOWNLOADER_END;
+		MMMessageCallback callback = pd ? p->pd_cb : p->msg_cb;
+		void *user_param = pd ? p->pd_cb_param : p->msg_cb_param;
+		p->delivering = TRUE;
+		pthread_mutex_unlock(&p->lock);
+
+		if(msg->id == MM_MESSAGE_VIDEO_CAPTURED)
+			msg->param.data = &msg->capture;
+		if(callback)
+			callback(msg->id, &msg->param, user_param);
+		__free_message(msg);
+
+		pthread_mutex_lock(&p->lock);
+		p->delivering = FALSE;
+		p->delivered++;
+		pthread_cond_broadcast(&p->cond);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return NULL;
+}
+
+static bool __on_message_thread(__mock_player_s *p)
+{
+	return pthread_equal(pthread_self(), p->thread);
+}
+
+/* Called with the lock held, waits for the message being delivered, if any */
+static void __wait_delivery(__mock_player_s *p)
+{
+	if(__on_message_thread(p))
+		return;
+	while(p->delivering)
+		pthread_cond_wait(&p->cond, &p->lock);
+}
+
+/* Called with the lock held, like the state change to NULL which joins the streaming threads */
+static void __wait_streaming(__mock_player_s *p)
+{
+	while(p->streaming > 0)
+		pthread_cond_wait(&p->cond, &p->lock);
+}
+
+/* Enters a streaming thread, returns FALSE if the pipeline is not realized */
+static bool __stream_begin(__mock_player_s *p)
+{
+	bool realized;
+	pthread_mutex_lock(&p->lock);
+	realized = p->state != MM_PLAYER_STATE_NULL && !p->quit;
+	if(realized)
+		p->streaming++;
+	pthread_mutex_unlock(&p->lock);
+	return realized;
+}
+
+static void __stream_end(__mock_player_s *p)
+{
+	pthread_mutex_lock(&p->lock);
+	p->streaming--;
+	pthread_cond_broadcast(&p->cond);
+	pthread_mutex_unlock(&p->lock);
+}
+
+#define __MOCK_PLAYER(player)	\
+	__mock_player_s *p = (__mock_player_s*)(player); \
+	if(p == NULL) return MM_ERROR_PLAYER_NOT_INITIALIZED;
+
+/*
+* mm-player
+*/
+
+int mm_player_create(MMHandleType *player)
+{
+	int i;
+	if(player == NULL)
+		return MM_ERROR_COMMON_INVALID_ARGUMENT;
+	__mock_player_s *p = (__mock_player_s*)calloc(1, sizeof(__mock_player_s));
+	if(p == NULL)
+		return MM_ERROR_PLAYER_NO_FREE_SPACE;
+
+	pthread_mutex_init(&p->lock, NULL);
+	pthread_cond_init(&p->cond, NULL);
+	p->state = MM_PLAYER_STATE_NULL;
+	p->rate = 1.0;
+	for(i = 0; i < MM_VOLUME_CHANNEL_NUM; i++)
+		p->volume.level[i] = 1.0;
+
+	pthread_mutex_lock(&__content_lock);
+	__attr_set_int(p, MM_PLAYER_CONTENT_DURATION, __content_duration);
+	__attr_set_int(p, MM_PLAYER_VIDEO_WIDTH, __content_width);
+	__attr_set_int(p, MM_PLAYER_VIDEO_HEIGHT, __content_height);
+	__attr_set_int(p, MM_PLAYER_AUDIO_SAMPLERATE, __content_sample_rate);
+	__attr_set_int(p, MM_PLAYER_AUDIO_CHANNEL, __content_channel);
+	pthread_mutex_unlock(&__content_lock);
+	__attr_set_int(p, MM_PLAYER_AUDIO_BITRATE, 128000);
+	__attr_set_int(p, "content_video_fps", 30);
+	__attr_set_int(p, "content_video_bitrate", 1000000);
+	__attr_set_int(p, "display_surface_type", MM_DISPLAY_SURFACE_X);
+	__attr_set_int(p, "display_visible", 1);
+	__attr_set_int(p, "display_evas_do_scaling", 1);
+	__attr_set_int(p, "subtitle_silent", 1);
+	__attr_set_string(p, MM_PLAYER_AUDIO_CODEC, "MPEG-4 AAC");
+	__attr_set_string(p, MM_PLAYER_VIDEO_CODEC, "H.264 / AVC");
+	__attr_set_string(p, MM_PLAYER_TAG_ALBUM, "Album");
+	__attr_set_string(p, MM_PLAYER_TAG_ARTIST, "Artist");
+	__attr_set_string(p, MM_PLAYER_TAG_AUTHOUR, "Author");
+	__attr_set_string(p, MM_PLAYER_TAG_GENRE, "Genre");
+	__attr_set_string(p, MM_PLAYER_TAG_TITLE, "Title");
+	__attr_set_string(p, MM_PLAYER_TAG_DATE, "2013");
+	__attr_set_string(p, "display_evas_surface_sink", "evasimagesink");
+
+	if(pthread_create(&p->thread, NULL, __message_thread, p) != 0)
+	{
+		pthread_cond_destroy(&p->cond);
+		pthread_mutex_destroy(&p->lock);
+		free(p);
+		return MM_ERROR_PLAYER_INTERNAL;
+	}
+	__atomic_add_fetch(&__alive, 1, __ATOMIC_RELAXED);
+	*player = (MMHandleType)(uintptr_t)p;
+	return MM_ERROR_NONE;
+}
+
+int mm_player_destroy(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->quit = TRUE;
+	pthread_cond_broadcast(&p->cond);
+	__wait_streaming(p);
+	pthread_mutex_unlock(&p->lock);
+	if(__on_message_thread(p))
+	{
+		fprintf(stderr, "mm_player_destroy() called on the message thread\n");
+		abort();
+	}
+	pthread_join(p->thread, NULL);
+	__destroy(p);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_realize(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	if(p->state != MM_PLAYER_STATE_NULL)
+		ret = MM_ERROR_PLAYER_INVALID_STATE;
+	else if(p->fail_realize != MM_ERROR_NONE)
+	{
+		ret = p->fail_realize;
+		p->fail_realize = MM_ERROR_NONE;
+	}
+	else if(p->attrs[__attr_index(MM_PLAYER_CONTENT_URI)].data == NULL)
+		ret = MM_ERROR_PLAYER_INVALID_URI;
+	else
+	{
+		p->sent_bos = FALSE;
+		p->position = 0;
+		p->position_time = __now_ms();
+		__post_state(p, MM_PLAYER_STATE_READY);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_unrealize(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	if(p->state == MM_PLAYER_STATE_NULL)
+	{
+		pthread_mutex_unlock(&p->lock);
+		return MM_ERROR_PLAYER_INVALID_STATE;
+	}
+	// like removing the bus watch : what is queued is lost, what is being delivered completes
+	__drop_messages(p);
+	__wait_delivery(p);
+	__wait_streaming(p);
+	p->state = MM_PLAYER_STATE_NULL;
+	p->held_seeks = 0;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_get_state(MMHandleType player, MMPlayerStateType *state)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	*state = p->state;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_volume(MMHandleType player, MMPlayerVolumeType *volume)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->volume = *volume;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_get_volume(MMHandleType player, MMPlayerVolumeType *volume)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	*volume = p->volume;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+static int __play(__mock_player_s *p, bool from_ready)
+{
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	if(p->state == MM_PLAYER_STATE_PAUSED || (from_ready && p->state == MM_PLAYER_STATE_READY))
+	{
+		p->position_time = __now_ms();
+		__post_state(p, MM_PLAYER_STATE_PLAYING);
+		__post_begin_of_stream(p);
+	}
+	else
+		ret = MM_ERROR_PLAYER_INVALID_STATE;
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_start(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	return __play(p, TRUE);
+}
+
+int mm_player_resume(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	return __play(p, FALSE);
+}
+
+int mm_player_stop(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	if(p->state == MM_PLAYER_STATE_PLAYING || p->state == MM_PLAYER_STATE_PAUSED)
+	{
+		p->sent_bos = FALSE;
+		p->position = 0;
+		p->position_time = __now_ms();
+		p->held_seeks = 0;
+		__post_state(p, MM_PLAYER_STATE_READY);
+	}
+	else
+		ret = MM_ERROR_PLAYER_INVALID_STATE;
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_pause(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	// from READY, this is the preroll : the pipeline stops on the first frame
+	if(p->state == MM_PLAYER_STATE_PLAYING || p->state == MM_PLAYER_STATE_READY)
+	{
+		__position_freeze(p);
+		__post_state(p, MM_PLAYER_STATE_PAUSED);
+	}
+	else
+		ret = MM_ERROR_PLAYER_INVALID_STATE;
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_set_position(MMHandleType player, MMPlayerPosFormatType format, int pos)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	int duration = p->attrs[__attr_index(MM_PLAYER_CONTENT_DURATION)].value;
+	if(p->state != MM_PLAYER_STATE_PLAYING && p->state != MM_PLAYER_STATE_PAUSED)
+		ret = MM_ERROR_PLAYER_INVALID_STATE;
+	else if(pos < 0 || (format == MM_PLAYER_POS_FORMAT_PERCENT && pos > 100))
+		ret = MM_ERROR_COMMON_INVALID_ARGUMENT;
+	else
+	{
+		if(format == MM_PLAYER_POS_FORMAT_PERCENT)
+			pos = (int)((int64_t)duration * pos / 100);
+		p->position = pos > duration ? duration : pos;
+		p->position_time = __now_ms();
+		p->seek_count++;
+		if(p->hold_seek)
+			p->held_seeks++;
+		else
+			__post(p, MM_MESSAGE_SEEK_COMPLETED, NULL);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_get_position(MMHandleType player, MMPlayerPosFormatType format, int *pos)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	int duration = p->attrs[__attr_index(MM_PLAYER_CONTENT_DURATION)].value;
+	*pos = __position(p);
+	if(format == MM_PLAYER_POS_FORMAT_PERCENT)
+		*pos = duration > 0 ? (int)((int64_t)*pos * 100 / duration) : 0;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_get_buffer_position(MMHandleType player, MMPlayerPosFormatType format, int *start_pos, int *stop_pos)
+{
+	__MOCK_PLAYER(player);
+	*start_pos = 0;
+	*stop_pos = format == MM_PLAYER_POS_FORMAT_PERCENT ? 100 : p->attrs[__attr_index(MM_PLAYER_CONTENT_DURATION)].value;
+	return MM_ERROR_NONE;
+}
+
+int mm_player_adjust_subtitle_position(MMHandleType player, MMPlayerPosFormatType format, int offset)
+{
+	__MOCK_PLAYER(player);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_message_callback(MMHandleType player, MMMessageCallback callback, void *user_param)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->msg_cb = callback;
+	p->msg_cb_param = user_param;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_pd_message_callback(MMHandleType player, MMMessageCallback callback, void *user_param)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->pd_cb = callback;
+	p->pd_cb_param = user_param;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_mute(MMHandleType player, int mute)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->mute = mute;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_get_mute(MMHandleType player, int *mute)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	*mute = p->mute;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_play_speed(MMHandleType player, float rate)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	__position_freeze(p);
+	p->rate = rate;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_get_track_count(MMHandleType player, MMPlayerTrackType track_type, int *count)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	if(track_type == MM_PLAYER_TRACK_TYPE_AUDIO)
+		*count = p->attrs[__attr_index(MM_PLAYER_AUDIO_CHANNEL)].value > 0;
+	else if(track_type == MM_PLAYER_TRACK_TYPE_VIDEO)
+		*count = p->attrs[__attr_index(MM_PLAYER_VIDEO_WIDTH)].value > 0;
+	else
+		*count = 0;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_get_pd_status(MMHandleType player, guint64 *current_pos, guint64 *total_size)
+{
+	__MOCK_PLAYER(player);
+	*current_pos = 0;
+	*total_size = 0;
+	return MM_ERROR_NONE;
+}
+
+int mm_player_do_video_capture(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	if(p->state != MM_PLAYER_STATE_PLAYING && p->state != MM_PLAYER_STATE_PAUSED)
+		ret = MM_ERROR_PLAYER_INVALID_STATE;
+	else if(p->attrs[__attr_index("display_surface_type")].value == MM_DISPLAY_SURFACE_NULL)
+		ret = MM_ERROR_PLAYER_NO_OP;
+	else
+	{
+		int width = p->attrs[__attr_index(MM_PLAYER_VIDEO_WIDTH)].value;
+		int height = p->attrs[__attr_index(MM_PLAYER_VIDEO_HEIGHT)].value;
+		__post(p, MM_MESSAGE_VIDEO_CAPTURED, NULL);
+		// RGB888, like the captures of mm-player
+		p->tail->capture.size = width * height * 3;
+		p->tail->capture.data = g_malloc0(p->tail->capture.size);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_push_buffer(MMHandleType player, unsigned char *buf, int size)
+{
+	__MOCK_PLAYER(player);
+	return buf && size > 0 ? MM_ERROR_NONE : MM_ERROR_COMMON_INVALID_ARGUMENT;
+}
+
+static int __set_attributes(__mock_player_s *p, char **err_attr_name, const char *name, va_list args)
+{
+	for(; name; name = va_arg(args, const char*))
+	{
+		int index = __attr_index(name);
+		if(index < 0)
+		{
+			fprintf(stderr, "mm_player_set_attribute() : unknown attribute %s\n", name);
+			if(err_attr_name)
+				*err_attr_name = strdup(name);
+			return MM_ERROR_COMMON_ATTR_NOT_EXIST;
+		}
+		__attr_value_s *attr = &p->attrs[index];
+		if(__attrs[index].type == __ATTR_INT)
+		{
+			attr->value = va_arg(args, int);
+			continue;
+		}
+		void *data = va_arg(args, void*);
+		int size = va_arg(args, int);
+		if(__attrs[index].type == __ATTR_STRING)
+		{
+			free(attr->data);
+			attr->data = data ? strndup((const char*)data, size) : NULL;
+			attr->size = data ? size : 0;
+		}
+		else
+		{
+			// data attributes keep the pointer, as in mm-player
+			attr->data = data;
+			attr->size = size;
+		}
+	}
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_attribute(MMHandleType player, char **err_attr_name, const char *first_attribute_name, ...)
+{
+	__MOCK_PLAYER(player);
+	va_list args;
+	va_start(args, first_attribute_name);
+	pthread_mutex_lock(&p->lock);
+	int ret = __set_attributes(p, err_attr_name, first_attribute_name, args);
+	pthread_mutex_unlock(&p->lock);
+	va_end(args);
+	return ret;
+}
+
+int mm_player_get_attribute(MMHandleType player, char **err_attr_name, const char *first_attribute_name, ...)
+{
+	__MOCK_PLAYER(player);
+	const char *name;
+	int ret = MM_ERROR_NONE;
+	va_list args;
+
+	va_start(args, first_attribute_name);
+	pthread_mutex_lock(&p->lock);
+	for(name = first_attribute_name; name; name = va_arg(args, const char*))
+	{
+		int index = __attr_index(name);
+		if(index < 0)
+		{
+			fprintf(stderr, "mm_player_get_attribute() : unknown attribute %s\n", name);
+			if(err_attr_name)
+				*err_attr_name = strdup(name);
+			ret = MM_ERROR_COMMON_ATTR_NOT_EXIST;
+			break;
+		}
+		__attr_value_s *attr = &p->attrs[index];
+		if(__attrs[index].type == __ATTR_INT)
+		{
+			*va_arg(args, int*) = attr->value;
+			continue;
+		}
+		*va_arg(args, void**) = attr->data;
+		*va_arg(args, int*) = attr->size;
+	}
+	pthread_mutex_unlock(&p->lock);
+	va_end(args);
+	return ret;
+}
+
+int mm_player_set_video_stream_callback(MMHandleType player, mm_player_video_stream_callback callback, void *user_param)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->video_cb = callback;
+	p->video_cb_param = user_param;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_audio_stream_callback(MMHandleType player, mm_player_audio_stream_callback callback, void *user_param)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->audio_cb = callback;
+	p->audio_cb_param = user_param;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_audio_buffer_callback(MMHandleType player, mm_player_audio_stream_callback callback, void *user_param)
+{
+	return mm_player_set_audio_stream_callback(player, callback, user_param);
+}
+
+int mm_player_set_pcm_extraction_mode(MMHandleType player, bool sync)
+{
+	__MOCK_PLAYER(player);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_buffer_need_data_callback(MMHandleType player, mm_player_buffer_need_data_callback callback, void *user_param)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->need_data_cb = callback;
+	p->need_data_cb_param = user_param;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_set_buffer_enough_data_callback(MMHandleType player, mm_player_buffer_enough_data_callback callback, void *user_param)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->enough_data_cb = callback;
+	p->enough_data_cb_param = user_param;
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+/*
+* Sound effects : the levels are only stored
+*/
+
+int mm_player_sound_filter_custom_set_level(MMHandleType player, MMAudioFilterCustom filter, int option, int level)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	if(filter == MM_AUDIO_FILTER_CUSTOM_EQ && option >= 0 && option < MM_AUDIO_FILTER_EQ_BAND_NUM)
+		p->eq[option] = level;
+	else if(filter > MM_AUDIO_FILTER_CUSTOM_EQ && filter < MM_AUDIO_FILTER_CUSTOM_NUM)
+		p->custom[filter] = level;
+	else
+		ret = MM_ERROR_COMMON_INVALID_ARGUMENT;
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_sound_filter_custom_get_level(MMHandleType player, MMAudioFilterCustom filter, int option, int *level)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	if(filter == MM_AUDIO_FILTER_CUSTOM_EQ && option >= 0 && option < MM_AUDIO_FILTER_EQ_BAND_NUM)
+		*level = p->eq[option];
+	else if(filter > MM_AUDIO_FILTER_CUSTOM_EQ && filter < MM_AUDIO_FILTER_CUSTOM_NUM)
+		*level = p->custom[filter];
+	else
+		ret = MM_ERROR_COMMON_INVALID_ARGUMENT;
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_sound_filter_custom_get_level_range(MMHandleType player, MMAudioFilterCustom filter, int *min, int *max)
+{
+	__MOCK_PLAYER(player);
+	*min = -10;
+	*max = 10;
+	return MM_ERROR_NONE;
+}
+
+int mm_player_sound_filter_custom_get_eq_bands_number(MMHandleType player, int *bands)
+{
+	__MOCK_PLAYER(player);
+	*bands = MM_AUDIO_FILTER_EQ_BAND_NUM;
+	return MM_ERROR_NONE;
+}
+
+int mm_player_sound_filter_custom_set_level_eq_from_list(MMHandleType player, int *level_list, int size)
+{
+	__MOCK_PLAYER(player);
+	if(size != MM_AUDIO_FILTER_EQ_BAND_NUM)
+		return MM_ERROR_COMMON_INVALID_ARGUMENT;
+	pthread_mutex_lock(&p->lock);
+	memcpy(p->eq, level_list, sizeof(p->eq));
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_sound_filter_custom_apply(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_sound_filter_custom_clear_eq_all(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	memset(p->eq, 0, sizeof(p->eq));
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_sound_filter_custom_clear_ext_all(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	memset(p->custom, 0, sizeof(p->custom));
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_sound_filter_preset_apply(MMHandleType player, int preset)
+{
+	__MOCK_PLAYER(player);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_is_supported_custom_filter_type(MMHandleType player, MMAudioFilterCustom filter)
+{
+	__MOCK_PLAYER(player);
+	return filter >= MM_AUDIO_FILTER_CUSTOM_EQ && filter < MM_AUDIO_FILTER_CUSTOM_NUM ? MM_ERROR_NONE : MM_ERROR_PLAYER_SOUND_EFFECT_NOT_SUPPORTED_FILTER;
+}
+
+int mm_player_is_supported_preset_filter_type(MMHandleType player, int preset)
+{
+	__MOCK_PLAYER(player);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_get_foreach_present_supported_filter_type(MMHandleType player, MMAudioFilterType filter_type, mm_player_supported_filter_cb foreach_cb, void *user_data)
+{
+	__MOCK_PLAYER(player);
+	int i;
+	int count = filter_type == MM_AUDIO_FILTER_TYPE_CUSTOM ? MM_AUDIO_FILTER_CUSTOM_NUM : 4;
+	for(i = 0; i < count; i++)
+	{
+		if(!foreach_cb(filter_type, i, user_data))
+			break;
+	}
+	return MM_ERROR_NONE;
+}
+
+/*
+* Controls of the unit tests
+*/
+
+int mm_player_mock_post_message(MMHandleType player, int message, const MMMessageParamType *param)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	__post(p, message, param);
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_mock_post_begin_of_stream(MMHandleType player)
+{
+	return mm_player_mock_post_message(player, MM_MESSAGE_BEGIN_OF_STREAM, NULL);
+}
+
+int mm_player_mock_post_end_of_stream(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	p->position = p->attrs[__attr_index(MM_PLAYER_CONTENT_DURATION)].value;
+	p->position_time = __now_ms();
+	__post(p, MM_MESSAGE_END_OF_STREAM, NULL);
+	pthread_mutex_unlock(&p->lock);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_mock_post_buffering(MMHandleType player, int percent)
+{
+	MMMessageParamType param;
+	memset(&param, 0, sizeof(param));
+	param.connection.buffering = percent;
+	return mm_player_mock_post_message(player, MM_MESSAGE_BUFFERING, &param);
+}
+
+int mm_player_mock_post_error(MMHandleType player, int code)
+{
+	MMMessageParamType param;
+	memset(&param, 0, sizeof(param));
+	param.code = code;
+	return mm_player_mock_post_message(player, MM_MESSAGE_ERROR, &param);
+}
+
+void mm_player_mock_flush(MMHandleType player)
+{
+	__mock_player_s *p = (__mock_player_s*)player;
+	if(p == NULL || __on_message_thread(p))
+		return;
+	pthread_mutex_lock(&p->lock);
+	unsigned int posted = p->posted;
+	while((int)(p->delivered - posted) < 0)
+		pthread_cond_wait(&p->cond, &p->lock);
+	pthread_mutex_unlock(&p->lock);
+}
+
+void mm_player_mock_hold_seek(MMHandleType player, bool hold)
+{
+	__mock_player_s *p = (__mock_player_s*)player;
+	pthread_mutex_lock(&p->lock);
+	p->hold_seek = hold;
+	pthread_mutex_unlock(&p->lock);
+}
+
+int mm_player_mock_complete_seek(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	int ret = MM_ERROR_NONE;
+	pthread_mutex_lock(&p->lock);
+	if(p->held_seeks > 0)
+	{
+		p->held_seeks--;
+		__post(p, MM_MESSAGE_SEEK_COMPLETED, NULL);
+	}
+	else
+		ret = MM_ERROR_PLAYER_INVALID_STATE;
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+}
+
+int mm_player_mock_get_seek_count(MMHandleType player)
+{
+	__mock_player_s *p = (__mock_player_s*)player;
+	pthread_mutex_lock(&p->lock);
+	int count = p->seek_count;
+	pthread_mutex_unlock(&p->lock);
+	return count;
+}
+
+void mm_player_mock_fail_realize(MMHandleType player, int error)
+{
+	__mock_player_s *p = (__mock_player_s*)player;
+	pthread_mutex_lock(&p->lock);
+	p->fail_realize = error;
+	pthread_mutex_unlock(&p->lock);
+}
+
+int mm_player_mock_push_video_frame(MMHandleType player, int width, int height, int bpp)
+{
+	__MOCK_PLAYER(player);
+	int size = bpp > 0 ? width * height * bpp : width * height + ((width + 1) / 2) * ((height + 1) / 2) * 2;
+	unsigned char *frame = (unsigned char*)malloc(size);
+	if(frame == NULL)
+		return MM_ERROR_PLAYER_NO_FREE_SPACE;
+	int i;
+	for(i = 0; i < size; i++)
+		frame[i] = (unsigned char)(i % 251);
+
+	if(!__stream_begin(p))
+	{
+		free(frame);
+		return MM_ERROR_PLAYER_INVALID_STATE;
+	}
+	pthread_mutex_lock(&p->lock);
+	// like the caps negotiated for the stream
+	p->attrs[__attr_index("video_stream_format")].value = bpp == 0 ? MM_PIXEL_FORMAT_I420 : (bpp == 2 ? MM_PIXEL_FORMAT_RGB565 : (bpp == 4 ? MM_PIXEL_FORMAT_ARGB : MM_PIXEL_FORMAT_INVALID));
+	mm_player_video_stream_callback callback = p->video_cb;
+	void *user_param = p->video_cb_param;
+	pthread_mutex_unlock(&p->lock);
+	if(callback)
+		callback(frame, size, user_param, width, height);
+	__stream_end(p);
+	free(frame);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_mock_push_audio_frame(MMHandleType player, unsigned int size)
+{
+	__MOCK_PLAYER(player);
+	unsigned char *samples = (unsigned char*)malloc(size);
+	if(samples == NULL)
+		return MM_ERROR_PLAYER_NO_FREE_SPACE;
+	if(!__stream_begin(p))
+	{
+		free(samples);
+		return MM_ERROR_PLAYER_INVALID_STATE;
+	}
+	pthread_mutex_lock(&p->lock);
+	mm_player_audio_stream_callback callback = p->audio_cb;
+	void *user_param = p->audio_cb_param;
+	uint64_t offset = p->audio_offset;
+	p->audio_offset += size;
+	pthread_mutex_unlock(&p->lock);
+
+	unsigned int i;
+	for(i = 0; i < size; i++)
+		samples[i] = (unsigned char)((offset + i) % 251);
+	if(callback)
+		callback(samples, size, user_param);
+	__stream_end(p);
+	free(samples);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_mock_need_data(MMHandleType player, unsigned int size)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	mm_player_buffer_need_data_callback callback = p->need_data_cb;
+	void *user_param = p->need_data_cb_param;
+	pthread_mutex_unlock(&p->lock);
+	if(callback)
+		callback(size, user_param);
+	return MM_ERROR_NONE;
+}
+
+int mm_player_mock_enough_data(MMHandleType player)
+{
+	__MOCK_PLAYER(player);
+	pthread_mutex_lock(&p->lock);
+	mm_player_buffer_enough_data_callback callback = p->enough_data_cb;
+	void *user_param = p->enough_data_cb_param;
+	pthread_mutex_unlock(&p->lock);
+	if(callback)
+		callback(user_param);
+	return MM_ERROR_NONE;
+}
+
+void mm_player_mock_set_content(int duration, int width, int height, int sample_rate, int channel)
+{
+	pthread_mutex_lock(&__content_lock);
+	__content_duration = duration;
+	__content_width = width;
+	__content_height = height;
+	__content_sample_rate = sample_rate;
+	__content_channel = channel;
+	pthread_mutex_unlock(&__content_lock);
+}
+
+/* Used by mm_file_mock.c */
+void __mm_player_mock_get_content(int *duration, int *width, int *height, int *sample_rate, int *channel)
+{
+	pthread_mutex_lock(&__content_lock);
+	*duration = __content_duration;
+	*width = __content_width;
+	*height = __content_height;
+	*sample_rate = __content_sample_rate;
+	*channel = __content_channel;
+	pthread_mutex_unlock(&__content_lock);
+}
+
+int mm_player_mock_get_alive_count(void)
+{
+	return __atomic_load_n(&__alive, __ATOMIC_RELAXED);
+}
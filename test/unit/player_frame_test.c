@@ -0,0 +1,213 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include "player_unit_test.h"
+
+#define WIDTH	320
+#define HEIGHT	240
+
+static const char *uri;
+
+typedef struct {
+	int frames;
+	int bad_frames;
+	player_video_frame_format_e format;
+	int last_timestamp;
+	player_video_frame_h kept;
+	int captured;
+	unsigned int captured_size;
+	int thumbnails;
+	int thumbnail_errors;
+	int thumbnail_order[4];
+	unsigned char thumbnail_pixel[3];
+} frames_s;
+
+static void __video_frame_cb(player_video_frame_h frame, void *user_data)
+{
+	frames_s *f = (frames_s*)user_data;
+	unsigned char *data = NULL;
+	unsigned int size = 0;
+	int width = 0;
+	int height = 0;
+	int timestamp = -1;
+
+	if(player_video_frame_get_data(frame, &data, &size) != PLAYER_ERROR_NONE || data[1] != 1
+		|| player_video_frame_get_resolution(frame, &width, &height) != PLAYER_ERROR_NONE || width != WIDTH || height != HEIGHT
+		|| player_video_frame_get_format(frame, &f->format) != PLAYER_ERROR_NONE
+		|| player_video_frame_get_timestamp(frame, &timestamp) != PLAYER_ERROR_NONE || timestamp < f->last_timestamp)
+		test_count(&f->bad_frames);
+	f->last_timestamp = timestamp;
+
+	// the first frame is held past the callback
+	if(f->kept == NULL && player_video_frame_ref(frame) == PLAYER_ERROR_NONE)
+		f->kept = frame;
+	test_count(&f->frames);
+}
+
+static void __captured_cb(unsigned char *data, int width, int height, unsigned int size, void *user_data)
+{
+	frames_s *f = (frames_s*)user_data;
+	f->captured_size = size;
+	test_count(&f->captured);
+}
+
+static void __thumbnail_cb(int error, int index, unsigned char *data, int width, int height, unsigned int size, void *user_data)
+{
+	frames_s *f = (frames_s*)user_data;
+	if(error != PLAYER_ERROR_NONE || data == NULL || size != (unsigned int)width * height * 3)
+		test_count(&f->thumbnail_errors);
+	else
+		memcpy(f->thumbnail_pixel, data, sizeof(f->thumbnail_pixel));
+	f->thumbnail_order[f->thumbnails] = index;
+	test_count(&f->thumbnails);
+}
+
+static void test_video_frame(void)
+{
+	frames_s f;
+	memset(&f, 0, sizeof(f));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_set_video_frame_cb(player, __video_frame_cb, &f));
+	TEST_CHECK_OK(player_prepare(player));
+
+	// not playing yet, skipped
+	mm_player_mock_push_video_frame(test_mm_handle(player), WIDTH, HEIGHT, 0);
+	TEST_CHECK(f.frames == 0);
+
+	TEST_CHECK_OK(player_start(player));
+	int i;
+	for(i = 0; i < 3; i++)
+		mm_player_mock_push_video_frame(test_mm_handle(player), WIDTH, HEIGHT, 0);
+	TEST_CHECK(f.frames == 3);
+	TEST_CHECK(f.bad_frames == 0);
+	TEST_CHECK(f.kept != NULL);
+	TEST_CHECK(f.format == PLAYER_VIDEO_FRAME_FORMAT_I420);
+
+	int count = 0;
+	TEST_CHECK_OK(player_video_frame_get_plane_count(f.kept, &count));
+	TEST_CHECK(count == 3);
+
+	unsigned int dropped = 1;
+	TEST_CHECK_OK(player_get_video_frame_drop_count(player, &dropped));
+	TEST_CHECK(dropped == 0);
+
+	int width = 0;
+	int height = 0;
+	TEST_CHECK_OK(player_video_frame_get_resolution(f.kept, &width, &height));
+	TEST_CHECK(width == WIDTH && height == HEIGHT);
+	TEST_CHECK_OK(player_video_frame_unref(f.kept));
+
+	// the format comes from the pipeline, not from the size : 3 bytes per pixel is none it reports
+	mm_player_mock_push_video_frame(test_mm_handle(player), WIDTH, HEIGHT, 3);
+	TEST_CHECK(f.format == PLAYER_VIDEO_FRAME_FORMAT_UNKNOWN);
+	mm_player_mock_push_video_frame(test_mm_handle(player), WIDTH, HEIGHT, 4);
+	TEST_CHECK(f.format == PLAYER_VIDEO_FRAME_FORMAT_ARGB8888);
+	TEST_CHECK(f.bad_frames == 0);
+
+	TEST_CHECK_OK(player_unset_video_frame_cb(player));
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_capture(void)
+{
+	frames_s f;
+	memset(&f, 0, sizeof(f));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_set_display(player, PLAYER_DISPLAY_TYPE_X11, (player_display_h)1));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+	TEST_CHECK_OK(player_capture_video(player, __captured_cb, &f));
+	TEST_CHECK(test_wait_count(&f.captured, 1));
+	TEST_CHECK(f.captured_size == WIDTH * HEIGHT * 3);
+
+	// the capture callback is free again
+	TEST_CHECK_OK(player_capture_video(player, __captured_cb, &f));
+	TEST_CHECK(test_wait_count(&f.captured, 2));
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_thumbnails(void)
+{
+	frames_s f;
+	const int positions[] = { 30000, 10000, 20000 };
+	memset(&f, 0, sizeof(f));
+
+	// without a display, the thumbnails come from the decoded frames
+	player_h player = test_create_prepared(uri);
+	TEST_CHECK_OK(player_extract_thumbnails(player, positions, 3, 80, 60, __thumbnail_cb, &f));
+	while(__atomic_load_n(&f.thumbnails, __ATOMIC_ACQUIRE) < 3)
+	{
+		mm_player_mock_push_video_frame(test_mm_handle(player), WIDTH, HEIGHT, 0);
+		test_sleep_ms(1);
+	}
+	TEST_CHECK(f.thumbnail_errors == 0);
+	// sorted by position
+	TEST_CHECK(f.thumbnail_order[0] == 1 && f.thumbnail_order[1] == 2 && f.thumbnail_order[2] == 0);
+	TEST_CHECK(mm_player_mock_get_seek_count(test_mm_handle(player)) == 3);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_thumbnails_argb(void)
+{
+	frames_s f;
+	const int positions[] = { 10000 };
+	memset(&f, 0, sizeof(f));
+
+	// the pipeline reports ARGB for 4 bytes per pixel, as player_video_frame_get_format() does
+	player_h player = test_create_prepared(uri);
+	TEST_CHECK_OK(player_extract_thumbnails(player, positions, 1, 80, 60, __thumbnail_cb, &f));
+	while(__atomic_load_n(&f.thumbnails, __ATOMIC_ACQUIRE) < 1)
+	{
+		mm_player_mock_push_video_frame(test_mm_handle(player), WIDTH, HEIGHT, 4);
+		test_sleep_ms(1);
+	}
+	TEST_CHECK(f.thumbnail_errors == 0);
+	TEST_CHECK(f.thumbnail_pixel[0] == 1 && f.thumbnail_pixel[1] == 2 && f.thumbnail_pixel[2] == 3);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_thumbnails_cancel(void)
+{
+	frames_s f;
+	const int positions[] = { 10000, 20000 };
+	memset(&f, 0, sizeof(f));
+
+	player_h player = test_create_prepared(uri);
+	TEST_CHECK_OK(player_extract_thumbnails(player, positions, 2, 80, 60, __thumbnail_cb, &f));
+	TEST_CHECK(player_extract_thumbnails(player, positions, 2, 80, 60, __thumbnail_cb, &f) == PLAYER_ERROR_INVALID_OPERATION);
+	TEST_CHECK_OK(player_cancel_thumbnails(player));
+	TEST_CHECK(f.thumbnails == 0);
+
+	bool muted = TRUE;
+	TEST_CHECK_OK(player_is_muted(player, &muted));
+	TEST_CHECK(!muted);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+int main(int argc, char *argv[])
+{
+	uri = argv[0];
+	test_init();
+	TEST_RUN(test_video_frame);
+	TEST_RUN(test_capture);
+	TEST_RUN(test_thumbnails);
+	TEST_RUN(test_thumbnails_argb);
+	TEST_RUN(test_thumbnails_cancel);
+	return 0;
+}
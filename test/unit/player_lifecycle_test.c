@@ -0,0 +1,397 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include "player_unit_test.h"
+
+static const char *uri;
+
+typedef struct {
+	int prepared;
+	int started;
+	int completed;
+	int buffering;
+	int buffering_percent;
+	int error;
+	int error_code;
+	int events;
+	unsigned int event_mask;
+	int track_changed;
+	int frames;
+} counters_s;
+
+static void __prepared_cb(void *user_data)
+{
+	test_count(&((counters_s*)user_data)->prepared);
+}
+
+static void __started_cb(void *user_data)
+{
+	test_count(&((counters_s*)user_data)->started);
+}
+
+static void __completed_cb(void *user_data)
+{
+	test_count(&((counters_s*)user_data)->completed);
+}
+
+static void __buffering_cb(int percent, void *user_data)
+{
+	counters_s *c = (counters_s*)user_data;
+	__atomic_store_n(&c->buffering_percent, percent, __ATOMIC_RELAXED);
+	test_count(&c->buffering);
+}
+
+static void __error_cb(int error_code, void *user_data)
+{
+	counters_s *c = (counters_s*)user_data;
+	__atomic_store_n(&c->error_code, error_code, __ATOMIC_RELAXED);
+	test_count(&c->error);
+}
+
+static void __event_cb(player_event_e event, int value, void *user_data)
+{
+	counters_s *c = (counters_s*)user_data;
+	__atomic_or_fetch(&c->event_mask, event, __ATOMIC_RELAXED);
+	test_count(&c->events);
+}
+
+static void __track_changed_cb(void *user_data)
+{
+	test_count(&((counters_s*)user_data)->track_changed);
+}
+
+static void __video_frame_cb(unsigned char *data, int width, int height, unsigned int size, void *user_data)
+{
+	test_count(&((counters_s*)user_data)->frames);
+}
+
+static bool __wait_next_prepared(player_h player)
+{
+	int waited;
+	for(waited = 0; waited < TEST_WAIT_TIMEOUT; waited++)
+	{
+		if(__atomic_load_n(&((player_s*)player)->is_next_prepared, __ATOMIC_ACQUIRE))
+			return TRUE;
+		test_sleep_ms(1);
+	}
+	return FALSE;
+}
+
+static void test_playback(void)
+{
+	counters_s c;
+	player_state_e state;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_set_started_cb(player, __started_cb, &c));
+	TEST_CHECK_OK(player_set_completed_cb(player, __completed_cb, &c));
+	TEST_CHECK_OK(player_set_buffering_cb(player, __buffering_cb, &c));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_get_state(player, &state));
+	TEST_CHECK(state == PLAYER_STATE_READY);
+
+	int duration = 0;
+	TEST_CHECK_OK(player_get_duration(player, &duration));
+	TEST_CHECK(duration == 60000);
+
+	TEST_CHECK_OK(player_start(player));
+	TEST_CHECK(test_wait_count(&c.started, 1));
+	TEST_CHECK_OK(player_get_state(player, &state));
+	TEST_CHECK(state == PLAYER_STATE_PLAYING);
+
+	mm_player_mock_post_buffering(test_mm_handle(player), 50);
+	TEST_CHECK(test_wait_count(&c.buffering, 1));
+	TEST_CHECK(c.buffering_percent == 50);
+
+	mm_player_mock_post_end_of_stream(test_mm_handle(player));
+	TEST_CHECK(test_wait_count(&c.completed, 1));
+
+	int position = 0;
+	TEST_CHECK_OK(player_get_position(player, &position));
+	TEST_CHECK(position == duration);
+
+	TEST_CHECK_OK(player_stop(player));
+	TEST_CHECK_OK(player_unprepare(player));
+	TEST_CHECK_OK(player_get_state(player, &state));
+	TEST_CHECK(state == PLAYER_STATE_IDLE);
+	TEST_CHECK_OK(player_destroy(player));
+	TEST_CHECK(c.started == 1 && c.completed == 1);
+}
+
+static void test_prepare_async(void)
+{
+	counters_s c;
+	player_state_e state;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_prepare_async(player, __prepared_cb, &c));
+	TEST_CHECK(test_wait_count(&c.prepared, 1));
+	TEST_CHECK_OK(player_get_state(player, &state));
+	TEST_CHECK(state == PLAYER_STATE_READY);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_prepare_failure(void)
+{
+	player_state_e state;
+	player_h player = test_create(uri);
+	mm_player_mock_fail_realize(test_mm_handle(player), MM_ERROR_PLAYER_CODEC_NOT_FOUND);
+	TEST_CHECK(player_prepare(player) != PLAYER_ERROR_NONE);
+	TEST_CHECK_OK(player_get_state(player, &state));
+	TEST_CHECK(state == PLAYER_STATE_IDLE);
+
+	// the failure is not sticky
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_error(void)
+{
+	counters_s c;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create_prepared(uri);
+	TEST_CHECK_OK(player_set_error_cb(player, __error_cb, &c));
+	TEST_CHECK_OK(player_start(player));
+	mm_player_mock_post_error(test_mm_handle(player), MM_ERROR_PLAYER_CODEC_NOT_FOUND);
+	TEST_CHECK(test_wait_count(&c.error, 1));
+	TEST_CHECK(c.error_code != PLAYER_ERROR_NONE);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void __post_buffering(player_h player, const int *percents, int count)
+{
+	int i;
+	for(i = 0; i < count; i++)
+		mm_player_mock_post_buffering(test_mm_handle(player), percents[i]);
+	mm_player_mock_flush(test_mm_handle(player));
+}
+
+static void test_buffering_coalescing(void)
+{
+	static const int by_delta[] = { 0, 5, 12, 15, 100 };
+	static const int by_interval[] = { 0, 10, 20, 30, 100, 0 };
+	unsigned int delivered = 0;
+	unsigned int coalesced = 0;
+	counters_s c;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create_prepared(uri);
+	TEST_CHECK_OK(player_set_buffering_cb(player, __buffering_cb, &c));
+
+	// 5 and 15 are within 10 % of the last delivered event, 0 and 100 are always delivered
+	TEST_CHECK_OK(player_set_buffering_coalescing(player, 0, 10));
+	__post_buffering(player, by_delta, 5);
+	TEST_CHECK_OK(player_get_buffering_event_count(player, &delivered, &coalesced));
+	TEST_CHECK(delivered == 3 && coalesced == 2);
+	TEST_CHECK(c.buffering == 3 && c.buffering_percent == 100);
+
+	// nothing between the start and the end within a minute of the start
+	TEST_CHECK_OK(player_set_buffering_coalescing(player, 60000, 0));
+	__post_buffering(player, by_interval, 6);
+	TEST_CHECK_OK(player_get_buffering_event_count(player, &delivered, &coalesced));
+	TEST_CHECK(delivered == 6 && coalesced == 5);
+	TEST_CHECK(c.buffering == 6 && c.buffering_percent == 0);
+
+	// without coalescing, every event is delivered
+	TEST_CHECK_OK(player_set_buffering_coalescing(player, 0, 0));
+	__post_buffering(player, by_delta, 5);
+	TEST_CHECK_OK(player_get_buffering_event_count(player, &delivered, &coalesced));
+	TEST_CHECK(delivered == 11 && coalesced == 5);
+	TEST_CHECK(c.buffering == 11);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_dispatch_thread(void)
+{
+	counters_s c;
+	player_dispatch_stats_s stats;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_set_dispatch_mode(player, PLAYER_DISPATCH_MODE_THREAD, NULL));
+	TEST_CHECK_OK(player_set_started_cb(player, __started_cb, &c));
+	TEST_CHECK_OK(player_set_completed_cb(player, __completed_cb, &c));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+	mm_player_mock_post_end_of_stream(test_mm_handle(player));
+	TEST_CHECK(test_wait_count(&c.completed, 1));
+	TEST_CHECK(c.started == 1);
+	TEST_CHECK_OK(player_get_dispatch_stats(player, &stats));
+	TEST_CHECK(stats.dispatched >= 2);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_event_listener(void)
+{
+	counters_s c;
+	int id = -1;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_add_event_listener(player, PLAYER_EVENT_COMPLETED | PLAYER_EVENT_BUFFERING, __event_cb, &c, &id));
+	TEST_CHECK(id >= 0);
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+	mm_player_mock_post_buffering(test_mm_handle(player), 100);
+	mm_player_mock_post_end_of_stream(test_mm_handle(player));
+	TEST_CHECK(test_wait_count(&c.events, 2));
+	mm_player_mock_flush(test_mm_handle(player));
+	TEST_CHECK(c.event_mask == (PLAYER_EVENT_COMPLETED | PLAYER_EVENT_BUFFERING));
+
+	TEST_CHECK_OK(player_remove_event_listener(player, id));
+	mm_player_mock_post_end_of_stream(test_mm_handle(player));
+	mm_player_mock_flush(test_mm_handle(player));
+	TEST_CHECK(c.events == 2);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_gapless(void)
+{
+	counters_s c;
+	bool looping = FALSE;
+	bool muted = FALSE;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_set_completed_cb(player, __completed_cb, &c));
+	TEST_CHECK_OK(player_set_track_changed_cb(player, __track_changed_cb, &c));
+	TEST_CHECK_OK(player_set_video_frame_decoded_cb(player, __video_frame_cb, &c));
+	TEST_CHECK_OK(player_set_looping(player, TRUE));
+	TEST_CHECK_OK(player_set_mute(player, TRUE));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_set_next_uri(player, uri));
+	TEST_CHECK_OK(player_start(player));
+	TEST_CHECK(__wait_next_prepared(player));
+
+	MMHandleType prev = test_mm_handle(player);
+	mm_player_mock_post_end_of_stream(prev);
+	TEST_CHECK(test_wait_count(&c.track_changed, 1));
+	TEST_CHECK(test_mm_handle(player) != prev);
+	TEST_CHECK(c.completed == 0);
+
+	// the settings and the callbacks follow the switch
+	TEST_CHECK_OK(player_is_looping(player, &looping));
+	TEST_CHECK_OK(player_is_muted(player, &muted));
+	TEST_CHECK(looping && muted);
+	mm_player_mock_push_video_frame(test_mm_handle(player), 320, 240, 4);
+	TEST_CHECK(test_wait_count(&c.frames, 1));
+
+	// without a next source the playback completes
+	mm_player_mock_post_end_of_stream(test_mm_handle(player));
+	TEST_CHECK(test_wait_count(&c.completed, 1));
+	TEST_CHECK_OK(player_destroy(player));
+	TEST_CHECK(c.track_changed == 1);
+}
+
+static bool __wait_alive_count(int count)
+{
+	int waited;
+	for(waited = 0; waited < TEST_WAIT_TIMEOUT; waited++)
+	{
+		if(mm_player_mock_get_alive_count() == count)
+			return TRUE;
+		test_sleep_ms(1);
+	}
+	return FALSE;
+}
+
+/* The previous pipeline of each switch is destroyed right away, not kept until player_destroy() */
+static void test_gapless_release(void)
+{
+	counters_s c;
+	int position = 0;
+	int i;
+	memset(&c, 0, sizeof(c));
+
+	player_h player = test_create(uri);
+	int alive = mm_player_mock_get_alive_count();
+	TEST_CHECK_OK(player_set_track_changed_cb(player, __track_changed_cb, &c));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+	for(i = 0; i < 5; i++)
+	{
+		TEST_CHECK_OK(player_set_next_uri(player, uri));
+		TEST_CHECK(__wait_next_prepared(player));
+		mm_player_mock_post_end_of_stream(test_mm_handle(player));
+		TEST_CHECK(test_wait_count(&c.track_changed, i + 1));
+		TEST_CHECK_OK(player_get_position(player, &position));
+	}
+	TEST_CHECK(__wait_alive_count(alive));
+
+	TEST_CHECK_OK(player_unprepare(player));
+	TEST_CHECK(mm_player_mock_get_alive_count() == alive);
+	TEST_CHECK_OK(player_destroy(player));
+	TEST_CHECK(mm_player_mock_get_alive_count() == alive - 1);
+}
+
+static void test_pool_reset(void)
+{
+	player_pool_h pool = NULL;
+	player_h player = NULL;
+	player_h reused = NULL;
+	void *data = NULL;
+	int size = -1;
+	int value = -1;
+	int level = -1;
+
+	TEST_CHECK_OK(player_pool_create(0, 1, &pool));
+	TEST_CHECK_OK(player_pool_acquire(pool, &player));
+	TEST_CHECK_OK(player_set_uri(player, uri));
+	TEST_CHECK_OK(player_set_streaming_cookie(player, "session=1", 9));
+	TEST_CHECK_OK(player_set_subtitle_path(player, uri));
+	TEST_CHECK_OK(player_set_progressive_download_path(player, uri));
+	TEST_CHECK_OK(player_audio_effect_set_equalizer_band_level(player, 0, 3));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_audio_pcm_open(player, 1000, 2000, 4096, PLAYER_AUDIO_PCM_OVERFLOW_BLOCK));
+	TEST_CHECK_OK(player_pool_release(pool, player));
+
+	// the next user of the pooled player sees none of the settings of the previous one
+	TEST_CHECK_OK(player_pool_acquire(pool, &reused));
+	TEST_CHECK(reused == player);
+	MMHandleType mm_handle = test_mm_handle(reused);
+	TEST_CHECK(mm_player_get_attribute(mm_handle, NULL, "streaming_cookie", &data, &size, (char*)NULL) == MM_ERROR_NONE && size == 0);
+	TEST_CHECK(mm_player_get_attribute(mm_handle, NULL, "subtitle_uri", &data, &size, (char*)NULL) == MM_ERROR_NONE && size == 0);
+	TEST_CHECK(mm_player_get_attribute(mm_handle, NULL, "pd_location", &data, &size, (char*)NULL) == MM_ERROR_NONE && size == 0);
+	TEST_CHECK(mm_player_get_attribute(mm_handle, NULL, "pcm_extraction_start_msec", &value, (char*)NULL) == MM_ERROR_NONE && value == 0);
+	TEST_CHECK(mm_player_get_attribute(mm_handle, NULL, "pcm_extraction_end_msec", &value, (char*)NULL) == MM_ERROR_NONE && value == 0);
+	TEST_CHECK(mm_player_get_attribute(mm_handle, NULL, "subtitle_silent", &value, (char*)NULL) == MM_ERROR_NONE && value == 1);
+	TEST_CHECK_OK(player_audio_effect_get_equalizer_band_level(reused, 0, &level));
+	TEST_CHECK(level == 0);
+	TEST_CHECK(((player_s*)reused)->pcm_start == 0);
+	TEST_CHECK_OK(player_pool_release(pool, reused));
+	TEST_CHECK_OK(player_pool_destroy(pool));
+}
+
+int main(int argc, char *argv[])
+{
+	uri = argv[0];
+	test_init();
+	TEST_RUN(test_playback);
+	TEST_RUN(test_prepare_async);
+	TEST_RUN(test_prepare_failure);
+	TEST_RUN(test_error);
+	TEST_RUN(test_buffering_coalescing);
+	TEST_RUN(test_dispatch_thread);
+	TEST_RUN(test_event_listener);
+	TEST_RUN(test_gapless);
+	TEST_RUN(test_gapless_release);
+	TEST_RUN(test_pool_reset);
+	return 0;
+}
@@ -0,0 +1,239 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include <pthread.h>
+#include "player_unit_test.h"
+
+#define RING_SIZE	4096
+
+static const char *uri;
+
+typedef struct {
+	player_h player;
+	MMHandleType mm_handle;
+	unsigned int size;
+	int started;
+	int stop;
+	int done;
+	int ret;
+} pcm_thread_s;
+
+/* One frame bigger than the ring blocks with PLAYER_AUDIO_PCM_OVERFLOW_BLOCK */
+static void* __push_thread(void *arg)
+{
+	pcm_thread_s *t = (pcm_thread_s*)arg;
+	test_count(&t->started);
+	mm_player_mock_push_audio_frame(t->mm_handle, t->size);
+	test_count(&t->done);
+	return NULL;
+}
+
+static void* __push_loop_thread(void *arg)
+{
+	pcm_thread_s *t = (pcm_thread_s*)arg;
+	while(!__atomic_load_n(&t->stop, __ATOMIC_ACQUIRE))
+		mm_player_mock_push_audio_frame(t->mm_handle, t->size);
+	return NULL;
+}
+
+static void* __read_thread(void *arg)
+{
+	pcm_thread_s *t = (pcm_thread_s*)arg;
+	unsigned char buffer[RING_SIZE];
+	unsigned int read_bytes = 0;
+	int pts = 0;
+	test_count(&t->started);
+	t->ret = player_audio_pcm_read(t->player, buffer, sizeof(buffer), &read_bytes, &pts, -1);
+	test_count(&t->done);
+	return NULL;
+}
+
+static void test_audio_pcm(void)
+{
+	unsigned char buffer[4096];
+	unsigned int read_bytes = 0;
+	unsigned int underruns = 0;
+	unsigned int overruns = 0;
+	int pts = -1;
+	unsigned int i;
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_audio_pcm_open(player, 0, 10000, sizeof(buffer), PLAYER_AUDIO_PCM_OVERFLOW_DROP_OLDEST));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+
+	mm_player_mock_push_audio_frame(test_mm_handle(player), 1000);
+	mm_player_mock_push_audio_frame(test_mm_handle(player), 1000);
+	TEST_CHECK_OK(player_audio_pcm_read(player, buffer, sizeof(buffer), &read_bytes, &pts, 0));
+	TEST_CHECK(read_bytes == 2000);
+	TEST_CHECK(pts == 0);
+	for(i = 0; i < read_bytes; i++)
+		TEST_CHECK(buffer[i] == i % 251);
+
+	TEST_CHECK_OK(player_audio_pcm_read(player, buffer, sizeof(buffer), &read_bytes, &pts, 0));
+	TEST_CHECK(read_bytes == 0);
+
+	// only the newest audio is kept
+	mm_player_mock_push_audio_frame(test_mm_handle(player), 5000);
+	TEST_CHECK_OK(player_audio_pcm_read(player, buffer, sizeof(buffer), &read_bytes, &pts, 0));
+	TEST_CHECK(read_bytes == sizeof(buffer));
+	TEST_CHECK(buffer[0] == (2000 + 5000 - sizeof(buffer)) % 251);
+	TEST_CHECK(pts > 0);
+
+	TEST_CHECK_OK(player_audio_pcm_get_stats(player, &underruns, &overruns));
+	TEST_CHECK(underruns == 1);
+	TEST_CHECK(overruns == 1);
+
+	TEST_CHECK_OK(player_audio_pcm_close(player));
+	TEST_CHECK(player_audio_pcm_read(player, buffer, sizeof(buffer), &read_bytes, &pts, 0) == PLAYER_ERROR_INVALID_OPERATION);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void __test_block_teardown(bool destroy)
+{
+	pthread_t thread;
+	pcm_thread_s t;
+	memset(&t, 0, sizeof(t));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_audio_pcm_open(player, 0, 10000, RING_SIZE, PLAYER_AUDIO_PCM_OVERFLOW_BLOCK));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+
+	t.mm_handle = test_mm_handle(player);
+	t.size = RING_SIZE * 3;
+	TEST_CHECK(pthread_create(&thread, NULL, __push_thread, &t) == 0);
+	TEST_CHECK(test_wait_count(&t.started, 1));
+	test_sleep_ms(50);
+	TEST_CHECK(__atomic_load_n(&t.done, __ATOMIC_ACQUIRE) == 0);
+
+	// the producer waits for room, the pipeline must not wait for the producer
+	if(destroy)
+		TEST_CHECK_OK(player_destroy(player));
+	else
+		TEST_CHECK_OK(player_unprepare(player));
+	TEST_CHECK(test_wait_count(&t.done, 1));
+	pthread_join(thread, NULL);
+	if(!destroy)
+		TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_audio_pcm_block_unprepare(void)
+{
+	__test_block_teardown(FALSE);
+}
+
+static void test_audio_pcm_block_destroy(void)
+{
+	__test_block_teardown(TRUE);
+}
+
+static void test_audio_pcm_eos(void)
+{
+	unsigned char buffer[RING_SIZE];
+	unsigned int read_bytes = 0;
+	int pts = -1;
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_audio_pcm_open(player, 0, 60000, sizeof(buffer), PLAYER_AUDIO_PCM_OVERFLOW_BLOCK));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+
+	mm_player_mock_push_audio_frame(test_mm_handle(player), 1000);
+	mm_player_mock_post_end_of_stream(test_mm_handle(player));
+	mm_player_mock_flush(test_mm_handle(player));
+
+	// what is left is still read, then the end is reported instead of waiting forever
+	TEST_CHECK_OK(player_audio_pcm_read(player, buffer, sizeof(buffer), &read_bytes, &pts, -1));
+	TEST_CHECK(read_bytes == 1000);
+	TEST_CHECK(player_audio_pcm_read(player, buffer, sizeof(buffer), &read_bytes, &pts, -1) == PLAYER_ERROR_INVALID_OPERATION);
+	TEST_CHECK(read_bytes == 0);
+
+	unsigned int underruns = 1;
+	unsigned int overruns = 1;
+	TEST_CHECK_OK(player_audio_pcm_get_stats(player, &underruns, &overruns));
+	TEST_CHECK(underruns == 0);
+	TEST_CHECK(overruns == 0);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_audio_pcm_close_wakes_reader(void)
+{
+	pthread_t thread;
+	pcm_thread_s t;
+	memset(&t, 0, sizeof(t));
+
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_audio_pcm_open(player, 0, 10000, RING_SIZE, PLAYER_AUDIO_PCM_OVERFLOW_BLOCK));
+	TEST_CHECK_OK(player_prepare(player));
+
+	t.player = player;
+	TEST_CHECK(pthread_create(&thread, NULL, __read_thread, &t) == 0);
+	TEST_CHECK(test_wait_count(&t.started, 1));
+	test_sleep_ms(50);
+	TEST_CHECK(__atomic_load_n(&t.done, __ATOMIC_ACQUIRE) == 0);
+
+	TEST_CHECK_OK(player_audio_pcm_close(player));
+	TEST_CHECK(test_wait_count(&t.done, 1));
+	pthread_join(thread, NULL);
+	TEST_CHECK(t.ret == PLAYER_ERROR_INVALID_OPERATION);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_audio_pcm_churn(void)
+{
+	unsigned char buffer[RING_SIZE];
+	unsigned int read_bytes = 0;
+	unsigned int underruns = 0;
+	unsigned int overruns = 0;
+	int pts = 0;
+	pthread_t thread;
+	pcm_thread_s t;
+	int i;
+	memset(&t, 0, sizeof(t));
+
+	player_h player = test_create_prepared(uri);
+	t.mm_handle = test_mm_handle(player);
+	t.size = 512;
+	TEST_CHECK(pthread_create(&thread, NULL, __push_loop_thread, &t) == 0);
+
+	// the buffer comes and goes under the streaming thread
+	for(i = 0; i < 200; i++)
+	{
+		TEST_CHECK_OK(player_audio_pcm_open(player, 0, 60000, RING_SIZE, i % 2 ? PLAYER_AUDIO_PCM_OVERFLOW_BLOCK : PLAYER_AUDIO_PCM_OVERFLOW_DROP_OLDEST));
+		TEST_CHECK_OK(player_audio_pcm_read(player, buffer, sizeof(buffer), &read_bytes, &pts, 1));
+		TEST_CHECK_OK(player_audio_pcm_get_stats(player, &underruns, &overruns));
+		TEST_CHECK_OK(player_audio_pcm_close(player));
+	}
+
+	__atomic_store_n(&t.stop, 1, __ATOMIC_RELEASE);
+	pthread_join(thread, NULL);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+int main(int argc, char *argv[])
+{
+	uri = argv[0];
+	test_init();
+	TEST_RUN(test_audio_pcm);
+	TEST_RUN(test_audio_pcm_block_unprepare);
+	TEST_RUN(test_audio_pcm_block_destroy);
+	TEST_RUN(test_audio_pcm_eos);
+	TEST_RUN(test_audio_pcm_close_wakes_reader);
+	TEST_RUN(test_audio_pcm_churn);
+	return 0;
+}
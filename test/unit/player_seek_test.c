@@ -0,0 +1,275 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include "player_unit_test.h"
+
+static const char *uri;
+
+typedef struct {
+	int completed[4];
+	int cancelled[4];
+	int completed_total;
+	int cancelled_total;
+	int position;
+} seeks_s;
+
+static seeks_s seeks;
+
+static void __seek_completed_cb(void *user_data)
+{
+	test_count(&seeks.completed[(intptr_t)user_data]);
+	test_count(&seeks.completed_total);
+}
+
+static void __seek_completed_ex_cb(int millisecond, void *user_data)
+{
+	__atomic_store_n(&seeks.position, millisecond, __ATOMIC_RELAXED);
+	test_count(&seeks.completed[(intptr_t)user_data]);
+	test_count(&seeks.completed_total);
+}
+
+static void __seek_cancelled_cb(void *seek_user_data, void *user_data)
+{
+	test_count(&seeks.cancelled[(intptr_t)seek_user_data]);
+	test_count(&seeks.cancelled_total);
+}
+
+static void test_seek(void)
+{
+	memset(&seeks, 0, sizeof(seeks));
+	player_h player = test_create_prepared(uri);
+	TEST_CHECK_OK(player_set_position(player, 5000, __seek_completed_cb, (void*)0));
+	TEST_CHECK(test_wait_count(&seeks.completed_total, 1));
+
+	int position = 0;
+	TEST_CHECK_OK(player_get_position(player, &position));
+	TEST_CHECK(position == 5000);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_seek_coalescing(void)
+{
+	memset(&seeks, 0, sizeof(seeks));
+	player_h player = test_create_prepared(uri);
+	MMHandleType mm_handle = test_mm_handle(player);
+	TEST_CHECK_OK(player_set_seek_cancelled_cb(player, __seek_cancelled_cb, NULL));
+	TEST_CHECK_OK(player_start(player));
+	mm_player_mock_hold_seek(mm_handle, TRUE);
+
+	// 1 is issued, 2 waits and is replaced by 3
+	TEST_CHECK_OK(player_set_position(player, 1000, __seek_completed_cb, (void*)1));
+	TEST_CHECK_OK(player_set_position(player, 2000, __seek_completed_cb, (void*)2));
+	TEST_CHECK_OK(player_set_position(player, 3000, __seek_completed_cb, (void*)3));
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 1);
+	TEST_CHECK(test_wait_count(&seeks.cancelled[2], 1));
+
+	TEST_CHECK_OK(mm_player_mock_complete_seek(mm_handle));
+	TEST_CHECK(test_wait_count(&seeks.completed[1], 1));
+	mm_player_mock_flush(mm_handle);
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 2);
+
+	TEST_CHECK_OK(mm_player_mock_complete_seek(mm_handle));
+	TEST_CHECK(test_wait_count(&seeks.completed[3], 1));
+	mm_player_mock_flush(mm_handle);
+	TEST_CHECK(seeks.completed_total == 2);
+	TEST_CHECK(seeks.cancelled_total == 1);
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 2);
+
+	// idle again, the next seek is issued at once
+	TEST_CHECK_OK(player_set_position(player, 4000, __seek_completed_cb, (void*)0));
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 3);
+	TEST_CHECK_OK(mm_player_mock_complete_seek(mm_handle));
+	TEST_CHECK(test_wait_count(&seeks.completed[0], 1));
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_seek_after_stop(void)
+{
+	memset(&seeks, 0, sizeof(seeks));
+	player_h player = test_create_prepared(uri);
+	MMHandleType mm_handle = test_mm_handle(player);
+	TEST_CHECK_OK(player_set_seek_cancelled_cb(player, __seek_cancelled_cb, NULL));
+	TEST_CHECK_OK(player_start(player));
+	mm_player_mock_hold_seek(mm_handle, TRUE);
+
+	// the pipeline drops both seeks on stop, they are reported cancelled
+	TEST_CHECK_OK(player_set_position(player, 1000, __seek_completed_cb, (void*)1));
+	TEST_CHECK_OK(player_set_position(player, 2000, __seek_completed_cb, (void*)2));
+	TEST_CHECK_OK(player_stop(player));
+	TEST_CHECK(test_wait_count(&seeks.cancelled_total, 2));
+	TEST_CHECK(seeks.cancelled[1] == 1 && seeks.cancelled[2] == 1);
+
+	// a seek after the next start is issued at once instead of waiting behind the dropped one
+	mm_player_mock_hold_seek(mm_handle, FALSE);
+	TEST_CHECK_OK(player_start(player));
+	mm_player_mock_flush(mm_handle);
+	TEST_CHECK_OK(player_set_position(player, 3000, __seek_completed_cb, (void*)3));
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 2);
+	TEST_CHECK(test_wait_count(&seeks.completed[3], 1));
+	TEST_CHECK(seeks.completed_total == 1);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static void test_seek_after_error(void)
+{
+	memset(&seeks, 0, sizeof(seeks));
+	player_h player = test_create_prepared(uri);
+	MMHandleType mm_handle = test_mm_handle(player);
+	TEST_CHECK_OK(player_set_seek_cancelled_cb(player, __seek_cancelled_cb, NULL));
+	TEST_CHECK_OK(player_start(player));
+	mm_player_mock_hold_seek(mm_handle, TRUE);
+
+	TEST_CHECK_OK(player_set_position(player, 1000, __seek_completed_cb, (void*)1));
+	mm_player_mock_post_error(mm_handle, MM_ERROR_PLAYER_INTERNAL);
+	TEST_CHECK(test_wait_count(&seeks.cancelled[1], 1));
+
+	TEST_CHECK_OK(player_set_position(player, 2000, __seek_completed_cb, (void*)2));
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 2);
+	TEST_CHECK_OK(mm_player_mock_complete_seek(mm_handle));
+	TEST_CHECK(test_wait_count(&seeks.completed[2], 1));
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static int __accurate_seek(player_h player)
+{
+	int accurate = -1;
+	mm_player_get_attribute(test_mm_handle(player), NULL, "accurate_seek", &accurate, (char*)NULL);
+	return accurate;
+}
+
+/* The mode switches the accurate_seek attribute of the pipeline, the _ex callback reports where the seek landed */
+static void test_seek_mode(void)
+{
+	memset(&seeks, 0, sizeof(seeks));
+	player_h player = test_create_prepared(uri);
+
+	TEST_CHECK_OK(player_set_position_ex(player, 7000, PLAYER_SEEK_MODE_ACCURATE, __seek_completed_ex_cb, (void*)0));
+	TEST_CHECK(test_wait_count(&seeks.completed_total, 1));
+	TEST_CHECK(__accurate_seek(player) == 1);
+	TEST_CHECK(seeks.position == 7000);
+
+	TEST_CHECK_OK(player_set_position_ex(player, 3000, PLAYER_SEEK_MODE_KEYFRAME, __seek_completed_ex_cb, (void*)1));
+	TEST_CHECK(test_wait_count(&seeks.completed_total, 2));
+	TEST_CHECK(__accurate_seek(player) == 0);
+	TEST_CHECK(seeks.position == 3000);
+
+	// player_set_position() seeks to the key frames and reports no position
+	TEST_CHECK_OK(player_set_position_ex(player, 1000, PLAYER_SEEK_MODE_ACCURATE, __seek_completed_ex_cb, (void*)0));
+	TEST_CHECK(test_wait_count(&seeks.completed_total, 3));
+	TEST_CHECK(__accurate_seek(player) == 1);
+	TEST_CHECK_OK(player_set_position(player, 9000, __seek_completed_cb, (void*)2));
+	TEST_CHECK(test_wait_count(&seeks.completed_total, 4));
+	TEST_CHECK(__accurate_seek(player) == 0);
+	TEST_CHECK(seeks.position == 1000);
+	TEST_CHECK(seeks.completed[0] == 2 && seeks.completed[1] == 1 && seeks.completed[2] == 1);
+	TEST_CHECK(seeks.cancelled_total == 0);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+static int __mute(player_h player)
+{
+	int mute = -1;
+	mm_player_get_mute(test_mm_handle(player), &mute);
+	return mute;
+}
+
+/* Updates are keyframe seeks replacing each other, the end is an accurate seek to the last one and restores the audio */
+static void test_scrub(void)
+{
+	memset(&seeks, 0, sizeof(seeks));
+	player_h player = test_create_prepared(uri);
+	MMHandleType mm_handle = test_mm_handle(player);
+	TEST_CHECK_OK(player_set_seek_cancelled_cb(player, __seek_cancelled_cb, NULL));
+	TEST_CHECK_OK(player_start(player));
+	TEST_CHECK_OK(player_set_mute(player, FALSE));
+
+	TEST_CHECK_OK(player_scrub_begin(player));
+	TEST_CHECK(player_scrub_begin(player) == PLAYER_ERROR_INVALID_OPERATION);
+	TEST_CHECK(__mute(player) == 1);
+	bool muted = TRUE;
+	TEST_CHECK_OK(player_is_muted(player, &muted));
+	TEST_CHECK(!muted);
+
+	// 1000 is issued, 2000 waits and is replaced by 3000, the same position twice is ignored
+	mm_player_mock_hold_seek(mm_handle, TRUE);
+	TEST_CHECK_OK(player_scrub_update(player, 1000));
+	TEST_CHECK_OK(player_scrub_update(player, 1000));
+	TEST_CHECK_OK(player_scrub_update(player, 2000));
+	TEST_CHECK_OK(player_scrub_update(player, 3000));
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 1);
+	TEST_CHECK(__accurate_seek(player) == 0);
+
+	TEST_CHECK_OK(mm_player_mock_complete_seek(mm_handle));
+	mm_player_mock_flush(mm_handle);
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 2);
+	TEST_CHECK(__accurate_seek(player) == 0);
+
+	// the mute is kept aside until the end
+	TEST_CHECK_OK(player_set_mute(player, TRUE));
+	TEST_CHECK_OK(player_is_muted(player, &muted));
+	TEST_CHECK(muted);
+	TEST_CHECK_OK(player_set_mute(player, FALSE));
+	TEST_CHECK(__mute(player) == 1);
+
+	// the accurate seek waits behind the keyframe one to 3000
+	TEST_CHECK_OK(player_scrub_end(player, __seek_completed_ex_cb, (void*)1));
+	TEST_CHECK(__mute(player) == 0);
+	TEST_CHECK_OK(player_is_muted(player, &muted));
+	TEST_CHECK(!muted);
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 2);
+
+	TEST_CHECK_OK(mm_player_mock_complete_seek(mm_handle));
+	mm_player_mock_flush(mm_handle);
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 3);
+	TEST_CHECK(__accurate_seek(player) == 1);
+
+	TEST_CHECK_OK(mm_player_mock_complete_seek(mm_handle));
+	TEST_CHECK(test_wait_count(&seeks.completed[1], 1));
+	mm_player_mock_flush(mm_handle);
+	TEST_CHECK(seeks.position == 3000);
+	TEST_CHECK(seeks.completed_total == 1);
+	TEST_CHECK(seeks.cancelled_total == 0);
+
+	TEST_CHECK(player_scrub_update(player, 4000) == PLAYER_ERROR_INVALID_OPERATION);
+	TEST_CHECK(player_scrub_end(player, __seek_completed_ex_cb, (void*)1) == PLAYER_ERROR_INVALID_OPERATION);
+
+	// without any update, the end only restores the mute set meanwhile
+	TEST_CHECK_OK(player_scrub_begin(player));
+	TEST_CHECK_OK(player_set_mute(player, TRUE));
+	TEST_CHECK(__mute(player) == 1);
+	TEST_CHECK_OK(player_scrub_end(player, __seek_completed_ex_cb, (void*)2));
+	TEST_CHECK(__mute(player) == 1);
+	TEST_CHECK_OK(player_is_muted(player, &muted));
+	TEST_CHECK(muted);
+	mm_player_mock_flush(mm_handle);
+	TEST_CHECK(mm_player_mock_get_seek_count(mm_handle) == 3);
+	TEST_CHECK(seeks.completed[2] == 0);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+int main(int argc, char *argv[])
+{
+	uri = argv[0];
+	test_init();
+	TEST_RUN(test_seek);
+	TEST_RUN(test_seek_coalescing);
+	TEST_RUN(test_seek_after_stop);
+	TEST_RUN(test_seek_after_error);
+	TEST_RUN(test_seek_mode);
+	TEST_RUN(test_scrub);
+	return 0;
+}
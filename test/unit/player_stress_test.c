@@ -0,0 +1,221 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* The API threads, the streaming thread and the message thread all at once. The
+* checks are loose, the point is to run under PLAYER_TSAN, which fails the test on
+* the first data race.
+*/
+
+#include <string.h>
+#include <pthread.h>
+#include "player_unit_test.h"
+
+#define ITERATIONS	2000
+#define READERS	2
+
+static const char *uri;
+
+typedef struct {
+	player_h player;
+	MMHandleType mm_handle;
+	int stop;
+	int frames;
+	int audio;
+	int buffering;
+	int seeks;
+	int track_changed;
+} stress_s;
+
+static void __video_frame_cb(player_video_frame_h frame, void *user_data)
+{
+	test_count(&((stress_s*)user_data)->frames);
+	// released right away, while the streaming thread still holds it
+	player_video_frame_ref(frame);
+	player_video_frame_unref(frame);
+}
+
+static void __audio_frame_cb(unsigned char *data, unsigned int size, void *user_data)
+{
+	test_count(&((stress_s*)user_data)->audio);
+}
+
+static void __buffering_cb(int percent, void *user_data)
+{
+	test_count(&((stress_s*)user_data)->buffering);
+}
+
+static void __seek_cb(void *user_data)
+{
+	test_count(&((stress_s*)user_data)->seeks);
+}
+
+static void __track_changed_cb(void *user_data)
+{
+	test_count(&((stress_s*)user_data)->track_changed);
+}
+
+static void* __streaming_thread(void *arg)
+{
+	stress_s *s = (stress_s*)arg;
+	while(!__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE))
+	{
+		mm_player_mock_push_video_frame(s->mm_handle, 64, 48, 0);
+		mm_player_mock_push_audio_frame(s->mm_handle, 1024);
+	}
+	return NULL;
+}
+
+static void* __message_thread(void *arg)
+{
+	stress_s *s = (stress_s*)arg;
+	int i = 0;
+	while(!__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE))
+	{
+		mm_player_mock_post_buffering(s->mm_handle, i++ % 100);
+		test_sleep_ms(1);
+	}
+	return NULL;
+}
+
+static void* __reader_thread(void *arg)
+{
+	stress_s *s = (stress_s*)arg;
+	player_dispatch_stats_s stats;
+	unsigned int dropped = 0;
+	unsigned int delivered = 0;
+	unsigned int coalesced = 0;
+	float ratio = 0;
+	int position = 0;
+	int i;
+
+	for(i = 0; i < ITERATIONS; i++)
+	{
+		TEST_CHECK_OK(player_get_position(s->player, &position));
+		TEST_CHECK_OK(player_get_dispatch_stats(s->player, &stats));
+		TEST_CHECK_OK(player_get_video_frame_drop_count(s->player, &dropped));
+		TEST_CHECK_OK(player_get_decoding_speed(s->player, &ratio));
+		TEST_CHECK_OK(player_get_buffering_event_count(s->player, &delivered, &coalesced));
+	}
+	return NULL;
+}
+
+static void* __metadata_thread(void *arg)
+{
+	stress_s *s = (stress_s*)arg;
+	char *title = NULL;
+	int duration = 0;
+	int width = 0;
+	int height = 0;
+
+	while(!__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE))
+	{
+		TEST_CHECK_OK(player_get_duration(s->player, &duration));
+		TEST_CHECK_OK(player_get_video_size(s->player, &width, &height));
+		TEST_CHECK_OK(player_get_content_info(s->player, PLAYER_CONTENT_INFO_TITLE, &title));
+		TEST_CHECK(title && strcmp(title, "Title") == 0);
+		free(title);
+		title = NULL;
+	}
+	return NULL;
+}
+
+static void test_stress(void)
+{
+	pthread_t streaming;
+	pthread_t message;
+	pthread_t readers[READERS];
+	stress_s s;
+	int i;
+	memset(&s, 0, sizeof(s));
+
+	player_h player = test_create(uri);
+	s.player = player;
+	TEST_CHECK_OK(player_set_dispatch_mode(player, PLAYER_DISPATCH_MODE_THREAD, NULL));
+	TEST_CHECK_OK(player_set_position_interpolation(player, 5));
+	TEST_CHECK_OK(player_set_video_frame_cb(player, __video_frame_cb, &s));
+	TEST_CHECK_OK(player_set_audio_frame_decoded_cb(player, 0, 60000, __audio_frame_cb, &s));
+	TEST_CHECK_OK(player_set_buffering_cb(player, __buffering_cb, &s));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+	s.mm_handle = test_mm_handle(player);
+
+	TEST_CHECK(pthread_create(&streaming, NULL, __streaming_thread, &s) == 0);
+	TEST_CHECK(pthread_create(&message, NULL, __message_thread, &s) == 0);
+	for(i = 0; i < READERS; i++)
+		TEST_CHECK(pthread_create(&readers[i], NULL, __reader_thread, &s) == 0);
+
+	// the seeks move the position under the readers, the coalescing changes under the message thread
+	for(i = 0; i < 100; i++)
+	{
+		TEST_CHECK_OK(player_set_buffering_coalescing(player, i % 3, i % 20));
+		TEST_CHECK_OK(player_set_position(player, (i * 1000) % 60000, __seek_cb, &s));
+		test_sleep_ms(1);
+	}
+
+	for(i = 0; i < READERS; i++)
+		pthread_join(readers[i], NULL);
+	__atomic_store_n(&s.stop, 1, __ATOMIC_RELEASE);
+	pthread_join(message, NULL);
+	pthread_join(streaming, NULL);
+
+	TEST_CHECK(test_wait_count(&s.seeks, 1));
+	TEST_CHECK(s.frames > 0);
+	TEST_CHECK(s.audio > 0);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+/* The readers fill and drop the metadata cache while the gapless switches change the source */
+static void test_metadata(void)
+{
+	pthread_t readers[READERS];
+	stress_s s;
+	int i;
+	int waited;
+	memset(&s, 0, sizeof(s));
+
+	player_h player = test_create(uri);
+	s.player = player;
+	TEST_CHECK_OK(player_set_track_changed_cb(player, __track_changed_cb, &s));
+	TEST_CHECK_OK(player_prepare(player));
+	TEST_CHECK_OK(player_start(player));
+
+	for(i = 0; i < READERS; i++)
+		TEST_CHECK(pthread_create(&readers[i], NULL, __metadata_thread, &s) == 0);
+
+	for(i = 0; i < 10; i++)
+	{
+		TEST_CHECK_OK(player_set_next_uri(player, uri));
+		for(waited = 0; waited < TEST_WAIT_TIMEOUT && !__atomic_load_n(&((player_s*)player)->is_next_prepared, __ATOMIC_ACQUIRE); waited++)
+			test_sleep_ms(1);
+		mm_player_mock_post_end_of_stream(test_mm_handle(player));
+		TEST_CHECK(test_wait_count(&s.track_changed, i + 1));
+	}
+
+	__atomic_store_n(&s.stop, 1, __ATOMIC_RELEASE);
+	for(i = 0; i < READERS; i++)
+		pthread_join(readers[i], NULL);
+	TEST_CHECK_OK(player_destroy(player));
+}
+
+int main(int argc, char *argv[])
+{
+	uri = argv[0];
+	test_init();
+	TEST_RUN(test_stress);
+	TEST_RUN(test_metadata);
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* Helpers of the unit tests. Each test_*.c is a program which runs its cases in order
+* and exits with 1 at the first failed check, the player runs on test/mock.
+*/
+
+#ifndef __TIZEN_MEDIA_PLAYER_UNIT_TEST_H__
+#define __TIZEN_MEDIA_PLAYER_UNIT_TEST_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <player.h>
+#include <player_private.h>
+#include <mm_player_mock.h>
+
+#define TEST_CHECK(cond) \
+	do { \
+		if(!(cond)) { \
+			fprintf(stderr, "%s:%d: %s : check failed\n", __FILE__, __LINE__, #cond); \
+			exit(1); \
+		} \
+	} while(0)
+
+#define TEST_CHECK_OK(expr)	TEST_CHECK((expr) == PLAYER_ERROR_NONE)
+
+#define TEST_RUN(test) \
+	do { \
+		fprintf(stderr, "[ RUN  ] %s\n", #test); \
+		test(); \
+		TEST_CHECK(mm_player_mock_get_alive_count() == 0); \
+		fprintf(stderr, "[   OK ] %s\n", #test); \
+	} while(0)
+
+#define TEST_WAIT_TIMEOUT	5000
+
+static inline void test_sleep_ms(int ms)
+{
+	struct timespec ts = { ms / 1000, (long)(ms % 1000) * 1000000 };
+	nanosleep(&ts, NULL);
+}
+
+/* Waits until the counter, written by the callbacks, reaches the value */
+static inline bool test_wait_count(const int *counter, int value)
+{
+	int waited;
+	for(waited = 0; waited < TEST_WAIT_TIMEOUT; waited++)
+	{
+		if(__atomic_load_n(counter, __ATOMIC_ACQUIRE) >= value)
+			return TRUE;
+		test_sleep_ms(1);
+	}
+	return __atomic_load_n(counter, __ATOMIC_ACQUIRE) >= value;
+}
+
+static inline void test_count(int *counter)
+{
+	__atomic_add_fetch(counter, 1, __ATOMIC_RELEASE);
+}
+
+/* The fake pipeline of the player, to drive it from the test */
+static inline MMHandleType test_mm_handle(player_h player)
+{
+	return _player_get_mm_handle((player_s*)player);
+}
+
+/* Any readable file will do as a source, nothing is decoded */
+static inline player_h test_create(const char *uri)
+{
+	player_h player = NULL;
+	TEST_CHECK_OK(player_create(&player));
+	TEST_CHECK_OK(player_set_uri(player, uri));
+	return player;
+}
+
+static inline player_h test_create_prepared(const char *uri)
+{
+	player_h player = test_create(uri);
+	TEST_CHECK_OK(player_prepare(player));
+	return player;
+}
+
+static inline void test_init(void)
+{
+	player_set_log_level(PLAYER_LOG_LEVEL_ERROR);
+	mm_player_mock_set_content(60000, 320, 240, 44100, 2);
+}
+
+#endif //__TIZEN_MEDIA_PLAYER_UNIT_TEST_H__